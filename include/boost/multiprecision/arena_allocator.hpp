@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// A monotonic arena, and an allocator which takes its memory from the arena which was active
+// on the current thread when the allocator was created.  Suitable for the Allocator parameter
+// of cpp_int_backend, cpp_bin_float and cpp_dec_float.
+//
+#ifndef BOOST_MP_ARENA_ALLOCATOR_HPP
+#define BOOST_MP_ARENA_ALLOCATOR_HPP
+
+#include <boost/config.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <cstddef>
+#include <new>
+
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL) && !defined(BOOST_NO_CXX11_ALLOCATOR)
+#  define BOOST_MP_HAS_ARENA_ALLOCATOR
+#endif
+
+#ifdef BOOST_MP_HAS_ARENA_ALLOCATOR
+
+#include <type_traits>
+
+namespace boost{ namespace multiprecision{
+
+//
+// Hands out memory by bumping a pointer through a list of chunks, each twice the size of the
+// last.  Freeing memory is a no-op except for the most recent allocation, which is reclaimed,
+// everything else is reclaimed by release() or the destructor.  Not thread safe:
+//
+class monotonic_arena
+{
+public:
+   explicit monotonic_arena(std::size_t initial_bytes = 65536)
+      : m_chunks(0), m_pos(0), m_end(0), m_buffer(0), m_buffer_size(0), m_next_size(initial_bytes ? initial_bytes : 1024) {}
+   //
+   // Uses the caller's buffer before allocating any chunks:
+   //
+   monotonic_arena(void* buffer, std::size_t bytes)
+      : m_chunks(0), m_pos(0), m_end(0), m_buffer(static_cast<char*>(buffer)), m_buffer_size(bytes), m_next_size(bytes > 1024 ? bytes : 1024)
+   {
+      reset_to_buffer();
+   }
+   ~monotonic_arena()
+   {
+      free_chunks(0);
+   }
+
+   void* allocate(std::size_t bytes)
+   {
+      bytes = round_up(bytes ? bytes : 1);
+      if(static_cast<std::size_t>(m_end - m_pos) < bytes)
+         new_chunk(bytes);
+      void* result = m_pos;
+      m_pos += bytes;
+      return result;
+   }
+   void deallocate(void* p, std::size_t bytes) BOOST_NOEXCEPT
+   {
+      bytes = round_up(bytes ? bytes : 1);
+      if(static_cast<char*>(p) + bytes == m_pos)
+         m_pos = static_cast<char*>(p);
+   }
+   //
+   // Reclaims everything handed out so far.  The largest chunk is kept for reuse unless the arena
+   // has a caller supplied buffer:
+   //
+   void release() BOOST_NOEXCEPT
+   {
+      if(m_buffer)
+      {
+         free_chunks(0);
+         reset_to_buffer();
+      }
+      else if(m_chunks)
+      {
+         free_chunks(m_chunks);
+         m_pos = reinterpret_cast<char*>(m_chunks) + header_size;
+      }
+   }
+   //
+   // Bytes obtained from the system allocator and currently held:
+   //
+   std::size_t bytes_reserved()const BOOST_NOEXCEPT
+   {
+      std::size_t result = 0;
+      for(chunk* c = m_chunks; c; c = c->next)
+         result += c->size;
+      return result;
+   }
+   //
+   // The arena in use by the current thread, or null when values use the heap:
+   //
+   static monotonic_arena* current() BOOST_NOEXCEPT
+   {
+      return current_ref();
+   }
+
+private:
+   friend class arena_scope;
+
+   monotonic_arena(const monotonic_arena&);
+   monotonic_arena& operator=(const monotonic_arena&);
+
+   struct chunk
+   {
+      chunk*      next;
+      std::size_t size;
+   };
+   BOOST_STATIC_CONSTANT(std::size_t, alignment = boost::alignment_of<boost::detail::max_align>::value);
+   BOOST_STATIC_CONSTANT(std::size_t, header_size = (sizeof(chunk) + alignment - 1) / alignment * alignment);
+
+   static std::size_t round_up(std::size_t bytes) BOOST_NOEXCEPT
+   {
+      return (bytes + alignment - 1) / alignment * alignment;
+   }
+   static monotonic_arena*& current_ref() BOOST_NOEXCEPT
+   {
+      static thread_local monotonic_arena* p = 0;
+      return p;
+   }
+   void new_chunk(std::size_t bytes)
+   {
+      std::size_t size = header_size + (bytes > m_next_size ? bytes : m_next_size);
+      chunk* c = static_cast<chunk*>(::operator new(size));
+      c->next = m_chunks;
+      c->size = size;
+      m_chunks = c;
+      m_pos = reinterpret_cast<char*>(c) + header_size;
+      m_end = reinterpret_cast<char*>(c) + size;
+      m_next_size *= 2;
+   }
+   //
+   // Frees every chunk other than keep, which must be the head of the list:
+   //
+   void free_chunks(chunk* keep) BOOST_NOEXCEPT
+   {
+      chunk* c = keep ? keep->next : m_chunks;
+      while(c)
+      {
+         chunk* next = c->next;
+         ::operator delete(c);
+         c = next;
+      }
+      if(keep)
+         keep->next = 0;
+      else
+      {
+         m_chunks = 0;
+         m_pos = m_end = 0;
+      }
+   }
+   void reset_to_buffer() BOOST_NOEXCEPT
+   {
+      //
+      // Align the start of the caller's buffer:
+      //
+      std::size_t offset = reinterpret_cast<std::size_t>(m_buffer) % alignment;
+      offset = offset ? alignment - offset : 0;
+      if(offset > m_buffer_size)
+         offset = m_buffer_size;
+      m_pos = m_buffer + offset;
+      m_end = m_buffer + m_buffer_size;
+   }
+
+   chunk*      m_chunks;
+   char*       m_pos;
+   char*       m_end;
+   char*       m_buffer;
+   std::size_t m_buffer_size;
+   std::size_t m_next_size;
+};
+
+//
+// Makes an arena the current one for this thread, restoring the previous one and releasing
+// the arena at scope exit.  Constructing from a null pointer suspends any arena in use so that
+// values created within the scope use the heap:
+//
+class arena_scope
+{
+public:
+   explicit arena_scope(monotonic_arena& arena) BOOST_NOEXCEPT
+      : m_arena(&arena), m_previous(monotonic_arena::current_ref())
+   {
+      monotonic_arena::current_ref() = m_arena;
+   }
+   explicit arena_scope(monotonic_arena* arena) BOOST_NOEXCEPT
+      : m_arena(arena), m_previous(monotonic_arena::current_ref())
+   {
+      monotonic_arena::current_ref() = m_arena;
+   }
+   ~arena_scope()
+   {
+      monotonic_arena::current_ref() = m_previous;
+      // Only the outermost scope using an arena releases it:
+      if(m_arena && (m_arena != m_previous))
+         m_arena->release();
+   }
+
+private:
+   arena_scope(const arena_scope&);
+   arena_scope& operator=(const arena_scope&);
+
+   monotonic_arena* m_arena;
+   monotonic_arena* m_previous;
+};
+
+//
+// Allocates from the arena which was current when the allocator was constructed, or from the heap
+// if there was none.  The allocator is never propagated by assignment or swap, and copy construction
+// selects the current arena, so a value keeps the storage it was created with and data is copied
+// whenever it has to cross from one arena to another:
+//
+template <class T>
+class arena_allocator
+{
+public:
+   typedef T              value_type;
+   typedef std::size_t    size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   typedef std::false_type propagate_on_container_copy_assignment;
+   typedef std::false_type propagate_on_container_move_assignment;
+   typedef std::false_type propagate_on_container_swap;
+
+   template <class U>
+   struct rebind
+   {
+      typedef arena_allocator<U> other;
+   };
+
+   arena_allocator() BOOST_NOEXCEPT : m_arena(monotonic_arena::current()) {}
+   explicit arena_allocator(monotonic_arena* arena) BOOST_NOEXCEPT : m_arena(arena) {}
+   template <class U>
+   arena_allocator(const arena_allocator<U>& a) BOOST_NOEXCEPT : m_arena(a.arena()) {}
+
+   T* allocate(std::size_t n)
+   {
+      if(m_arena)
+         return static_cast<T*>(m_arena->allocate(n * sizeof(T)));
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+   }
+   void deallocate(T* p, std::size_t n) BOOST_NOEXCEPT
+   {
+      if(m_arena)
+         m_arena->deallocate(p, n * sizeof(T));
+      else
+         ::operator delete(p);
+   }
+   arena_allocator select_on_container_copy_construction()const BOOST_NOEXCEPT
+   {
+      return arena_allocator();
+   }
+   monotonic_arena* arena()const BOOST_NOEXCEPT
+   {
+      return m_arena;
+   }
+
+private:
+   monotonic_arena* m_arena;
+};
+
+template <class T, class U>
+inline bool operator == (const arena_allocator<T>& a, const arena_allocator<U>& b) BOOST_NOEXCEPT
+{
+   return a.arena() == b.arena();
+}
+template <class T, class U>
+inline bool operator != (const arena_allocator<T>& a, const arena_allocator<U>& b) BOOST_NOEXCEPT
+{
+   return a.arena() != b.arena();
+}
+
+}} // namespaces
+
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Element-wise arithmetic over arrays of integers, with kernels for fixed width unsigned cpp_int's.
+//
+#ifndef BOOST_MP_BATCH_HPP
+#define BOOST_MP_BATCH_HPP
+
+#include <boost/multiprecision/integer.hpp>
+
+namespace boost{ namespace multiprecision{
+
+namespace backends{
+
+//
+// Kernels for values of exactly N limbs, a compile time constant.  r may alias a or b unless noted otherwise:
+//
+template <unsigned N>
+inline limb_type fixed_subtract(limb_type* r, const limb_type* a, const limb_type* b) BOOST_NOEXCEPT
+{
+   limb_type borrow = 0;
+   for(unsigned i = 0; i < N; ++i)
+   {
+      double_limb_type t = static_cast<double_limb_type>(a[i]) - b[i] - borrow;
+      r[i] = static_cast<limb_type>(t);
+      borrow = static_cast<limb_type>(t >> bits_per_limb) & 1u;
+   }
+   return borrow;
+}
+template <unsigned N>
+inline bool fixed_less(const limb_type* a, const limb_type* b) BOOST_NOEXCEPT
+{
+   for(unsigned i = N; i > 0; --i)
+   {
+      if(a[i - 1] != b[i - 1])
+         return a[i - 1] < b[i - 1];
+   }
+   return false;
+}
+//
+// r[0, 2N) = a * b, r may not alias a or b:
+//
+template <unsigned N>
+inline void fixed_multiply(limb_type* r, const limb_type* a, const limb_type* b) BOOST_NOEXCEPT
+{
+   r[N] = mul_1(r, a, N, b[0]);
+   for(unsigned i = 1; i < N; ++i)
+      r[i + N] = addmul_1(r + i, a, N, b[i]);
+}
+//
+// Montgomery multiplication, r = a * b / B^N mod m for odd m, with inv = -1/m mod B.  The product is reduced
+// a row at a time as in modular_reducer.  The result is less than m provided a * b < m * B^N, so one argument
+// may be any N limb value as long as the other is less than m:
+//
+template <unsigned N>
+inline void fixed_montgomery_multiply(limb_type* r, const limb_type* a, const limb_type* b, const limb_type* m, limb_type inv) BOOST_NOEXCEPT
+{
+   limb_type x[2 * N];
+   fixed_multiply<N>(x, a, b);
+   limb_type top = 0;
+   for(unsigned i = 0; i < N; ++i)
+   {
+      limb_type carry = addmul_1(x + i, m, N, x[i] * inv);
+      limb_type t = x[i + N] + carry;
+      limb_type c = t < carry;
+      x[i + N] = t + top;
+      top = c + (x[i + N] < top);
+   }
+   //
+   // The result is less than 2m, so at most one subtraction is needed:
+   //
+   if(top || !fixed_less<N>(x + N, m))
+      fixed_subtract<N>(r, x + N, m);
+   else
+      std::memcpy(r, x + N, N * sizeof(limb_type));
+}
+//
+// Barrett reduction (Handbook of Applied Cryptography 14.42), r[0, N) = x[0, 2N) mod m, where the top limb of m
+// is non-zero and mu[0, N + 1) = floor(B^2N / m).  As in modular_reducer the columns of the quotient estimate
+// below N - 1 are skipped, so it may be up to 3 too small:
+//
+template <unsigned N>
+inline void fixed_barrett_reduce(limb_type* r, const limb_type* x, const limb_type* m, const limb_type* mu) BOOST_NOEXCEPT
+{
+   limb_type q[2 * N + 2] = { 0 };
+   const limb_type* q1 = x + N - 1;
+   for(unsigned i = 0; i <= N; ++i)
+   {
+      double_limb_type carry = 0;
+      for(unsigned j = i < N - 1 ? N - 1 - i : 0; j <= N; ++j)
+      {
+         carry += static_cast<double_limb_type>(q1[i]) * mu[j] + q[i + j];
+         q[i + j] = static_cast<limb_type>(carry);
+         carry >>= bits_per_limb;
+      }
+      q[i + N + 1] = static_cast<limb_type>(carry);
+   }
+   //
+   // The remainder is less than 4m, so only the low N + 1 limbs of x - q * m are needed:
+   //
+   const limb_type* q3 = q + N + 1;
+   limb_type w[N + 1] = { 0 };
+   for(unsigned i = 0; i <= N; ++i)
+   {
+      double_limb_type carry = 0;
+      for(unsigned j = 0; (j < N) && (i + j <= N); ++j)
+      {
+         carry += static_cast<double_limb_type>(q3[i]) * m[j] + w[i + j];
+         w[i + j] = static_cast<limb_type>(carry);
+         carry >>= bits_per_limb;
+      }
+      if(!i)
+         w[N] = static_cast<limb_type>(carry);
+   }
+   fixed_subtract<N + 1>(w, x, w);
+   while(w[N] || !fixed_less<N>(w, m))
+      w[N] -= fixed_subtract<N>(w, w, m);
+   std::memcpy(r, w, N * sizeof(limb_type));
+}
+
+template <class Backend>
+struct is_batch_fixed_cpp_int : public mpl::false_ {};
+template <unsigned Bits>
+struct is_batch_fixed_cpp_int<cpp_int_backend<Bits, Bits, unsigned_magnitude, unchecked, void> >
+   : public mpl::bool_<!is_trivial_cpp_int<cpp_int_backend<Bits, Bits, unsigned_magnitude, unchecked, void> >::value> {};
+
+//
+// Copies a fixed width value to and from an array of exactly N limbs, the limbs of a cpp_int above size()
+// are not necessarily zero:
+//
+template <unsigned N, class Backend>
+inline void load_fixed(limb_type* r, const Backend& a) BOOST_NOEXCEPT
+{
+   unsigned n = a.size();
+   const limb_type* p = a.limbs();
+   for(unsigned i = 0; i < N; ++i)
+      r[i] = i < n ? p[i] : 0;
+}
+template <unsigned N, class Backend>
+inline void store_fixed(Backend& r, const limb_type* p) BOOST_NOEXCEPT
+{
+   r.resize(N, N);
+   std::memcpy(r.limbs(), p, N * sizeof(limb_type));
+   r.normalize();
+}
+
+} // namespace backends
+
+namespace batch{
+
+namespace detail{
+
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void mulmod_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, const number<Backend, ExpressionTemplates>& m, std::size_t n, const mpl::false_&)
+{
+   number<Backend>          modulus(m);
+   modular_context<Backend> ctx(modulus);
+   for(std::size_t i = 0; i < n; ++i)
+      r[i] = ctx.mulmod(a[i], b[i]);
+}
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void mulmod_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, const number<Backend, ExpressionTemplates>& m, std::size_t n, const mpl::true_&)
+{
+   static const unsigned N = Backend::internal_limb_count;
+   limb_type pm[N], x[2 * N], y[N], z[N];
+   backends::load_fixed<N>(pm, m.backend());
+   cpp_int_backend<> t, modulus;
+   modulus.resize(N, N);
+   std::memcpy(modulus.limbs(), pm, sizeof(pm));
+   modulus.normalize();
+   t = static_cast<limb_type>(1u);
+   eval_left_shift(t, 2 * N * bits_per_limb);
+   if(pm[N - 1])
+   {
+      //
+      // The modulus uses every limb, so a full product of any two values is less than B^2N and
+      // Barrett reduction applies directly, mu = floor(B^2N / m):
+      //
+      eval_divide(t, modulus);
+      if(t.size() <= N + 1)
+      {
+         limb_type mu[N + 1] = { 0 };
+         std::memcpy(mu, t.limbs(), t.size() * sizeof(limb_type));
+         for(std::size_t i = 0; i < n; ++i)
+         {
+            backends::load_fixed<N>(y, a[i].backend());
+            backends::load_fixed<N>(z, b[i].backend());
+            backends::fixed_multiply<N>(x, y, z);
+            backends::fixed_barrett_reduce<N>(x, x, pm, mu);
+            backends::store_fixed<N>(r[i].backend(), x);
+         }
+         return;
+      }
+   }
+   else if(pm[0] & 1u)
+   {
+      //
+      // A narrower odd modulus: a * R^2 / R is a * R mod m, fully reduced whatever the size of a, and
+      // then multiplying that by b removes the R again, where R = B^N.  So there's no division even
+      // when a or b is much larger than m.  inv = -1/m mod B by Newton iteration, m is its own inverse
+      // to 3 bits:
+      //
+      limb_type inv = pm[0];
+      for(unsigned i = 0; i < 5; ++i)
+         inv *= 2 - pm[0] * inv;
+      inv = 0 - inv;
+      limb_type r2[N];
+      eval_modulus(t, t, modulus);
+      backends::load_fixed<N>(r2, t);
+      for(std::size_t i = 0; i < n; ++i)
+      {
+         backends::load_fixed<N>(x, a[i].backend());
+         backends::load_fixed<N>(y, b[i].backend());
+         backends::fixed_montgomery_multiply<N>(x, x, r2, pm, inv);
+         backends::fixed_montgomery_multiply<N>(x, x, y, pm, inv);
+         backends::store_fixed<N>(r[i].backend(), x);
+      }
+      return;
+   }
+   mulmod_n(r, a, b, m, n, mpl::false_());
+}
+
+} // namespace detail
+
+//
+// Each of these sets r[i] = a[i] op b[i] for i in [0, n), with the same result as the scalar operation,
+// r may be the same array as a or b:
+//
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void add_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, std::size_t n)
+{
+   using default_ops::eval_add;
+   for(std::size_t i = 0; i < n; ++i)
+      eval_add(r[i].backend(), a[i].backend(), b[i].backend());
+}
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void sub_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, std::size_t n)
+{
+   using default_ops::eval_subtract;
+   for(std::size_t i = 0; i < n; ++i)
+      eval_subtract(r[i].backend(), a[i].backend(), b[i].backend());
+}
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void mul_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, std::size_t n)
+{
+   using default_ops::eval_multiply;
+   for(std::size_t i = 0; i < n; ++i)
+      eval_multiply(r[i].backend(), a[i].backend(), b[i].backend());
+}
+//
+// r[i] = a[i] * b[i] mod m for m > 0, computed without overflow whatever the width of the type.  Arguments
+// needn't be less than m.  The reduction constants are computed once for the whole array: with the kernels
+// moduli which use every limb of the type use Barrett reduction, and narrower odd moduli Montgomery
+// multiplication, other cases use modular_context:
+//
+template <class Backend, expression_template_option ExpressionTemplates>
+inline void mulmod_n(number<Backend, ExpressionTemplates>* r, const number<Backend, ExpressionTemplates>* a, const number<Backend, ExpressionTemplates>* b, const number<Backend, ExpressionTemplates>& m, std::size_t n)
+{
+   if(m <= 0)
+      BOOST_THROW_EXCEPTION(std::domain_error("mulmod_n requires a positive modulus."));
+   detail::mulmod_n(r, a, b, m, n, backends::is_batch_fixed_cpp_int<Backend>());
+}
+
+} // namespace batch
+
+}} // namespaces
+
+#endif
@@ -133,6 +133,12 @@ public:
    {
       *this = o;
    }
+   template <digit_base_type B, class A, class E, E MinE, E MaxE>
+   explicit cpp_bin_float(const cpp_bin_float<0, B, A, E, MinE, MaxE> &o)
+      : m_exponent(o.exponent()), m_sign(o.sign())
+   {
+      *this = o;
+   }
    template <class Float>
    cpp_bin_float(const Float& f, 
       typename boost::enable_if_c<detail::is_cpp_bin_float_implicitly_constructible_from_type<Float, bit_count>::value>::type const* = 0)
@@ -200,7 +206,7 @@ public:
          break;
       default:
          typename cpp_bin_float<D, B, A, E, MinE, MaxE>::rep_type b(f.bits());
-         this->exponent() = f.exponent() + (E)bit_count - (E)cpp_bin_float<D, B, A, E, MinE, MaxE>::bit_count;
+         this->exponent() = f.exponent() + (E)bit_count - (E)f.precision_bits();
          this->sign() = f.sign();
          copy_and_round(*this, b);
       }
@@ -458,7 +464,7 @@ public:
 
    cpp_bin_float& operator=(const char *s);
 
-   void swap(cpp_bin_float &o) BOOST_NOEXCEPT
+   void swap(cpp_bin_float &o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<rep_type&>().swap(std::declval<rep_type&>())))
    {
       m_data.swap(o.m_data);
       std::swap(m_exponent, o.m_exponent);
@@ -509,6 +515,7 @@ public:
    const exponent_type& exponent()const { return m_exponent; }
    bool& sign() { return m_sign; }
    const bool& sign()const { return m_sign; }
+   unsigned precision_bits()const BOOST_NOEXCEPT { return bit_count; }
    void check_invariants()
    {
       using default_ops::eval_bit_test;
@@ -538,7 +545,7 @@ public:
 #endif
 
 template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class Int>
-inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &arg, int bits_to_keep = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count)
+inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &arg, int bits_to_keep)
 {
    // Precondition: exponent of res must have been set before this function is called
    // as we may need to adjust it based on how many bits_to_keep in arg are set.
@@ -602,12 +609,12 @@ inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent,
             ++bits_to_keep;
          }
       }
-      if(bits_to_keep != cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count)
+      if(bits_to_keep != static_cast<int>(res.precision_bits()))
       {
          // Normalize result when we're rounding to fewer bits than we can hold, only happens in conversions
          // to narrower types:
-         eval_left_shift(arg, cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - bits_to_keep);
-         res.exponent() -= static_cast<Exponent>(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - bits_to_keep);
+         eval_left_shift(arg, res.precision_bits() - bits_to_keep);
+         res.exponent() -= static_cast<Exponent>(res.precision_bits() - bits_to_keep);
       }
       res.bits() = arg;
    }
@@ -622,7 +629,7 @@ inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent,
       return;
    }
    // Result must be normalized:
-   BOOST_ASSERT(((int)eval_msb(res.bits()) == cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1));
+   BOOST_ASSERT(((int)eval_msb(res.bits()) == (int)res.precision_bits() - 1));
 
    if(res.exponent() > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent)
    {
@@ -638,6 +645,12 @@ inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent,
    }
 }
 
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class Int>
+inline void copy_and_round(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &arg)
+{
+   copy_and_round(res, arg, static_cast<int>(res.precision_bits()));
+}
+
 template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
 inline void do_eval_add(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
 {
@@ -999,6 +1012,121 @@ inline typename enable_if_c<is_signed<S>::value>::type eval_multiply(cpp_bin_flo
    eval_multiply(res, res, b);
 }
 
+//
+// Fused multiply-add, res = (a * b) + c with a single rounding, either term may be negated first.  The exact
+// product is formed in double_rep_type and added to c in a type wide enough for both: unless the terms overlap
+// they're at least 4 bits apart, and the smaller one only decides the direction of rounding, so is replaced
+// by a single bit below the other.  Special values, and products which certainly overflow or underflow, are
+// the same either way and go via an ordinary multiply and add:
+//
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void do_eval_multiply_add(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &c, bool negate_product, bool negate_c)
+{
+   using default_ops::eval_multiply;
+   using default_ops::eval_left_shift;
+   using default_ops::eval_msb;
+   using default_ops::eval_add;
+   using default_ops::eval_subtract;
+   using default_ops::eval_get_sign;
+
+   typedef cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   typedef typename float_type::exponent_type exponent_type;
+   typedef cpp_int_backend<is_void<Allocator>::value ? 3 * float_type::bit_count + 8 : 0, 3 * float_type::bit_count + 8, is_void<Allocator>::value ? unsigned_magnitude : signed_magnitude, unchecked, Allocator> sum_type;
+
+   if((a.exponent() > float_type::max_exponent) || (b.exponent() > float_type::max_exponent) || (c.exponent() > float_type::max_exponent)
+      || ((a.exponent() > 0) && (b.exponent() > 0) && (float_type::max_exponent + 2 - a.exponent() < b.exponent()))
+      || ((a.exponent() < 0) && (b.exponent() < 0) && (float_type::min_exponent - 2 - a.exponent() > b.exponent())))
+   {
+      float_type t;
+      eval_multiply(t, a, b);
+      if(negate_product)
+         t.negate();
+      if(negate_c)
+         eval_subtract(res, t, c);
+      else
+         eval_add(res, t, c);
+      return;
+   }
+
+   typename float_type::double_rep_type p;
+   eval_multiply(p, a.bits(), b.bits());
+   //
+   // The terms are p * 2^ep and c.bits() * 2^ec, with their most significant bits at tp and tc:
+   //
+   const exponent_type ep = a.exponent() + b.exponent() - 2 * static_cast<exponent_type>(float_type::bit_count - 1);
+   const exponent_type ec = c.exponent() - static_cast<exponent_type>(float_type::bit_count - 1);
+   const exponent_type tp = ep + static_cast<exponent_type>(eval_msb(p));
+   const exponent_type tc = c.exponent();
+   const bool sp = (a.sign() != b.sign()) != negate_product;
+   const bool sc = c.sign() != negate_c;
+
+   sum_type x, y;
+   exponent_type e0;
+   if(tc + 4 <= ep)
+   {
+      x = p;
+      eval_left_shift(x, 3);
+      y = static_cast<limb_type>(1u);
+      e0 = ep - 3;
+   }
+   else if(tp + 4 <= ec)
+   {
+      x = static_cast<limb_type>(1u);
+      y = c.bits();
+      eval_left_shift(y, 3);
+      e0 = ec - 3;
+   }
+   else
+   {
+      e0 = (std::min)(ep, ec);
+      x = p;
+      eval_left_shift(x, ep - e0);
+      y = c.bits();
+      eval_left_shift(y, ec - e0);
+   }
+
+   bool s = sp;
+   if(sp == sc)
+      eval_add(x, y);
+   else if(x.compare(y) >= 0)
+      eval_subtract(x, y);
+   else
+   {
+      eval_subtract(x, y, x);
+      s = sc;
+   }
+   if(eval_get_sign(x) == 0)
+      s = false; // exact cancellation gives +0
+   res.exponent() = e0 + static_cast<exponent_type>(float_type::bit_count - 1);
+   copy_and_round(res, x);
+   res.sign() = s;
+   res.check_invariants();
+}
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_add(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_multiply_add(res, a, b, res, false, false);
+}
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_add(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &c)
+{
+   do_eval_multiply_add(res, a, b, c, false, false);
+}
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_subtract(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_multiply_add(res, a, b, res, true, false);
+}
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_subtract(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &c)
+{
+   do_eval_multiply_add(res, a, b, c, false, true);
+}
+
 template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
 inline void eval_divide(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &u, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &v)
 {
@@ -1346,8 +1474,8 @@ inline void eval_convert_to(boost::long_long_type *res, const cpp_bin_float<Digi
    typedef typename mpl::if_c < sizeof(typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type) < sizeof(int), int, typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type > ::type shift_type;
    typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::rep_type man(arg.bits());
    shift_type shift 
-      = (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 - arg.exponent();
-   if(shift > (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1)
+      = (shift_type)arg.precision_bits() - 1 - arg.exponent();
+   if(shift > (shift_type)arg.precision_bits() - 1)
    {
       *res = 0;
       return;
@@ -1365,7 +1493,7 @@ inline void eval_convert_to(boost::long_long_type *res, const cpp_bin_float<Digi
 
    if (shift < 0)
    {
-      if (cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - shift <= std::numeric_limits<boost::long_long_type>::digits)
+      if (arg.precision_bits() - shift <= std::numeric_limits<boost::long_long_type>::digits)
       {
          // We have more bits in long_long_type than the float, so it's OK to left shift:
          eval_convert_to(res, man);
@@ -1405,15 +1533,15 @@ inline void eval_convert_to(boost::ulong_long_type *res, const cpp_bin_float<Dig
    typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::rep_type man(arg.bits());
    typedef typename mpl::if_c < sizeof(typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type) < sizeof(int), int, typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type > ::type shift_type;
    shift_type shift 
-      = (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 - arg.exponent();
-   if(shift > (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1)
+      = (shift_type)arg.precision_bits() - 1 - arg.exponent();
+   if(shift > (shift_type)arg.precision_bits() - 1)
    {
       *res = 0;
       return;
    }
    else if(shift < 0)
    {
-      if (cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - shift <= std::numeric_limits<boost::ulong_long_type>::digits)
+      if (arg.precision_bits() - shift <= std::numeric_limits<boost::ulong_long_type>::digits)
       {
          // We have more bits in ulong_long_type than the float, so it's OK to left shift:
          eval_convert_to(res, man);
@@ -1488,7 +1616,7 @@ inline typename boost::enable_if_c<boost::is_float<Float>::value>::type eval_con
    arg.exponent() = original_arg.exponent();
    copy_and_round(arg, bits, (int)digits_to_round_to);
    common_exp_type e = arg.exponent();
-   e -= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1;
+   e -= original_arg.precision_bits() - 1;
    static const unsigned limbs_needed = std::numeric_limits<Float>::digits / (sizeof(*arg.bits().limbs()) * CHAR_BIT)
       + (std::numeric_limits<Float>::digits % (sizeof(*arg.bits().limbs()) * CHAR_BIT) ? 1 : 0);
    unsigned first_limb_needed = arg.bits().size() - limbs_needed;
@@ -1684,14 +1812,14 @@ inline void eval_floor(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, Min
    }
    typedef typename mpl::if_c < sizeof(typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type) < sizeof(int), int, typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type > ::type shift_type;
    shift_type shift = 
-      (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - arg.exponent() - 1;
+      (shift_type)arg.precision_bits() - arg.exponent() - 1;
    if((arg.exponent() > (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent) || (shift <= 0))
    {
       // Either arg is already an integer, or a special value:
       res = arg;
       return;
    }
-   if(shift >= (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count)
+   if(shift >= (shift_type)arg.precision_bits())
    {
       res = static_cast<signed_limb_type>(arg.sign() ? -1 : 0);
       return;
@@ -1702,7 +1830,7 @@ inline void eval_floor(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, Min
    if(fractional && res.sign())
    {
       eval_increment(res.bits());
-      if(eval_msb(res.bits()) != cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 - shift)
+      if(eval_msb(res.bits()) != arg.precision_bits() - 1 - shift)
       {
          // Must have extended result by one bit in the increment:
          --shift;
@@ -1727,14 +1855,14 @@ inline void eval_ceil(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE
       return;
    }
    typedef typename mpl::if_c < sizeof(typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type) < sizeof(int), int, typename cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_type > ::type shift_type;
-   shift_type shift = (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - arg.exponent() - 1;
+   shift_type shift = (shift_type)arg.precision_bits() - arg.exponent() - 1;
    if((arg.exponent() > (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent) || (shift <= 0))
    {
       // Either arg is already an integer, or a special value:
       res = arg;
       return;
    }
-   if(shift >= (shift_type)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count)
+   if(shift >= (shift_type)arg.precision_bits())
    {
       bool s = arg.sign(); // takes care of signed zeros
       res = static_cast<signed_limb_type>(arg.sign() ? 0 : 1);
@@ -1747,7 +1875,7 @@ inline void eval_ceil(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE
    if(fractional && !res.sign())
    {
       eval_increment(res.bits());
-      if(eval_msb(res.bits()) != cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 - shift)
+      if(eval_msb(res.bits()) != arg.precision_bits() - 1 - shift)
       {
          // Must have extended result by one bit in the increment:
          --shift;
@@ -1808,7 +1936,7 @@ struct number_category<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, Min
 template<unsigned Digits, backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
 struct expression_template_default<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> >
 {
-   static const expression_template_option value = is_void<Allocator>::value ? et_off : et_on;
+   static const expression_template_option value = (is_void<Allocator>::value && (Digits != 0)) ? et_off : et_on;
 };
 
 typedef number<backends::cpp_bin_float<50> > cpp_bin_float_50;
@@ -1833,6 +1961,7 @@ namespace math {
 
 #include <boost/multiprecision/cpp_bin_float/io.hpp>
 #include <boost/multiprecision/cpp_bin_float/transcendental.hpp>
+#include <boost/multiprecision/cpp_bin_float/variable.hpp>
 
 namespace std{
 
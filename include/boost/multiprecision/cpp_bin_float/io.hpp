@@ -165,17 +165,18 @@ inline int get_round_mode(cpp_int& r, cpp_int& d, boost::int64_t error, const cp
    return 0;
 }
 
-} // namespace
-
-namespace backends{
-
-template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
-cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::operator=(const char *s)
+//
+// Sets x to the string s, correctly rounded to bit_count bits:
+//
+template <class Float>
+void assign_from_string(Float& x, const char* s, boost::intmax_t bit_count)
 {
+   typedef typename Float::exponent_type exponent_type;
+
    cpp_int n;
    boost::intmax_t decimal_exp = 0;
    boost::intmax_t digits_seen = 0;
-   static const boost::intmax_t max_digits_seen = 4 + (cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count * 301L) / 1000;
+   const boost::intmax_t max_digits_seen = 4 + (bit_count * 301L) / 1000;
    bool ss = false;
    //
    // Extract the sign:
@@ -192,14 +193,17 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
    //
    if((std::strcmp(s, "nan") == 0) || (std::strcmp(s, "NaN") == 0) || (std::strcmp(s, "NAN") == 0))
    {
-      return *this = std::numeric_limits<number<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> > >::quiet_NaN().backend();
+      x.bits() = limb_type(0);
+      x.exponent() = Float::exponent_nan;
+      x.sign() = false;
+      return;
    }
    if((std::strcmp(s, "inf") == 0) || (std::strcmp(s, "Inf") == 0) || (std::strcmp(s, "INF") == 0) || (std::strcmp(s, "infinity") == 0) || (std::strcmp(s, "Infinity") == 0) || (std::strcmp(s, "INFINITY") == 0))
    {
-      *this = std::numeric_limits<number<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> > >::infinity().backend();
-      if(ss)
-         negate();
-      return *this;
+      x.bits() = limb_type(0);
+      x.exponent() = Float::exponent_infinity;
+      x.sign() = ss;
+      return;
    }
    //
    // Digits before the point:
@@ -269,26 +273,26 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
    if(n == 0)
    {
       // Result is necessarily zero:
-      *this = static_cast<limb_type>(0u);
-      return *this;
+      x = static_cast<limb_type>(0u);
+      return;
    }
 
    static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
    //
    // Set our working precision - this is heuristic based, we want
-   // a value as small as possible > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count to avoid large computations
+   // a value as small as possible > bit_count to avoid large computations
    // and excessive memory usage, but we also want to avoid having to
    // up the computation and start again at a higher precision.
-   // So we round cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count up to the nearest whole number of limbs, and add
+   // So we round bit_count up to the nearest whole number of limbs, and add
    // one limb for good measure.  This works very well for small exponents,
    // but for larger exponents we may may need to restart, we could add some
    // extra precision right from the start for larger exponents, but this
    // seems to be slightly slower in the *average* case:
    //
 #ifdef BOOST_MP_STRESS_IO
-   boost::intmax_t max_bits = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + 32;
+   boost::intmax_t max_bits = bit_count + 32;
 #else
-   boost::intmax_t max_bits = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + ((cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count % limb_bits) ? (limb_bits - cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count % limb_bits) : 0) + limb_bits;
+   boost::intmax_t max_bits = bit_count + ((bit_count % limb_bits) ? (limb_bits - bit_count % limb_bits) : 0) + limb_bits;
 #endif
    boost::int64_t error = 0;
    boost::intmax_t calc_exp = 0;
@@ -307,8 +311,8 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
          }
          else
             t = n;
-         final_exponent = (boost::int64_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 + decimal_exp + calc_exp;
-         int rshift = msb(t) - cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + 1;
+         final_exponent = (boost::int64_t)bit_count - 1 + decimal_exp + calc_exp;
+         int rshift = msb(t) - bit_count + 1;
          if(rshift > 0)
          {
             final_exponent += rshift;
@@ -331,29 +335,29 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
          {
             BOOST_ASSERT(!error);
          }
-         if(final_exponent > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent)
+         if(final_exponent > Float::max_exponent)
          {
-            exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent;
-            final_exponent -= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent;
+            x.exponent() = Float::max_exponent;
+            final_exponent -= Float::max_exponent;
          }
-         else if(final_exponent < cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent)
+         else if(final_exponent < Float::min_exponent)
          {
             // Underflow:
-            exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent;
-            final_exponent -= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent;
+            x.exponent() = Float::min_exponent;
+            final_exponent -= Float::min_exponent;
          }
          else
          {
-            exponent() = static_cast<Exponent>(final_exponent);
+            x.exponent() = static_cast<exponent_type>(final_exponent);
             final_exponent = 0;
          }
-         copy_and_round(*this, t.backend());
+         copy_and_round(x, t.backend());
          break;
       }
       while(true);
 
-      if(ss != sign())
-         negate();
+      if(ss != x.sign())
+         x.negate();
    }
    else
    {
@@ -365,35 +369,35 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
       {
          cpp_int d;
          calc_exp = boost::multiprecision::cpp_bf_io_detail::restricted_pow(d, cpp_int(5), -decimal_exp, max_bits, error);
-         int shift = (int)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - msb(n) + msb(d);
-         final_exponent = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1 + decimal_exp - calc_exp;
+         int shift = (int)bit_count - msb(n) + msb(d);
+         final_exponent = bit_count - 1 + decimal_exp - calc_exp;
          if(shift > 0)
          {
             n <<= shift;
-            final_exponent -= static_cast<Exponent>(shift);
+            final_exponent -= static_cast<exponent_type>(shift);
          }
          cpp_int q, r;
          divide_qr(n, d, q, r);
          int gb = msb(q);
-         BOOST_ASSERT((gb >= static_cast<int>(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count) - 1));
+         BOOST_ASSERT((gb >= static_cast<int>(bit_count) - 1));
          //
          // Check for rounding conditions we have to
          // handle ourselves:
          //
          int roundup = 0;
-         if(gb == cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1)
+         if(gb == bit_count - 1)
          {
             // Exactly the right number of bits, use the remainder to round:
             roundup = boost::multiprecision::cpp_bf_io_detail::get_round_mode(r, d, error, q);
          }
-         else if(bit_test(q, gb - (int)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count) && ((int)lsb(q) == (gb - (int)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count)))
+         else if(bit_test(q, gb - (int)bit_count) && ((int)lsb(q) == (gb - (int)bit_count)))
          {
             // Too many bits in q and the bits in q indicate a tie, but we can break that using r,
             // note that the radius of error in r is error/2 * q:
-            int lshift = gb - (int)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + 1;
+            int lshift = gb - (int)bit_count + 1;
             q >>= lshift;
-            final_exponent += static_cast<Exponent>(lshift);
-            BOOST_ASSERT((msb(q) >= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - 1));
+            final_exponent += static_cast<exponent_type>(lshift);
+            BOOST_ASSERT((msb(q) >= bit_count - 1));
             if(error && (r < (error / 2) * q))
                roundup = -1;
             else if(error && (r + (error / 2) * q >= d))
@@ -417,32 +421,32 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
             if(shift > 0)
             {
                n >>= shift;
-               final_exponent += static_cast<Exponent>(shift);
+               final_exponent += static_cast<exponent_type>(shift);
             }
             continue;
          }
          else if((roundup == 2) || ((roundup == 1) && q.backend().limbs()[0] & 1))
             ++q;
-         if(final_exponent > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent)
+         if(final_exponent > Float::max_exponent)
          {
             // Overflow:
-            exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent;
-            final_exponent -= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent;
+            x.exponent() = Float::max_exponent;
+            final_exponent -= Float::max_exponent;
          }
-         else if(final_exponent < cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent)
+         else if(final_exponent < Float::min_exponent)
          {
             // Underflow:
-            exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent;
-            final_exponent -= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent;
+            x.exponent() = Float::min_exponent;
+            final_exponent -= Float::min_exponent;
          }
          else
          {
-            exponent() = static_cast<Exponent>(final_exponent);
+            x.exponent() = static_cast<exponent_type>(final_exponent);
             final_exponent = 0;
          }
-         copy_and_round(*this, q.backend());
-         if(ss != sign())
-            negate();
+         copy_and_round(x, q.backend());
+         if(ss != x.sign())
+            x.negate();
          break;
       }
       while(true);
@@ -450,44 +454,43 @@ cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float
    //
    // Check for scaling and/or over/under-flow:
    //
-   final_exponent += exponent();
-   if(final_exponent > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent)
+   final_exponent += x.exponent();
+   if(final_exponent > Float::max_exponent)
    {
       // Overflow:
-      exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_infinity;
-      bits() = limb_type(0);
+      x.exponent() = Float::exponent_infinity;
+      x.bits() = limb_type(0);
    }
-   else if(final_exponent < cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::min_exponent)
+   else if(final_exponent < Float::min_exponent)
    {
       // Underflow:
-      exponent() = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_zero;
-      bits() = limb_type(0);
-      sign() = 0;
+      x.exponent() = Float::exponent_zero;
+      x.bits() = limb_type(0);
+      x.sign() = 0;
    }
    else
    {
-      exponent() = static_cast<Exponent>(final_exponent);
+      x.exponent() = static_cast<exponent_type>(final_exponent);
    }
-   return *this;
 }
 
-template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
-std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::str(std::streamsize dig, std::ios_base::fmtflags f) const
+//
+// Formats x with dig digits, where x has bit_count bits of precision:
+//
+template <class Float>
+std::string float_to_string(const Float& x, std::streamsize dig, std::ios_base::fmtflags f, boost::intmax_t bit_count)
 {
-   if(dig == 0)
-      dig = std::numeric_limits<number<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> > >::max_digits10;
-
    bool scientific = (f & std::ios_base::scientific) == std::ios_base::scientific;
    bool fixed = !scientific && (f & std::ios_base::fixed);
 
    std::string s;
 
-   if(exponent() <= cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::max_exponent)
+   if(x.exponent() <= Float::max_exponent)
    {
       // How far to left-shift in order to demormalise the mantissa:
-      boost::intmax_t shift = (boost::intmax_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - (boost::intmax_t)exponent() - 1;
+      boost::intmax_t shift = (boost::intmax_t)bit_count - (boost::intmax_t)x.exponent() - 1;
       boost::intmax_t digits_wanted = static_cast<int>(dig);
-      boost::intmax_t base10_exp = exponent() >= 0 ? static_cast<boost::intmax_t>(std::floor(0.30103 * exponent())) : static_cast<boost::intmax_t>(std::ceil(0.30103 * exponent()));
+      boost::intmax_t base10_exp = x.exponent() >= 0 ? static_cast<boost::intmax_t>(std::floor(0.30103 * x.exponent())) : static_cast<boost::intmax_t>(std::ceil(0.30103 * x.exponent()));
       //
       // For fixed formatting we want /dig/ digits after the decimal point,
       // so if the exponent is zero, allowing for the one digit before the
@@ -501,7 +504,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
       {
          // Fixed precision, no significant digits, and nothing to round!
          s = "0";
-         if(sign())
+         if(x.sign())
             s.insert(static_cast<std::string::size_type>(0), 1, '-');
          boost::multiprecision::detail::format_float_string(s, base10_exp, dig, f, true);
          return s;
@@ -521,17 +524,17 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
       static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
       //
       // Set our working precision - this is heuristic based, we want
-      // a value as small as possible > cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count to avoid large computations
+      // a value as small as possible > bit_count to avoid large computations
       // and excessive memory usage, but we also want to avoid having to
       // up the computation and start again at a higher precision.
-      // So we round cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count up to the nearest whole number of limbs, and add
+      // So we round bit_count up to the nearest whole number of limbs, and add
       // one limb for good measure.  This works very well for small exponents,
       // but for larger exponents we add a few extra limbs to max_bits:
       //
 #ifdef BOOST_MP_STRESS_IO
-      boost::intmax_t max_bits = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + 32;
+      boost::intmax_t max_bits = bit_count + 32;
 #else
-      boost::intmax_t max_bits = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count + ((cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count % limb_bits) ? (limb_bits - cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count % limb_bits) : 0) + limb_bits;
+      boost::intmax_t max_bits = bit_count + ((bit_count % limb_bits) ? (limb_bits - bit_count % limb_bits) : 0) + limb_bits;
       if(power10)
          max_bits += (msb(boost::multiprecision::detail::abs(power10)) / 8) * limb_bits;
 #endif
@@ -540,9 +543,9 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
          boost::int64_t error = 0;
          boost::intmax_t calc_exp = 0;
          //
-         // Our integer result is: bits() * 2^-shift * 5^power10
+         // Our integer result is: x.bits() * 2^-shift * 5^power10
          //
-         i = bits();
+         i = x.bits();
          if(shift < 0)
          {
             if(power10 >= 0)
@@ -571,7 +574,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
 #else
                   max_bits *= 2;
 #endif
-                  shift = (boost::intmax_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - exponent() - 1 - power10;
+                  shift = (boost::intmax_t)bit_count - x.exponent() - 1 - power10;
                   continue;
                }
             }
@@ -579,7 +582,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
          else
          {
             //
-            // Our integer is bits() * 2^-shift * 10^power10
+            // Our integer is x.bits() * 2^-shift * 10^power10
             //
             if(power10 > 0)
             {
@@ -599,7 +602,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
 #else
                   max_bits *= 2;
 #endif
-                  shift = (boost::intmax_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - exponent() - 1 - power10;
+                  shift = (boost::intmax_t)bit_count - x.exponent() - 1 - power10;
                   continue;
                }
                if(shift)
@@ -612,7 +615,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
 #else
                      max_bits *= 2;
 #endif
-                     shift = (boost::intmax_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - exponent() - 1 - power10;
+                     shift = (boost::intmax_t)bit_count - x.exponent() - 1 - power10;
                      continue;
                   }
                   i >>= shift;
@@ -646,7 +649,7 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
             if(fixed)
                digits_wanted = digits_got;  // strange but true.
             power10 = digits_wanted - base10_exp - 1;
-            shift = (boost::intmax_t)cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count - exponent() - 1 - power10;
+            shift = (boost::intmax_t)bit_count - x.exponent() - 1 - power10;
             if(fixed)
                break;
             roundup = 0;
@@ -666,30 +669,49 @@ std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::s
          boost::multiprecision::detail::round_string_up_at(s, static_cast<int>(s.size() - 1), base10_exp);
       }
 
-      if(sign())
+      if(x.sign())
          s.insert(static_cast<std::string::size_type>(0), 1, '-');
 
       boost::multiprecision::detail::format_float_string(s, base10_exp, dig, f, false);
    }
    else
    {
-      switch(exponent())
+      switch(x.exponent())
       {
-      case exponent_zero:
-         s = sign() ? "-0" : f & std::ios_base::showpos ? "+0" : "0";
+      case Float::exponent_zero:
+         s = x.sign() ? "-0" : f & std::ios_base::showpos ? "+0" : "0";
          boost::multiprecision::detail::format_float_string(s, 0, dig, f, true);
          break;
-      case exponent_nan:
+      case Float::exponent_nan:
          s = "nan";
          break;
-      case exponent_infinity:
-         s = sign() ? "-inf" : f & std::ios_base::showpos ? "+inf" : "inf";
+      case Float::exponent_infinity:
+         s = x.sign() ? "-inf" : f & std::ios_base::showpos ? "+inf" : "inf";
          break;
       }
    }
    return s;
 }
 
+} // namespace
+
+namespace backends{
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>& cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::operator=(const char *s)
+{
+   boost::multiprecision::cpp_bf_io_detail::assign_from_string(*this, s, bit_count);
+   return *this;
+}
+
+template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+std::string cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::str(std::streamsize dig, std::ios_base::fmtflags f) const
+{
+   if(dig == 0)
+      dig = std::numeric_limits<number<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> > >::max_digits10;
+   return boost::multiprecision::cpp_bf_io_detail::float_to_string(*this, dig, f, bit_count);
+}
+
 #ifdef BOOST_MSVC
 #pragma warning(pop)
 #endif
@@ -11,7 +11,7 @@ namespace boost{ namespace multiprecision{ namespace backends{
 template <unsigned Digits, digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
 void eval_exp_taylor(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> &arg)
 {
-   static const int bits = cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count;
+   const int bits = static_cast<int>(res.precision_bits());
    //
    // Taylor series for small argument, note returns exp(x) - 1:
    //
@@ -124,7 +124,7 @@ void eval_exp(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>
    BOOST_ASSERT(t.compare(default_ops::get_constant_ln2<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> >()) < 0);
 
    k = nn ? Exponent(1) << (msb(nn) / 2) : 0;
-   k = (std::min)(k, (Exponent)(cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE>::bit_count / 4));
+   k = (std::min)(k, (Exponent)(res.precision_bits() / 4));
    eval_ldexp(t, t, -k);
 
    eval_exp_taylor(res, t);
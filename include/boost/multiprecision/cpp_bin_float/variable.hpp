@@ -0,0 +1,1089 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifndef BOOST_MULTIPRECISION_CPP_BIN_FLOAT_VARIABLE_HPP
+#define BOOST_MULTIPRECISION_CPP_BIN_FLOAT_VARIABLE_HPP
+
+#include <boost/multiprecision/detail/digits.hpp>
+#include <boost/multiprecision/traits/is_variable_precision.hpp>
+
+//
+// The precision, in decimal digits, of new values of cpp_bin_float<0> until the thread
+// changes it with default_precision():
+//
+#ifndef BOOST_MULTIPRECISION_CPP_BIN_FLOAT_DEFAULT_PRECISION
+#  define BOOST_MULTIPRECISION_CPP_BIN_FLOAT_DEFAULT_PRECISION 50
+#endif
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable:4522 6326)  // multiple assignment operators specified, comparison of two constants
+#endif
+
+//
+// Variable precision cpp_bin_float: each value carries its own precision in bits and the mantissa
+// is an allocated cpp_int of exactly that many bits, so values at low precision stay cheap while
+// others in the same program are much wider.  New values take the thread's default precision,
+// which, as with mpfr_float and gmp_float<0>, is a decimal digit count.
+//
+// Arithmetic is carried out exactly (or with a sticky bit below the rounding position) and then
+// rounded once to the precision of the result, so operands of differing precisions may be mixed
+// freely.  The exponent range is fixed and smaller than for the fixed precision types, so that
+// no precision can push an exponent out of the range of exponent_type:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinExponent, Exponent MaxExponent>
+class cpp_bin_float<0u, DigitBase, Allocator, Exponent, MinExponent, MaxExponent>
+{
+public:
+   typedef cpp_int_backend<0, 0, signed_magnitude, unchecked, typename mpl::if_<is_void<Allocator>, std::allocator<limb_type>, Allocator>::type> rep_type;
+
+   typedef typename rep_type::signed_types                        signed_types;
+   typedef typename rep_type::unsigned_types                      unsigned_types;
+   typedef boost::mpl::list<float, double, long double>           float_types;
+   typedef Exponent                                               exponent_type;
+
+   static const exponent_type max_exponent_limit = boost::integer_traits<exponent_type>::const_max / 4;
+   static const exponent_type min_exponent_limit = boost::integer_traits<exponent_type>::const_min / 4;
+
+   BOOST_STATIC_ASSERT_MSG(MinExponent >= min_exponent_limit, "Template parameter MinExponent is too negative for our internal logic to function correctly, sorry!");
+   BOOST_STATIC_ASSERT_MSG(MaxExponent <= max_exponent_limit, "Template parameter MaxExponent is too large for our internal logic to function correctly, sorry!");
+   BOOST_STATIC_ASSERT_MSG(MinExponent <= 0, "Template parameter MinExponent can not be positive!");
+   BOOST_STATIC_ASSERT_MSG(MaxExponent >= 0, "Template parameter MaxExponent can not be negative!");
+
+   static const exponent_type max_exponent = MaxExponent == 0 ? max_exponent_limit : MaxExponent;
+   static const exponent_type min_exponent = MinExponent == 0 ? min_exponent_limit : MinExponent;
+
+   static const exponent_type exponent_zero = max_exponent + 1;
+   static const exponent_type exponent_infinity = max_exponent + 2;
+   static const exponent_type exponent_nan = max_exponent + 3;
+
+private:
+
+   rep_type m_data;
+   exponent_type m_exponent;
+   bool m_sign;
+   unsigned m_bit_count;
+
+   static unsigned& get_default_precision() BOOST_NOEXCEPT
+   {
+      static BOOST_MP_THREAD_LOCAL unsigned val = BOOST_MULTIPRECISION_CPP_BIN_FLOAT_DEFAULT_PRECISION;
+      return val;
+   }
+   static unsigned bits_for(unsigned digits10) BOOST_NOEXCEPT
+   {
+      return static_cast<unsigned>(boost::multiprecision::detail::digits10_2_2(digits10 ? digits10 : 1));
+   }
+public:
+   cpp_bin_float() : m_data(), m_exponent(exponent_zero), m_sign(false), m_bit_count(bits_for(get_default_precision())) {}
+
+   cpp_bin_float(const cpp_bin_float &o)
+      : m_data(o.m_data), m_exponent(o.m_exponent), m_sign(o.m_sign), m_bit_count(o.m_bit_count) {}
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+   cpp_bin_float(cpp_bin_float &&o) BOOST_NOEXCEPT
+      : m_data(static_cast<rep_type&&>(o.m_data)), m_exponent(o.m_exponent), m_sign(o.m_sign), m_bit_count(o.m_bit_count) {}
+#endif
+   //
+   // Values of the fixed precision types are held exactly, at their own precision:
+   //
+   template <unsigned D, digit_base_type B, class A, class E, E MinE, E MaxE>
+   cpp_bin_float(const cpp_bin_float<D, B, A, E, MinE, MaxE> &o)
+      : m_data(), m_exponent(exponent_zero), m_sign(false), m_bit_count(o.precision_bits())
+   {
+      *this = o;
+   }
+   cpp_bin_float(const cpp_bin_float &o, unsigned digits10)
+      : m_data(), m_exponent(exponent_zero), m_sign(false), m_bit_count(bits_for(digits10))
+   {
+      *this = o;
+      precision(digits10);
+   }
+   template <class V>
+   cpp_bin_float(const V &o, unsigned digits10)
+      : m_data(), m_exponent(exponent_zero), m_sign(false), m_bit_count(bits_for(digits10))
+   {
+      *this = o;
+      precision(digits10);
+   }
+
+   cpp_bin_float& operator=(const cpp_bin_float &o)
+   {
+      m_data = o.m_data;
+      m_exponent = o.m_exponent;
+      m_sign = o.m_sign;
+      m_bit_count = o.m_bit_count;
+      return *this;
+   }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+   cpp_bin_float& operator=(cpp_bin_float &&o) BOOST_NOEXCEPT
+   {
+      m_data = static_cast<rep_type&&>(o.m_data);
+      m_exponent = o.m_exponent;
+      m_sign = o.m_sign;
+      m_bit_count = o.m_bit_count;
+      return *this;
+   }
+#endif
+   template <unsigned D, digit_base_type B, class A, class E, E MinE, E MaxE>
+   cpp_bin_float& operator=(const cpp_bin_float<D, B, A, E, MinE, MaxE> &f)
+   {
+      typedef cpp_bin_float<D, B, A, E, MinE, MaxE> other_type;
+      m_bit_count = f.precision_bits();
+      m_sign = f.sign();
+      m_data = limb_type(0);
+      if(f.exponent() == other_type::exponent_zero)
+         m_exponent = exponent_zero;
+      else if(f.exponent() == other_type::exponent_infinity)
+         m_exponent = exponent_infinity;
+      else if(f.exponent() == other_type::exponent_nan)
+      {
+         m_exponent = exponent_nan;
+         m_sign = false;
+      }
+      else if(static_cast<boost::intmax_t>(f.exponent()) > max_exponent)
+         m_exponent = exponent_infinity;
+      else if(static_cast<boost::intmax_t>(f.exponent()) < min_exponent)
+         m_exponent = exponent_zero;
+      else
+      {
+         m_data = f.bits();
+         m_exponent = static_cast<exponent_type>(f.exponent());
+      }
+      return *this;
+   }
+
+   template <class Float>
+   typename boost::enable_if_c<is_floating_point<Float>::value, cpp_bin_float&>::type operator=(Float f)
+   {
+      BOOST_MATH_STD_USING
+      using default_ops::eval_add;
+      using default_ops::eval_left_shift;
+
+      switch((boost::math::fpclassify)(f))
+      {
+      case FP_ZERO:
+         m_data = limb_type(0);
+         m_sign = ((boost::math::signbit)(f) > 0);
+         m_exponent = exponent_zero;
+         return *this;
+      case FP_NAN:
+         m_data = limb_type(0);
+         m_sign = false;
+         m_exponent = exponent_nan;
+         return *this;
+      case FP_INFINITE:
+         m_data = limb_type(0);
+         m_sign = (f < 0);
+         m_exponent = exponent_infinity;
+         return *this;
+      }
+      m_sign = f < 0;
+      if(m_sign)
+         f = -f;
+      //
+      // Gather the mantissa exactly, then round once:
+      //
+      rep_type m;
+      static const int bits = sizeof(int) * CHAR_BIT - 1;
+      int e;
+      f = frexp(f, &e);
+      while(f)
+      {
+         f = ldexp(f, bits);
+         e -= bits;
+#ifndef BOOST_MATH_NO_LONG_DOUBLE_MATH_FUNCTIONS
+         int ipart = itrunc(f);
+#else
+         int ipart = static_cast<int>(f);
+#endif
+         f -= ipart;
+         eval_left_shift(m, bits);
+         eval_add(m, static_cast<limb_type>(ipart));
+      }
+      copy_and_round_scaled(*this, m, e);
+      return *this;
+   }
+
+   template <class I>
+   typename boost::enable_if<is_integral<I>, cpp_bin_float&>::type operator=(const I& i)
+   {
+      typedef typename make_unsigned<I>::type ui_type;
+      typedef typename boost::multiprecision::detail::canonical<ui_type, rep_type>::type ar_type;
+      rep_type m;
+      m = static_cast<ar_type>(static_cast<ui_type>(boost::multiprecision::detail::unsigned_abs(i)));
+      m_sign = detail::is_negative(i);
+      copy_and_round_scaled(*this, m, 0);
+      return *this;
+   }
+
+   cpp_bin_float& operator=(const char *s)
+   {
+      boost::multiprecision::cpp_bf_io_detail::assign_from_string(*this, s, m_bit_count);
+      return *this;
+   }
+
+   void swap(cpp_bin_float &o) BOOST_NOEXCEPT
+   {
+      m_data.swap(o.m_data);
+      std::swap(m_exponent, o.m_exponent);
+      std::swap(m_sign, o.m_sign);
+      std::swap(m_bit_count, o.m_bit_count);
+   }
+
+   std::string str(std::streamsize dig, std::ios_base::fmtflags f) const
+   {
+      if(dig == 0)
+         dig = static_cast<std::streamsize>(boost::multiprecision::detail::digits2_2_10(m_bit_count)) + 3;
+      return boost::multiprecision::cpp_bf_io_detail::float_to_string(*this, dig, f, m_bit_count);
+   }
+
+   void negate()
+   {
+      if(m_exponent != exponent_nan)
+         m_sign = !m_sign;
+   }
+
+   int compare(const cpp_bin_float &o) const
+   {
+      using default_ops::eval_left_shift;
+      if(m_sign != o.m_sign)
+         return (m_exponent == exponent_zero) && (m_exponent == o.m_exponent) ? 0 : m_sign ? -1 : 1;
+      int result;
+      if(m_exponent == exponent_nan)
+         return -1;
+      else if(m_exponent != o.m_exponent)
+      {
+         if(m_exponent == exponent_zero)
+            result = -1;
+         else if(o.m_exponent == exponent_zero)
+            result = 1;
+         else
+            result = m_exponent > o.m_exponent ? 1 : -1;
+      }
+      else if(m_bit_count == o.m_bit_count)
+         result = m_data.compare(o.m_data);
+      else if(m_bit_count < o.m_bit_count)
+      {
+         // Same exponent, so line up the mantissas:
+         rep_type t(m_data);
+         eval_left_shift(t, o.m_bit_count - m_bit_count);
+         result = t.compare(o.m_data);
+      }
+      else
+      {
+         rep_type t(o.m_data);
+         eval_left_shift(t, m_bit_count - o.m_bit_count);
+         result = m_data.compare(t);
+      }
+      if(m_sign)
+         result = -result;
+      return result;
+   }
+   template <class A>
+   int compare(const A& o) const
+   {
+      cpp_bin_float b;
+      b.m_bit_count = (std::max)(m_bit_count, static_cast<unsigned>(sizeof(A) * CHAR_BIT));
+      b = o;
+      return compare(b);
+   }
+
+   rep_type& bits() { return m_data; }
+   const rep_type& bits()const { return m_data; }
+   exponent_type& exponent() { return m_exponent; }
+   const exponent_type& exponent()const { return m_exponent; }
+   bool& sign() { return m_sign; }
+   const bool& sign()const { return m_sign; }
+   unsigned precision_bits()const BOOST_NOEXCEPT { return m_bit_count; }
+   //
+   // Precision in decimal digits, the value is rounded when the precision is reduced:
+   //
+   static unsigned default_precision() BOOST_NOEXCEPT
+   {
+      return get_default_precision();
+   }
+   static void default_precision(unsigned digits10) BOOST_NOEXCEPT
+   {
+      get_default_precision() = digits10 ? digits10 : 1;
+   }
+   unsigned precision()const BOOST_NOEXCEPT
+   {
+      return static_cast<unsigned>(boost::multiprecision::detail::digits2_2_10(m_bit_count));
+   }
+   void precision(unsigned digits10)
+   {
+      precision_bits(bits_for(digits10));
+   }
+   //
+   // Sets the precision in bits directly, for code such as deserialization which must restore it exactly:
+   //
+   void precision_bits(unsigned bits)
+   {
+      using default_ops::eval_left_shift;
+      BOOST_ASSERT(bits);
+      if((m_exponent > max_exponent) || (bits == m_bit_count))
+         m_bit_count = bits;
+      else if(bits > m_bit_count)
+      {
+         eval_left_shift(m_data, bits - m_bit_count);
+         m_bit_count = bits;
+      }
+      else
+      {
+         rep_type m;
+         m.swap(m_data);
+         const boost::intmax_t lsb = static_cast<boost::intmax_t>(m_exponent) - static_cast<boost::intmax_t>(m_bit_count - 1);
+         m_bit_count = bits;
+         copy_and_round_scaled(*this, m, lsb);
+      }
+   }
+   void check_invariants()
+   {
+      using default_ops::eval_bit_test;
+      using default_ops::eval_is_zero;
+      using default_ops::eval_msb;
+      if((m_exponent <= max_exponent) && (m_exponent >= min_exponent))
+      {
+         BOOST_ASSERT(eval_msb(m_data) == m_bit_count - 1);
+      }
+      else
+      {
+         BOOST_ASSERT(m_exponent > max_exponent);
+         BOOST_ASSERT(m_exponent <= exponent_nan);
+         BOOST_ASSERT(eval_is_zero(m_data));
+      }
+   }
+   template<class Archive>
+   void serialize(Archive & ar, const unsigned int /*version*/)
+   {
+      ar & m_data;
+      ar & m_exponent;
+      ar & m_sign;
+      ar & m_bit_count;
+   }
+};
+
+//
+// Sets res to arg * 2^lsb rounded to the precision of res, where arg is non-negative and the sign of
+// res has already been set.  arg is first brought to between p and p + 2 bits, folding anything
+// shifted off the bottom into a sticky bit, so that copy_and_round sees a value it can round directly:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class Int>
+inline void copy_and_round_scaled(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &arg, boost::intmax_t lsb)
+{
+   using default_ops::eval_msb;
+   using default_ops::eval_lsb;
+   using default_ops::eval_left_shift;
+   using default_ops::eval_right_shift;
+   using default_ops::eval_bit_set;
+   using default_ops::eval_get_sign;
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+
+   if(eval_get_sign(arg) == 0)
+   {
+      res.bits() = limb_type(0);
+      res.exponent() = float_type::exponent_zero;
+      res.sign() = false;
+      return;
+   }
+   const boost::intmax_t p = res.precision_bits();
+   boost::intmax_t msb = eval_msb(arg);
+   const boost::intmax_t top = lsb + msb;
+   if(top > float_type::max_exponent)
+   {
+      res.bits() = limb_type(0);
+      res.exponent() = float_type::exponent_infinity;
+      return;
+   }
+   if(top < float_type::min_exponent - 1)
+   {
+      res.bits() = limb_type(0);
+      res.exponent() = float_type::exponent_zero;
+      return;
+   }
+   if(msb + 1 < p)
+   {
+      eval_left_shift(arg, static_cast<unsigned>(p - msb - 1));
+      msb = p - 1;
+   }
+   else if(msb > p + 1)
+   {
+      const unsigned shift = static_cast<unsigned>(msb - p - 1);
+      const bool sticky = eval_lsb(arg) < shift;
+      eval_right_shift(arg, shift);
+      if(sticky)
+         eval_bit_set(arg, 0);
+      msb = p + 1;
+   }
+   res.exponent() = static_cast<Exponent>(top - msb + p - 1);
+   copy_and_round(res, arg);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void set_special_value(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Exponent e, bool s)
+{
+   res.bits() = limb_type(0);
+   res.exponent() = e;
+   res.sign() = s;
+}
+
+//
+// res = arg rounded to the precision of res, which is left unchanged:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void round_to_precision(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &arg)
+{
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   if(arg.exponent() > float_type::max_exponent)
+      set_special_value(res, arg.exponent(), arg.sign());
+   else if(&res != &arg)
+   {
+      typename float_type::rep_type m(arg.bits());
+      res.sign() = arg.sign();
+      copy_and_round_scaled(res, m, static_cast<boost::intmax_t>(arg.exponent()) - static_cast<boost::intmax_t>(arg.precision_bits() - 1));
+   }
+}
+
+//
+// res = (-1)^sx * x * 2^ex + (-1)^sy * y * 2^ey for non-zero x and y, rounded once.  A term lying
+// wholly below both the rounding position and the least significant bit of the other can only
+// decide the direction of rounding, so it is replaced by a single bit below both:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class Int>
+inline void do_eval_add_scaled(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &x, boost::intmax_t ex, bool sx, Int &y, boost::intmax_t ey, bool sy)
+{
+   using default_ops::eval_msb;
+   using default_ops::eval_left_shift;
+   using default_ops::eval_add;
+   using default_ops::eval_subtract;
+   using default_ops::eval_get_sign;
+
+   const boost::intmax_t p = res.precision_bits();
+   boost::intmax_t tx = ex + static_cast<boost::intmax_t>(eval_msb(x));
+   boost::intmax_t ty = ey + static_cast<boost::intmax_t>(eval_msb(y));
+   if(tx < ty)
+   {
+      x.swap(y);
+      std::swap(ex, ey);
+      std::swap(sx, sy);
+      std::swap(tx, ty);
+   }
+   const boost::intmax_t cutoff = (std::min)(ex, tx - p - 3);
+   if(ty < cutoff)
+   {
+      y = limb_type(1u);
+      ey = cutoff - 1;
+   }
+   const boost::intmax_t e = (std::min)(ex, ey);
+   if(ex != e)
+      eval_left_shift(x, static_cast<unsigned>(ex - e));
+   if(ey != e)
+      eval_left_shift(y, static_cast<unsigned>(ey - e));
+   bool s = sx;
+   if(sx == sy)
+      eval_add(x, y);
+   else
+   {
+      eval_subtract(x, y);
+      if(eval_get_sign(x) < 0)
+      {
+         x.negate();
+         s = sy;
+      }
+   }
+   res.sign() = s;
+   copy_and_round_scaled(res, x, e);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void do_eval_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b, bool negate_b)
+{
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   const bool sa = a.sign();
+   const bool sb = b.sign() != negate_b;
+   if((a.exponent() == float_type::exponent_nan) || (b.exponent() == float_type::exponent_nan))
+      set_special_value(res, float_type::exponent_nan, false);
+   else if(a.exponent() == float_type::exponent_infinity)
+   {
+      if((b.exponent() == float_type::exponent_infinity) && (sa != sb))
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_infinity, sa);
+   }
+   else if(b.exponent() == float_type::exponent_infinity)
+      set_special_value(res, float_type::exponent_infinity, sb);
+   else if(a.exponent() == float_type::exponent_zero)
+   {
+      if(b.exponent() == float_type::exponent_zero)
+         set_special_value(res, float_type::exponent_zero, sa && sb);
+      else
+      {
+         round_to_precision(res, b);
+         res.sign() = sb;
+      }
+   }
+   else if(b.exponent() == float_type::exponent_zero)
+      round_to_precision(res, a);
+   else
+   {
+      typename float_type::rep_type x(a.bits()), y(b.bits());
+      do_eval_add_scaled(res,
+         x, static_cast<boost::intmax_t>(a.exponent()) - static_cast<boost::intmax_t>(a.precision_bits() - 1), sa,
+         y, static_cast<boost::intmax_t>(b.exponent()) - static_cast<boost::intmax_t>(b.precision_bits() - 1), sb);
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_add(res, a, b, false);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a)
+{
+   do_eval_add(res, res, a, false);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_subtract(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_add(res, a, b, true);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_subtract(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a)
+{
+   do_eval_add(res, res, a, true);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   using default_ops::eval_multiply;
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   const bool s = a.sign() != b.sign();
+   if((a.exponent() == float_type::exponent_nan) || (b.exponent() == float_type::exponent_nan))
+      set_special_value(res, float_type::exponent_nan, false);
+   else if((a.exponent() == float_type::exponent_infinity) || (b.exponent() == float_type::exponent_infinity))
+   {
+      if((a.exponent() == float_type::exponent_zero) || (b.exponent() == float_type::exponent_zero))
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_infinity, s);
+   }
+   else if((a.exponent() == float_type::exponent_zero) || (b.exponent() == float_type::exponent_zero))
+      set_special_value(res, float_type::exponent_zero, s);
+   else
+   {
+      typename float_type::rep_type x;
+      eval_multiply(x, a.bits(), b.bits());
+      const boost::intmax_t lsb = static_cast<boost::intmax_t>(a.exponent()) - static_cast<boost::intmax_t>(a.precision_bits() - 1)
+         + static_cast<boost::intmax_t>(b.exponent()) - static_cast<boost::intmax_t>(b.precision_bits() - 1);
+      res.sign() = s;
+      copy_and_round_scaled(res, x, lsb);
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a)
+{
+   eval_multiply(res, res, a);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class U>
+inline typename enable_if_c<is_unsigned<U>::value>::type eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const U &b)
+{
+   using default_ops::eval_multiply;
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   typedef typename boost::multiprecision::detail::canonical<U, typename float_type::rep_type>::type canon_ui_type;
+   if(a.exponent() == float_type::exponent_nan)
+      set_special_value(res, float_type::exponent_nan, false);
+   else if(a.exponent() == float_type::exponent_infinity)
+   {
+      if(b == 0)
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_infinity, a.sign());
+   }
+   else if((a.exponent() == float_type::exponent_zero) || (b == 0))
+      set_special_value(res, float_type::exponent_zero, a.sign());
+   else
+   {
+      typename float_type::rep_type x;
+      eval_multiply(x, a.bits(), static_cast<canon_ui_type>(b));
+      const boost::intmax_t lsb = static_cast<boost::intmax_t>(a.exponent()) - static_cast<boost::intmax_t>(a.precision_bits() - 1);
+      res.sign() = a.sign();
+      copy_and_round_scaled(res, x, lsb);
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class U>
+inline typename enable_if_c<is_unsigned<U>::value>::type eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const U &b)
+{
+   eval_multiply(res, res, b);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class S>
+inline typename enable_if_c<is_signed<S>::value>::type eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const S &b)
+{
+   typedef typename make_unsigned<S>::type ui_type;
+   eval_multiply(res, a, static_cast<ui_type>(boost::multiprecision::detail::unsigned_abs(b)));
+   if(b < 0)
+      res.negate();
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class S>
+inline typename enable_if_c<is_signed<S>::value>::type eval_multiply(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const S &b)
+{
+   eval_multiply(res, res, b);
+}
+
+//
+// res = (-1)^s * (x * 2^ex) / (y * 2^ey): x is scaled up so the quotient has at least p + 2 bits,
+// and a non-zero remainder becomes the sticky bit:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class Int>
+inline void do_eval_divide_scaled(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, Int &x, boost::intmax_t ex, const Int &y, boost::intmax_t ey, bool s)
+{
+   using default_ops::eval_msb;
+   using default_ops::eval_left_shift;
+   using default_ops::eval_qr;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_bit_set;
+
+   const boost::intmax_t shift = static_cast<boost::intmax_t>(res.precision_bits()) + 2 + static_cast<boost::intmax_t>(eval_msb(y)) - static_cast<boost::intmax_t>(eval_msb(x));
+   if(shift > 0)
+   {
+      eval_left_shift(x, static_cast<unsigned>(shift));
+      ex -= shift;
+   }
+   Int q, r;
+   eval_qr(x, y, q, r);
+   if(!eval_is_zero(r))
+      eval_bit_set(q, 0);
+   res.sign() = s;
+   copy_and_round_scaled(res, q, ex - ey);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &u, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &v)
+{
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   const bool s = u.sign() != v.sign();
+   if((u.exponent() == float_type::exponent_nan) || (v.exponent() == float_type::exponent_nan))
+      set_special_value(res, float_type::exponent_nan, false);
+   else if(u.exponent() == float_type::exponent_infinity)
+   {
+      if(v.exponent() == float_type::exponent_infinity)
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_infinity, s);
+   }
+   else if(u.exponent() == float_type::exponent_zero)
+   {
+      if(v.exponent() == float_type::exponent_zero)
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_zero, s);
+   }
+   else if(v.exponent() == float_type::exponent_infinity)
+      set_special_value(res, float_type::exponent_zero, s);
+   else if(v.exponent() == float_type::exponent_zero)
+      set_special_value(res, float_type::exponent_infinity, s);
+   else
+   {
+      typename float_type::rep_type x(u.bits()), y(v.bits());
+      do_eval_divide_scaled(res,
+         x, static_cast<boost::intmax_t>(u.exponent()) - static_cast<boost::intmax_t>(u.precision_bits() - 1),
+         y, static_cast<boost::intmax_t>(v.exponent()) - static_cast<boost::intmax_t>(v.precision_bits() - 1), s);
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &arg)
+{
+   eval_divide(res, res, arg);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class U>
+inline typename enable_if_c<is_unsigned<U>::value>::type eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &u, const U &v)
+{
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   typedef typename boost::multiprecision::detail::canonical<U, typename float_type::rep_type>::type canon_ui_type;
+   if(u.exponent() == float_type::exponent_nan)
+      set_special_value(res, float_type::exponent_nan, false);
+   else if(u.exponent() == float_type::exponent_infinity)
+      set_special_value(res, float_type::exponent_infinity, u.sign());
+   else if(u.exponent() == float_type::exponent_zero)
+   {
+      if(v == 0)
+         set_special_value(res, float_type::exponent_nan, false);
+      else
+         set_special_value(res, float_type::exponent_zero, u.sign());
+   }
+   else if(v == 0)
+      set_special_value(res, float_type::exponent_infinity, u.sign());
+   else
+   {
+      typename float_type::rep_type x(u.bits()), y;
+      y = static_cast<canon_ui_type>(v);
+      do_eval_divide_scaled(res, x, static_cast<boost::intmax_t>(u.exponent()) - static_cast<boost::intmax_t>(u.precision_bits() - 1), y, 0, u.sign());
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class U>
+inline typename enable_if_c<is_unsigned<U>::value>::type eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const U &v)
+{
+   eval_divide(res, res, v);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class S>
+inline typename enable_if_c<is_signed<S>::value>::type eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &u, const S &v)
+{
+   typedef typename make_unsigned<S>::type ui_type;
+   eval_divide(res, u, static_cast<ui_type>(boost::multiprecision::detail::unsigned_abs(v)));
+   if(v < 0)
+      res.negate();
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, class S>
+inline typename enable_if_c<is_signed<S>::value>::type eval_divide(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const S &v)
+{
+   eval_divide(res, res, v);
+}
+
+//
+// Fused multiply-add: the product is exact, so there is a single rounding in do_eval_add_scaled.
+// Special values and zeros go through the separate operations, where the product is exact anyway:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void do_eval_multiply_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &c, bool negate_product, bool negate_c)
+{
+   using default_ops::eval_multiply;
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+   if((a.exponent() > float_type::max_exponent) || (b.exponent() > float_type::max_exponent) || (c.exponent() > float_type::max_exponent))
+   {
+      if((c.exponent() == float_type::exponent_zero) && (a.exponent() <= float_type::max_exponent) && (b.exponent() <= float_type::max_exponent))
+      {
+         eval_multiply(res, a, b);
+         if(negate_product)
+            res.negate();
+      }
+      else
+      {
+         float_type t;
+         eval_multiply(t, a, b);
+         if(negate_product)
+            t.negate();
+         do_eval_add(res, t, c, negate_c);
+      }
+   }
+   else
+   {
+      typename float_type::rep_type x, y(c.bits());
+      eval_multiply(x, a.bits(), b.bits());
+      const boost::intmax_t ex = static_cast<boost::intmax_t>(a.exponent()) - static_cast<boost::intmax_t>(a.precision_bits() - 1)
+         + static_cast<boost::intmax_t>(b.exponent()) - static_cast<boost::intmax_t>(b.precision_bits() - 1);
+      const boost::intmax_t ey = static_cast<boost::intmax_t>(c.exponent()) - static_cast<boost::intmax_t>(c.precision_bits() - 1);
+      do_eval_add_scaled(res, x, ex, (a.sign() != b.sign()) != negate_product, y, ey, c.sign() != negate_c);
+   }
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_multiply_add(res, a, b, res, false, false);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_add(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &c)
+{
+   do_eval_multiply_add(res, a, b, c, false, false);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_subtract(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   do_eval_multiply_add(res, a, b, res, true, false);
+}
+
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_multiply_subtract(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &c)
+{
+   do_eval_multiply_add(res, a, b, c, false, true);
+}
+
+//
+// The integer square root of the mantissa, scaled so the root has at least p + 2 bits and the
+// exponent is even, with a non-zero remainder as the sticky bit:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline void eval_sqrt(cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &res, const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &arg)
+{
+   using default_ops::eval_integer_sqrt;
+   using default_ops::eval_msb;
+   using default_ops::eval_left_shift;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_bit_set;
+   typedef cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> float_type;
+
+   switch(arg.exponent())
+   {
+   case float_type::exponent_zero:
+      set_special_value(res, float_type::exponent_zero, arg.sign());
+      return;
+   case float_type::exponent_nan:
+      errno = EDOM;
+      set_special_value(res, float_type::exponent_nan, false);
+      return;
+   case float_type::exponent_infinity:
+      if(arg.sign())
+      {
+         errno = EDOM;
+         set_special_value(res, float_type::exponent_nan, false);
+      }
+      else
+         set_special_value(res, float_type::exponent_infinity, false);
+      return;
+   }
+   if(arg.sign())
+   {
+      errno = EDOM;
+      set_special_value(res, float_type::exponent_nan, false);
+      return;
+   }
+   typename float_type::rep_type t(arg.bits()), s, r;
+   boost::intmax_t lsb = static_cast<boost::intmax_t>(arg.exponent()) - static_cast<boost::intmax_t>(arg.precision_bits() - 1);
+   boost::intmax_t shift = 2 * static_cast<boost::intmax_t>(res.precision_bits()) + 4 - static_cast<boost::intmax_t>(eval_msb(t));
+   if(shift < 0)
+      shift = 0;
+   if((lsb - shift) & 1)
+      ++shift;
+   eval_left_shift(t, static_cast<unsigned>(shift));
+   lsb -= shift;
+   eval_integer_sqrt(s, r, t);
+   if(!eval_is_zero(r))
+      eval_bit_set(s, 0);
+   res.sign() = false;
+   copy_and_round_scaled(res, s, lsb / 2);
+}
+
+//
+// Matches the non-const second argument of the fixed precision version, so as to be more specialized:
+//
+template <digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+inline bool eval_eq(const cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &a, cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> &b)
+{
+   if(a.exponent() == cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>::exponent_nan)
+      return false;
+   return a.compare(b) == 0;
+}
+
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace backends
+
+namespace detail{
+
+template <backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+struct is_variable_precision<backends::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> > : public true_type {};
+
+template <backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, expression_template_option ExpressionTemplates>
+struct digits2<number<backends::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >
+{
+   static long value()
+   {
+      return multiprecision::detail::digits10_2_2(backends::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>::default_precision());
+   }
+};
+
+} // namespace detail
+
+}} // namespaces
+
+namespace std{
+
+//
+// numeric_limits for the variable precision type, which are all at the current default precision:
+//
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+class numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >
+{
+   typedef boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> number_type;
+   typedef boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE> backend_type;
+public:
+   BOOST_STATIC_CONSTEXPR bool is_specialized = false;
+   static number_type (min)()
+   {
+      number_type value(1);
+      value.backend().exponent() = backend_type::min_exponent;
+      return value;
+   }
+   static number_type (max)()
+   {
+      using boost::multiprecision::default_ops::eval_left_shift;
+      using boost::multiprecision::default_ops::eval_decrement;
+      number_type value(1);
+      eval_left_shift(value.backend().bits(), 1);
+      eval_decrement(value.backend().bits());
+      value.backend().exponent() = backend_type::max_exponent;
+      return value;
+   }
+   static number_type lowest()
+   {
+      return -(max)();
+   }
+   BOOST_STATIC_CONSTEXPR int digits = INT_MAX;
+   BOOST_STATIC_CONSTEXPR int digits10 = INT_MAX;
+   BOOST_STATIC_CONSTEXPR int max_digits10 = INT_MAX;
+   BOOST_STATIC_CONSTEXPR bool is_signed = true;
+   BOOST_STATIC_CONSTEXPR bool is_integer = false;
+   BOOST_STATIC_CONSTEXPR bool is_exact = false;
+   BOOST_STATIC_CONSTEXPR int radix = 2;
+   static number_type epsilon()
+   {
+      number_type value(1);
+      value.backend().exponent() = 1 - static_cast<Exponent>(value.backend().precision_bits());
+      return value;
+   }
+   static number_type round_error()
+   {
+      number_type value(1);
+      value.backend().exponent() = -1;
+      return value;
+   }
+   BOOST_STATIC_CONSTEXPR Exponent min_exponent = backend_type::min_exponent;
+   BOOST_STATIC_CONSTEXPR Exponent min_exponent10 = (min_exponent / 1000) * 301L;
+   BOOST_STATIC_CONSTEXPR Exponent max_exponent = backend_type::max_exponent;
+   BOOST_STATIC_CONSTEXPR Exponent max_exponent10 = (max_exponent / 1000) * 301L;
+   BOOST_STATIC_CONSTEXPR bool has_infinity = true;
+   BOOST_STATIC_CONSTEXPR bool has_quiet_NaN = true;
+   BOOST_STATIC_CONSTEXPR bool has_signaling_NaN = false;
+   BOOST_STATIC_CONSTEXPR float_denorm_style has_denorm = denorm_absent;
+   BOOST_STATIC_CONSTEXPR bool has_denorm_loss = false;
+   static number_type infinity()
+   {
+      number_type value;
+      value.backend().exponent() = backend_type::exponent_infinity;
+      return value;
+   }
+   static number_type quiet_NaN()
+   {
+      number_type value;
+      value.backend().exponent() = backend_type::exponent_nan;
+      return value;
+   }
+   static number_type signaling_NaN() { return number_type(0); }
+   static number_type denorm_min() { return number_type(0); }
+   BOOST_STATIC_CONSTEXPR bool is_iec559 = false;
+   BOOST_STATIC_CONSTEXPR bool is_bounded = true;
+   BOOST_STATIC_CONSTEXPR bool is_modulo = false;
+   BOOST_STATIC_CONSTEXPR bool traps = true;
+   BOOST_STATIC_CONSTEXPR bool tinyness_before = false;
+   BOOST_STATIC_CONSTEXPR float_round_style round_style = round_to_nearest;
+};
+
+#ifndef BOOST_NO_INCLASS_MEMBER_INITIALIZATION
+
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST int numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::digits;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST int numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::digits10;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST int numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::max_digits10;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_signed;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_integer;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_exact;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST int numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::radix;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST Exponent numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::min_exponent;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST Exponent numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::min_exponent10;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST Exponent numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::max_exponent;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST Exponent numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::max_exponent10;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::has_infinity;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::has_quiet_NaN;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::has_signaling_NaN;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST float_denorm_style numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::has_denorm;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::has_denorm_loss;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_iec559;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_bounded;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::is_modulo;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::traps;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST bool numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::tinyness_before;
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE, boost::multiprecision::expression_template_option ExpressionTemplates>
+BOOST_CONSTEXPR_OR_CONST float_round_style numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinE, MaxE>, ExpressionTemplates> >::round_style;
+
+#endif
+
+} // namespace std
+
+namespace boost{ namespace math{ namespace tools{
+
+template <>
+inline int digits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on> >()
+#ifdef BOOST_MATH_NOEXCEPT
+   BOOST_NOEXCEPT
+#endif
+{
+   return multiprecision::detail::digits10_2_2(boost::multiprecision::cpp_bin_float<0>::default_precision());
+}
+template <>
+inline int digits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >()
+#ifdef BOOST_MATH_NOEXCEPT
+   BOOST_NOEXCEPT
+#endif
+{
+   return multiprecision::detail::digits10_2_2(boost::multiprecision::cpp_bin_float<0>::default_precision());
+}
+
+template <>
+inline boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on>
+   max_value<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on> >()
+{
+   return (std::numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on> >::max)();
+}
+template <>
+inline boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on>
+   min_value<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on> >()
+{
+   return (std::numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_on> >::min)();
+}
+template <>
+inline boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off>
+   max_value<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >()
+{
+   return (std::numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >::max)();
+}
+template <>
+inline boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off>
+   min_value<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >()
+{
+   return (std::numeric_limits<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >::min)();
+}
+
+}}} // namespaces
+
+#endif
@@ -19,6 +19,7 @@
 #include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 #include <limits>
+#include <vector>
 #ifndef BOOST_NO_CXX11_HDR_ARRAY
 #include <array>
 #else
@@ -63,6 +64,478 @@ struct number_category<backends::cpp_dec_float<Digits10, ExponentType, Allocator
 
 namespace backends{
 
+//
+// Sub-quadratic multiplication of the base 10^8 limbs.
+//
+// Full products of at least the following limb counts are formed with Karatsuba
+// and with a number theoretic transform respectively, both may be tuned by defining
+// the macros before including cpp_dec_float.hpp.  cpp_dec_float's own multiplication
+// only forms the top half of the product, which is quicker than any full product until
+// the transform takes over, so it hands over at the NTT cutoff or at 1800 limbs,
+// whichever is less:
+//
+#ifndef BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF
+#define BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF 64
+#endif
+#ifndef BOOST_MP_CPP_DEC_FLOAT_NTT_CUTOFF
+#define BOOST_MP_CPP_DEC_FLOAT_NTT_CUTOFF 1600
+#endif
+//
+// Columns of the schoolbook product are summed in 64 bits, which is exact for up to
+// FLOOR( (2^64 - 1) / (10^8 * 10^8) ) == 1844 terms, so the base case must stay below that:
+//
+BOOST_STATIC_ASSERT_MSG((BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF >= 8) && (BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF <= 1800), "BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF must be in the range [8, 1800].");
+//
+// Division uses schoolbook long division of the limbs below the following limb count,
+// and Newton iteration at and above it.  The two are about even at 250 decimal digits:
+//
+#ifndef BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF
+#define BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF 32
+#endif
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF >= 2, "BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF must be at least 2.");
+
+//
+// Constants such as one(), eps() and the table behind pow2() are function local statics, created
+// on first use.  Compilers which don't make those thread safe create them all before main instead,
+// as may any program by defining the following:
+//
+#if !defined(BOOST_MP_CPP_DEC_FLOAT_EAGER_INIT) && ((defined(BOOST_MSVC) && (BOOST_MSVC < 1900)) || (!defined(BOOST_MSVC) && !defined(__GNUC__) && (__cplusplus < 201103L)))
+#define BOOST_MP_CPP_DEC_FLOAT_EAGER_INIT
+#endif
+
+namespace detail{
+//
+// The routines below work on raw arrays of base 10^8 limbs held least significant
+// first (the reverse of cpp_dec_float's own order), none of the output arrays may
+// alias the inputs unless stated otherwise, and all temporaries come from a single
+// block of scratch storage allocated up front.
+//
+const boost::uint32_t dec_limb_base = 100000000u;
+//
+// r[0, an) = a[0, an) + b[0, bn), an >= bn, returns the carry, r may alias a or b:
+//
+inline boost::uint32_t dec_add_limbs(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn)
+{
+   BOOST_ASSERT(an >= bn);
+   boost::uint32_t carry = 0;
+   for(unsigned i = 0; i < an; ++i)
+   {
+      boost::uint32_t s = a[i] + (i < bn ? b[i] : 0u) + carry;
+      carry = s >= dec_limb_base;
+      r[i] = carry ? s - dec_limb_base : s;
+   }
+   return carry;
+}
+//
+// r[0, an) = a[0, an) - b[0, bn), an >= bn, returns the borrow, r may alias a or b:
+//
+inline boost::uint32_t dec_subtract_limbs(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn)
+{
+   BOOST_ASSERT(an >= bn);
+   boost::uint32_t borrow = 0;
+   for(unsigned i = 0; i < an; ++i)
+   {
+      boost::uint32_t t = (i < bn ? b[i] : 0u) + borrow;
+      borrow = a[i] < t;
+      r[i] = borrow ? a[i] + (dec_limb_base - t) : a[i] - t;
+   }
+   return borrow;
+}
+//
+// r[0, an) = |a[0, an) - b[0, bn)|, an >= bn, returns true if a < b, r may alias a or b:
+//
+inline bool dec_abs_difference_limbs(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn)
+{
+   BOOST_ASSERT(an >= bn);
+   unsigned n = an;
+   while((n > bn) && !a[n - 1])
+      --n;
+   if(n == bn)
+   {
+      while(n && (a[n - 1] == b[n - 1]))
+         --n;
+      if(n && (a[n - 1] < b[n - 1]))
+      {
+         dec_subtract_limbs(r, b, bn, a, bn);
+         std::fill(r + bn, r + an, static_cast<boost::uint32_t>(0u));
+         return true;
+      }
+   }
+   dec_subtract_limbs(r, a, an, b, bn);
+   return false;
+}
+//
+// Adds c[0, cn) into r[0, rn), the caller guarantees that the result fits in rn limbs:
+//
+inline void dec_add_limbs_into(boost::uint32_t* r, unsigned rn, const boost::uint32_t* c, unsigned cn)
+{
+   while(cn && !c[cn - 1])
+      --cn;
+   BOOST_ASSERT(cn <= rn);
+   boost::uint32_t carry = dec_add_limbs(r, r, rn, c, cn);
+   BOOST_ASSERT(carry == 0);
+   (void)carry;
+}
+//
+// a[0, n) *= m for m < 10^8, returns the carry:
+//
+inline boost::uint32_t dec_multiply_limbs_1(boost::uint32_t* a, unsigned n, boost::uint32_t m)
+{
+   boost::uint64_t carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      boost::uint64_t t = static_cast<boost::uint64_t>(a[i]) * m + carry;
+      carry = t / dec_limb_base;
+      a[i] = static_cast<boost::uint32_t>(t - carry * dec_limb_base);
+   }
+   return static_cast<boost::uint32_t>(carry);
+}
+//
+// Schoolbook multiplication r[0, an + bn) = a * b, an >= bn, the base case for the recursive
+// routines.  Each column is summed in 64 bits and normalised once:
+//
+inline void dec_multiply_schoolbook(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn)
+{
+   BOOST_ASSERT((an >= bn) && bn && (bn <= 1800));
+   boost::uint64_t carry = 0;
+   for(unsigned k = 0; k + 1 < an + bn; ++k)
+   {
+      unsigned first = k < bn ? 0 : k - bn + 1;
+      unsigned last = (std::min)(k, an - 1);
+      boost::uint64_t sum = carry;
+      for(unsigned i = first; i <= last; ++i)
+         sum += static_cast<boost::uint64_t>(a[i]) * b[k - i];
+      carry = sum / dec_limb_base;
+      r[k] = static_cast<boost::uint32_t>(sum - carry * dec_limb_base);
+   }
+   r[an + bn - 1] = static_cast<boost::uint32_t>(carry);
+}
+//
+// Number theoretic transform multiplication for very large values: each limb is one
+// coefficient, the cyclic convolution is computed modulo three primes of the form
+// k * 2^n + 1 below 2^31, and the product recovered by the Chinese Remainder Theorem.
+// The product of the primes is ~2^85, far more than the largest coefficient, which
+// is less than min(an, bn) * 10^16.  The transforms are limited to 2^24 points:
+//
+inline boost::uint32_t dec_ntt_prime(unsigned i)
+{
+   static const boost::uint32_t values[3] = { 469762049u, 167772161u, 754974721u };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+inline boost::uint32_t dec_ntt_generator(unsigned i)
+{
+   static const boost::uint32_t values[3] = { 3, 3, 11 };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+inline bool dec_ntt_multiply_supported(unsigned an, unsigned bn)
+{
+   return an + bn <= (1u << 24);
+}
+//
+// Arithmetic modulo one of the primes above, multiply() is the Montgomery product
+// a * b / 2^32 so values taking part in the transforms are held in Montgomery form,
+// and a Montgomery value multiplied by a normal one yields a normal one:
+//
+class dec_ntt_modulus
+{
+   boost::uint32_t m_p, m_pinv, m_one, m_r2;
+public:
+   explicit dec_ntt_modulus(boost::uint32_t p) : m_p(p)
+   {
+      // Newton iteration for 1/p mod 2^32, p is its own inverse to 3 bits
+      // and each step doubles the number of correct bits:
+      boost::uint32_t inv = p;
+      for(unsigned i = 0; i < 4; ++i)
+         inv *= 2 - p * inv;
+      m_pinv = 0 - inv;
+      m_one = static_cast<boost::uint32_t>((static_cast<boost::uint64_t>(1u) << 32) % p);
+      m_r2 = static_cast<boost::uint32_t>(static_cast<boost::uint64_t>(m_one) * m_one % p);
+   }
+   boost::uint32_t modulus()const { return m_p; }
+   boost::uint32_t one()const { return m_one; }
+   boost::uint32_t multiply(boost::uint32_t a, boost::uint32_t b)const
+   {
+      // Valid for any a * b < p * 2^32:
+      boost::uint64_t t = static_cast<boost::uint64_t>(a) * b;
+      boost::uint32_t m = static_cast<boost::uint32_t>(t) * m_pinv;
+      t = (t + static_cast<boost::uint64_t>(m) * m_p) >> 32;
+      return static_cast<boost::uint32_t>(t >= m_p ? t - m_p : t);
+   }
+   boost::uint32_t add(boost::uint32_t a, boost::uint32_t b)const
+   {
+      boost::uint32_t s = a + b;
+      return s >= m_p ? s - m_p : s;
+   }
+   boost::uint32_t subtract(boost::uint32_t a, boost::uint32_t b)const
+   {
+      return a >= b ? a - b : a + (m_p - b);
+   }
+   boost::uint32_t to_montgomery(boost::uint32_t a)const
+   {
+      return multiply(a, m_r2);
+   }
+   boost::uint32_t power(boost::uint32_t a, boost::uint32_t e)const
+   {
+      boost::uint32_t result = m_one;
+      while(e)
+      {
+         if(e & 1u)
+            result = multiply(result, a);
+         a = multiply(a, a);
+         e >>= 1;
+      }
+      return result;
+   }
+};
+//
+// Transform length for a product with n coefficients, and the scratch space needed by
+// dec_multiply_ntt for operands of up to n limbs each:
+//
+inline unsigned dec_ntt_transform_length(unsigned n)
+{
+   unsigned result = 1;
+   while(result < n)
+      result <<= 1;
+   return result;
+}
+inline unsigned dec_ntt_scratch_size(unsigned n)
+{
+   unsigned len = dec_ntt_transform_length(2 * n - 1);
+   return 6 * n + len / 2 + 2 * len;
+}
+//
+// Forward transform by decimation in frequency, x is left in bit reversed order, and
+// tw[0, len / 2) holds the powers of the len'th root of unity:
+//
+inline void dec_ntt_forward(boost::uint32_t* x, unsigned len, const boost::uint32_t* tw, const dec_ntt_modulus& mod)
+{
+   for(unsigned m = len / 2, stride = 1; m; m >>= 1, stride <<= 1)
+   {
+      for(unsigned s = 0; s < len; s += 2 * m)
+      {
+         for(unsigned j = 0; j < m; ++j)
+         {
+            boost::uint32_t u = x[s + j];
+            boost::uint32_t v = x[s + j + m];
+            x[s + j] = mod.add(u, v);
+            x[s + j + m] = mod.multiply(mod.subtract(u, v), tw[j * stride]);
+         }
+      }
+   }
+}
+//
+// Inverse (unscaled) transform by decimation in time, takes bit reversed input and
+// produces natural order output.  The inverse roots come from the same table since
+// w^-j == -w^(len/2 - j):
+//
+inline void dec_ntt_inverse(boost::uint32_t* x, unsigned len, const boost::uint32_t* tw, const dec_ntt_modulus& mod)
+{
+   for(unsigned m = 1, stride = len / 2; m < len; m <<= 1, stride >>= 1)
+   {
+      for(unsigned s = 0; s < len; s += 2 * m)
+      {
+         boost::uint32_t u = x[s];
+         boost::uint32_t v = x[s + m];
+         x[s] = mod.add(u, v);
+         x[s + m] = mod.subtract(u, v);
+         for(unsigned j = 1; j < m; ++j)
+         {
+            u = x[s + j];
+            v = mod.multiply(x[s + j + m], mod.modulus() - tw[len / 2 - j * stride]);
+            x[s + j] = mod.add(u, v);
+            x[s + j + m] = mod.subtract(u, v);
+         }
+      }
+   }
+}
+//
+// r[0, an + bn) = a * b, scratch must have room for dec_ntt_scratch_size(max(an, bn)) limbs:
+//
+inline void dec_multiply_ntt(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn, boost::uint32_t* scratch)
+{
+   BOOST_ASSERT(dec_ntt_multiply_supported(an, bn));
+   unsigned n = an + bn - 1;
+   unsigned len = dec_ntt_transform_length(n);
+   boost::uint32_t* residues = scratch;
+   boost::uint32_t* tw = residues + 3 * n;
+   boost::uint32_t* x = tw + len / 2;
+   boost::uint32_t* y = x + len;
+   bool square = (a == b) && (an == bn);
+
+   for(unsigned k = 0; k < 3; ++k)
+   {
+      dec_ntt_modulus mod(dec_ntt_prime(k));
+      boost::uint32_t p = mod.modulus();
+      boost::uint32_t w = mod.power(mod.to_montgomery(dec_ntt_generator(k)), (p - 1) / len);
+      tw[0] = mod.one();
+      for(unsigned i = 1; i < len / 2; ++i)
+         tw[i] = mod.multiply(tw[i - 1], w);
+
+      // Every limb is already less than each of the primes:
+      for(unsigned i = 0; i < an; ++i)
+         x[i] = mod.to_montgomery(a[i]);
+      std::fill(x + an, x + len, static_cast<boost::uint32_t>(0));
+      dec_ntt_forward(x, len, tw, mod);
+      if(square)
+      {
+         for(unsigned i = 0; i < len; ++i)
+            x[i] = mod.multiply(x[i], x[i]);
+      }
+      else
+      {
+         for(unsigned i = 0; i < bn; ++i)
+            y[i] = mod.to_montgomery(b[i]);
+         std::fill(y + bn, y + len, static_cast<boost::uint32_t>(0));
+         dec_ntt_forward(y, len, tw, mod);
+         for(unsigned i = 0; i < len; ++i)
+            x[i] = mod.multiply(x[i], y[i]);
+      }
+      dec_ntt_inverse(x, len, tw, mod);
+      //
+      // Scale by 1/len which is p - (p - 1) / len, this also takes us out of Montgomery form:
+      //
+      boost::uint32_t scale = p - (p - 1) / len;
+      for(unsigned i = 0; i < n; ++i)
+         residues[k * n + i] = mod.multiply(x[i], scale);
+   }
+   //
+   // Garner's algorithm: each coefficient is v1 + p1 * t with t = v2 + p2 * v3 and vi < pi.
+   // Splitting t = th * 10^8 + tl gives the coefficient as hi * 10^8 + lo with both parts
+   // in 64 bits, which is then added into the result with a 64-bit carry:
+   //
+   dec_ntt_modulus mod2(dec_ntt_prime(1)), mod3(dec_ntt_prime(2));
+   boost::uint32_t p1 = dec_ntt_prime(0), p2 = dec_ntt_prime(1), p3 = dec_ntt_prime(2);
+   boost::uint32_t inv_p1_mod_p2 = mod2.power(mod2.to_montgomery(p1 % p2), p2 - 2);
+   boost::uint32_t inv_p1_mod_p3 = mod3.power(mod3.to_montgomery(p1 % p3), p3 - 2);
+   boost::uint32_t inv_p2_mod_p3 = mod3.power(mod3.to_montgomery(p2 % p3), p3 - 2);
+   boost::uint64_t carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      boost::uint32_t v1 = residues[i];
+      boost::uint32_t v2 = mod2.multiply(mod2.subtract(residues[n + i], v1 % p2), inv_p1_mod_p2);
+      boost::uint32_t v3 = mod3.multiply(mod3.subtract(residues[2 * n + i], v1 % p3), inv_p1_mod_p3);
+      v3 = mod3.multiply(mod3.subtract(v3, v2 % p3), inv_p2_mod_p3);
+
+      boost::uint64_t t = static_cast<boost::uint64_t>(v3) * p2 + v2;
+      boost::uint64_t th = t / dec_limb_base;
+      boost::uint64_t lo = (t - th * dec_limb_base) * p1 + v1;
+      boost::uint64_t hi = th * p1 + lo / dec_limb_base;
+      lo = lo % dec_limb_base + carry % dec_limb_base;
+      carry = hi + carry / dec_limb_base + lo / dec_limb_base;
+      r[i] = static_cast<boost::uint32_t>(lo % dec_limb_base);
+   }
+   BOOST_ASSERT(carry < dec_limb_base);
+   r[n] = static_cast<boost::uint32_t>(carry);
+}
+//
+// Returns the amount of scratch storage (in limbs) required to multiply two values of
+// n limbs each, a (tight enough) upper bound on the storage used by every branch of
+// dec_multiply_recursive below:
+//
+inline unsigned dec_multiply_scratch_size(unsigned n)
+{
+   unsigned result = 0;
+   unsigned total = 0;
+   while(n >= BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF)
+   {
+      if(n >= BOOST_MP_CPP_DEC_FLOAT_NTT_CUTOFF)
+         result = (std::max)(result, total + dec_ntt_scratch_size(n));
+      total += 5 * n + 32;
+      n = n / 2 + 2;
+   }
+   return (std::max)(result, total);
+}
+
+inline void dec_multiply_recursive(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn, boost::uint32_t* scratch);
+
+//
+// Karatsuba multiplication, requires an >= bn > ceil(an / 2).  Uses the subtractive
+// form so that no temporary grows beyond its half-size operands:
+//
+// a * b = z2 * B^2h + (z2 + z0 + (a0 - a1)(b1 - b0)) * B^h + z0
+//
+inline void dec_multiply_karatsuba(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn, boost::uint32_t* scratch)
+{
+   unsigned h = (an + 1) / 2;
+   BOOST_ASSERT((an >= bn) && (bn > h));
+   const boost::uint32_t* a1 = a + h;
+   const boost::uint32_t* b1 = b + h;
+   unsigned a1n = an - h;
+   unsigned b1n = bn - h;
+
+   boost::uint32_t* t = scratch;
+   boost::uint32_t* u = t + h;
+   boost::uint32_t* m = u + h;
+   boost::uint32_t* z1 = m + 2 * h;
+   boost::uint32_t* next = z1 + 2 * h + 1;
+   //
+   // z0 and z2 go straight into their final locations:
+   //
+   dec_multiply_recursive(r, a, h, b, h, next);
+   dec_multiply_recursive(r + 2 * h, a1, a1n, b1, b1n, next);
+   //
+   // (a0 - a1)(b1 - b0) is negative when exactly one of the differences is:
+   //
+   bool a_neg = dec_abs_difference_limbs(t, a, h, a1, a1n);
+   bool b_neg;
+   if((a == b) && (an == bn))
+   {
+      // Squaring, the middle product is -(a0 - a1)^2:
+      b_neg = !a_neg;
+      u = t;
+   }
+   else
+      b_neg = !dec_abs_difference_limbs(u, b, h, b1, b1n);
+   dec_multiply_recursive(m, t, h, u, h, next);
+
+   std::copy(r, r + 2 * h, z1);
+   z1[2 * h] = dec_add_limbs(z1, z1, 2 * h, r + 2 * h, a1n + b1n);
+   if(a_neg != b_neg)
+      dec_subtract_limbs(z1, z1, 2 * h + 1, m, 2 * h);
+   else
+      dec_add_limbs(z1, z1, 2 * h + 1, m, 2 * h);
+
+   dec_add_limbs_into(r + h, an + bn - h, z1, 2 * h + 1);
+}
+//
+// r[0, an + bn) = a * b for operands of similar size, picks the best algorithm for the
+// operand sizes, scratch must have room for dec_multiply_scratch_size(max(an, bn)) limbs.
+// Passing the same pointer and size for a and b selects the squaring variants:
+//
+inline void dec_multiply_recursive(boost::uint32_t* r, const boost::uint32_t* a, unsigned an, const boost::uint32_t* b, unsigned bn, boost::uint32_t* scratch)
+{
+   if(an < bn)
+   {
+      std::swap(a, b);
+      std::swap(an, bn);
+   }
+   if(bn < BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF)
+      dec_multiply_schoolbook(r, a, an, b, bn);
+   else if((bn >= BOOST_MP_CPP_DEC_FLOAT_NTT_CUTOFF) && dec_ntt_multiply_supported(an, bn))
+      dec_multiply_ntt(r, a, an, b, bn, scratch);
+   else
+      dec_multiply_karatsuba(r, a, an, b, bn, scratch);
+}
+//
+// Scratch storage for the above comes from the number's allocator, or std::allocator
+// when there is none:
+//
+template <class Allocator>
+struct dec_scratch_allocator
+{
+   typedef typename rebind<boost::uint32_t, Allocator>::type type;
+};
+template <>
+struct dec_scratch_allocator<void>
+{
+   typedef std::allocator<boost::uint32_t> type;
+};
+
+} // namespace detail
+
+
 template <unsigned Digits10, class ExponentType, class Allocator>
 class cpp_dec_float
 {
@@ -149,12 +622,13 @@ private:
       prec_elem(cpp_dec_float_elem_number) { }
 
       //
-      // Static data initializer:
+      // Static data initializer, does nothing unless BOOST_MP_CPP_DEC_FLOAT_EAGER_INIT is defined:
       //
       struct initializer
       {
          initializer()
          {
+#ifdef BOOST_MP_CPP_DEC_FLOAT_EAGER_INIT
              cpp_dec_float<Digits10, ExponentType, Allocator>::nan();
              cpp_dec_float<Digits10, ExponentType, Allocator>::inf();
             (cpp_dec_float<Digits10, ExponentType, Allocator>::min)();
@@ -172,6 +646,7 @@ private:
              cpp_dec_float<Digits10, ExponentType, Allocator>::ulong_long_max();
              cpp_dec_float<Digits10, ExponentType, Allocator>::eps();
              cpp_dec_float<Digits10, ExponentType, Allocator>::pow2(0);
+#endif
          }
          void do_nothing(){}
       };
@@ -300,14 +775,14 @@ public:
    static const cpp_dec_float& (max)()
    {
       init.do_nothing();
-      static cpp_dec_float val_max = std::string("1.0e" + boost::lexical_cast<std::string>(cpp_dec_float_max_exp10)).c_str();
+      static const cpp_dec_float val_max = power_of_ten(cpp_dec_float_max_exp10);
       return val_max;
    }
 
    static const cpp_dec_float& (min)()
    {
       init.do_nothing();
-      static cpp_dec_float val_min = std::string("1.0e" + boost::lexical_cast<std::string>(cpp_dec_float_min_exp10)).c_str();
+      static const cpp_dec_float val_min = power_of_ten(cpp_dec_float_min_exp10);
       return val_min;
    }
 
@@ -458,6 +933,8 @@ public:
    cpp_dec_float& operator*=(const cpp_dec_float& v);
    cpp_dec_float& operator/=(const cpp_dec_float& v);
 
+   cpp_dec_float& multiply_add(const cpp_dec_float& u, const cpp_dec_float& v, const bool b_subtract = false);
+
    cpp_dec_float& add_unsigned_long_long(const boost::ulong_long_type n)
    {
       cpp_dec_float t;
@@ -626,9 +1103,15 @@ private:
 
 
    static boost::uint32_t mul_loop_uv(boost::uint32_t* const u, const boost::uint32_t* const v, const boost::int32_t p);
+   static bool            div_loop_uv(boost::uint32_t* const u, const boost::uint32_t* const v, const boost::int32_t p);
    static boost::uint32_t mul_loop_n (boost::uint32_t* const u, boost::uint32_t n, const boost::int32_t p);
    static boost::uint32_t div_loop_n (boost::uint32_t* const u, boost::uint32_t n, const boost::int32_t p);
 
+   cpp_dec_float& calculate_inv(const boost::int32_t target_digits);
+   cpp_dec_float& div_newton(const cpp_dec_float& v, const boost::int32_t p);
+   static cpp_dec_float power_of_ten(const ExponentType e);
+   static boost::array<cpp_dec_float, 255u> pow2_table();
+
    bool rd_string(const char* const s);
 
    template <unsigned D, class ET, class A>
@@ -970,6 +1453,69 @@ cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, Expone
    return *this;
 }
 
+template <unsigned Digits10, class ExponentType, class Allocator>
+cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, ExponentType, Allocator>::multiply_add(const cpp_dec_float<Digits10, ExponentType, Allocator>& u, const cpp_dec_float<Digits10, ExponentType, Allocator>& v, const bool b_subtract)
+{
+   // Sets *this += u * v, or *this -= u * v, truncating only once: the full product of the
+   // limbs is added to *this at twice the precision, then the sum is cut back.  That only
+   // matters when *this cancels the leading limbs of the product, otherwise the truncated
+   // product is out by no more than the ordinary multiply and add, which are used instead.
+   // So are special values, zeros and products close to the ends of the exponent range.
+   const bool b_result_might_overflow  = ((u.exp + v.exp) >= static_cast<ExponentType>(cpp_dec_float_max_exp10));
+   const bool b_result_might_underflow = ((u.exp + v.exp) <= static_cast<ExponentType>(cpp_dec_float_min_exp10));
+
+   if((!(isfinite)()) || (!(u.isfinite)()) || (!(v.isfinite)()) || iszero() || u.iszero() || v.iszero() || b_result_might_overflow || b_result_might_underflow
+      || (neg == ((u.neg != v.neg) != b_subtract))
+      || (exp < u.exp + v.exp - static_cast<ExponentType>(cpp_dec_float_elem_digits10))
+      || (exp > u.exp + v.exp + static_cast<ExponentType>(2 * cpp_dec_float_elem_digits10)))
+   {
+      cpp_dec_float t(u);
+      t *= v;
+      return b_subtract ? (*this -= t) : (*this += t);
+   }
+
+   typedef cpp_dec_float<static_cast<unsigned>(2 * cpp_dec_float_elem_number * cpp_dec_float_elem_digits10), ExponentType, Allocator> wide_type;
+
+   const boost::int32_t p = (std::min)(u.prec_elem, v.prec_elem);
+   const unsigned n = static_cast<unsigned>(p);
+
+   // The operands least significant limb first and their product, on the stack unless
+   // the product needs the sub-quadratic routines.
+   static const unsigned local_limbs = 4u * static_cast<unsigned>((cpp_dec_float_elem_number < BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF) ? cpp_dec_float_elem_number : BOOST_MP_CPP_DEC_FLOAT_KARATSUBA_CUTOFF);
+   boost::uint32_t local[local_limbs];
+   std::vector<boost::uint32_t, typename detail::dec_scratch_allocator<Allocator>::type> scratch;
+   boost::uint32_t* a = local;
+   if(4u * n + detail::dec_multiply_scratch_size(n) > local_limbs)
+   {
+      scratch.resize(4u * n + detail::dec_multiply_scratch_size(n));
+      a = &scratch[0];
+   }
+   boost::uint32_t* b = a + n;
+   boost::uint32_t* r = b + n;
+   std::reverse_copy(u.data.begin(), u.data.begin() + p, a);
+   if(&u == &v)
+   {
+      b = a;
+   }
+   else
+   {
+      std::reverse_copy(v.data.begin(), v.data.begin() + p, b);
+   }
+   detail::dec_multiply_recursive(r, a, n, b, n, r + 2u * n);
+
+   // Both leading limbs are non-zero, so at most the top limb of the product is zero.
+   const unsigned product_limbs = (r[2u * n - 1u] != static_cast<boost::uint32_t>(0u)) ? 2u * n : 2u * n - 1u;
+
+   wide_type product;
+   std::reverse_copy(r, r + product_limbs, product.data.begin());
+   product.exp = u.exp + v.exp + ((product_limbs == 2u * n) ? static_cast<ExponentType>(cpp_dec_float_elem_digits10) : static_cast<ExponentType>(0));
+   product.neg = ((u.neg != v.neg) != b_subtract);
+
+   product += wide_type(*this);
+
+   return *this = cpp_dec_float(product);
+}
+
 template <unsigned Digits10, class ExponentType, class Allocator>
 cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, ExponentType, Allocator>::operator/=(const cpp_dec_float<Digits10, ExponentType, Allocator>& v)
 {
@@ -1001,12 +1547,64 @@ cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, Expone
          *this = one();
       return *this;
    }
-   else
+   else if(!(isfinite)() || !(v.isfinite)() || v.iszero() || iszero())
    {
+      // Let the special values propagate as they do through multiplication.
       cpp_dec_float t(v);
       t.calculate_inv();
       return operator*=(t);
    }
+
+   // Evaluate the sign of the result.
+   const bool b_result_is_neg = (neg != v.neg);
+
+   // Check for potential overflow or underflow.
+   const bool b_result_might_overflow  = ((exp - v.exp) >= static_cast<ExponentType>(cpp_dec_float_max_exp10));
+   const bool b_result_might_underflow = ((exp - v.exp) <= static_cast<ExponentType>(cpp_dec_float_min_exp10));
+
+   const boost::int32_t prec_div = (std::min)(prec_elem, v.prec_elem);
+
+   if(prec_div < static_cast<boost::int32_t>(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF))
+   {
+      // Set the exponent of the result, one limb lower if the quotient's leading limb is zero.
+      exp -= v.exp;
+
+      if(div_loop_uv(data.data(), v.data.data(), prec_div))
+      {
+         exp -= cpp_dec_float_elem_digits10;
+      }
+   }
+   else
+   {
+      const ExponentType delta_exp = static_cast<ExponentType>(exp - v.exp);
+
+      div_newton(v, prec_div);
+
+      exp += delta_exp;
+   }
+
+   std::fill(data.begin() + static_cast<std::size_t>(prec_div), data.begin() + static_cast<std::size_t>(prec_elem), static_cast<boost::uint32_t>(0u));
+
+   neg = false;
+
+   // Handle overflow.
+   if(b_result_might_overflow && (compare((cpp_dec_float::max)()) > 0))
+   {
+      *this = inf();
+   }
+
+   // Handle underflow.
+   if(b_result_might_underflow && (compare((cpp_dec_float::min)()) < 0))
+   {
+      *this = zero();
+
+      return *this;
+   }
+
+   // Set the sign of the result.
+   neg = b_result_is_neg;
+
+   return *this;
 }
 
 template <unsigned Digits10, class ExponentType, class Allocator>
@@ -1182,7 +1780,13 @@ cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, Expone
 template <unsigned Digits10, class ExponentType, class Allocator>
 cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, ExponentType, Allocator>::calculate_inv()
 {
-   // Compute the inverse of *this.
+   return calculate_inv(cpp_dec_float_total_digits10);
+}
+
+template <unsigned Digits10, class ExponentType, class Allocator>
+cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, ExponentType, Allocator>::calculate_inv(const boost::int32_t target_digits)
+{
+   // Compute the inverse of *this to target_digits.
    const bool b_neg = neg;
 
    neg = false;
@@ -1232,11 +1836,12 @@ cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, Expone
 
    static const boost::int32_t double_digits10_minus_a_few = std::numeric_limits<double>::digits10 - 3;
 
-   for(boost::int32_t digits = double_digits10_minus_a_few; digits <= cpp_dec_float_total_digits10; digits *= static_cast<boost::int32_t>(2))
+   for(boost::int32_t digits = double_digits10_minus_a_few; digits <= target_digits; digits *= static_cast<boost::int32_t>(2))
    {
       // Adjust precision of the terms.
-      precision(static_cast<boost::int32_t>((digits + 10) * static_cast<boost::int32_t>(2)));
-      x.precision(static_cast<boost::int32_t>((digits + 10) * static_cast<boost::int32_t>(2)));
+      const boost::int32_t prec = (std::min)(static_cast<boost::int32_t>((digits + 10) * static_cast<boost::int32_t>(2)), target_digits);
+      precision(prec);
+      x.precision(prec);
 
       // Next iteration.
       cpp_dec_float t(*this);
@@ -1248,7 +1853,57 @@ cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, Expone
 
    neg = b_neg;
 
-   prec_elem = cpp_dec_float_elem_number;
+   precision(target_digits);
+
+   return *this;
+}
+
+template <unsigned Digits10, class ExponentType, class Allocator>
+cpp_dec_float<Digits10, ExponentType, Allocator>& cpp_dec_float<Digits10, ExponentType, Allocator>::div_newton(const cpp_dec_float<Digits10, ExponentType, Allocator>& v, const boost::int32_t p)
+{
+   // Set *this to |*this / v| to p limbs, ignoring both exponents, for finite non-zero values.
+   // This is Karp and Markstein's form of Newton division: with y ~ 1/v to a little over
+   // half the precision, q = u * y is good to the same precision, and one more step
+   // q += y * (u - v * q) doubles that.  Only v * q is a full precision product.
+   const boost::int32_t digits = static_cast<boost::int32_t>(p * cpp_dec_float_elem_digits10);
+   const boost::int32_t half_digits = static_cast<boost::int32_t>(digits / 2 + 2 * cpp_dec_float_elem_digits10);
+
+   const boost::int32_t original_prec_elem = prec_elem;
+
+   // Limbs beyond the precision of a value are stale, and since addition uses them they
+   // are cleared before any value takes part in one, or is used at a higher precision.
+   cpp_dec_float u(*this);
+   u.exp = static_cast<ExponentType>(0);
+   u.neg = false;
+   u.prec_elem = p;
+   std::fill(u.data.begin() + static_cast<std::size_t>(p), u.data.end(), static_cast<boost::uint32_t>(0u));
+
+   cpp_dec_float y(v);
+   y.exp = static_cast<ExponentType>(0);
+   y.neg = false;
+   y.calculate_inv(half_digits);
+
+   cpp_dec_float& q = *this;
+   q = u;
+   q.precision(half_digits);
+   q *= y;
+   std::fill(q.data.begin() + static_cast<std::size_t>(q.prec_elem), q.data.end(), static_cast<boost::uint32_t>(0u));
+   q.prec_elem = p;
+
+   cpp_dec_float r(v);
+   r.exp = static_cast<ExponentType>(0);
+   r.neg = false;
+   r.prec_elem = p;
+   std::fill(r.data.begin() + static_cast<std::size_t>(p), r.data.end(), static_cast<boost::uint32_t>(0u));
+   r *= q;
+   r.negate();
+   r += u;
+   r.precision(half_digits);
+   r *= y;
+   std::fill(r.data.begin() + static_cast<std::size_t>(r.prec_elem), r.data.end(), static_cast<boost::uint32_t>(0u));
+
+   q += r;
+   q.prec_elem = original_prec_elem;
 
    return *this;
 }
@@ -2358,7 +3013,25 @@ boost::uint32_t cpp_dec_float<Digits10, ExponentType, Allocator>::mul_loop_uv(bo
    //
    // FLOOR( (2^64 - 1) / (10^8 * 10^8) ) == 1844
    //
-   BOOST_STATIC_ASSERT_MSG(cpp_dec_float_elem_number < 1800, "Too many limbs in the data type for the multiplication algorithm - unsupported precision in cpp_dec_float.");
+   // So larger products, and those where the number theoretic transform is quicker, form
+   // the full product of the limbs with the sub-quadratic routines and keep its top half:
+   //
+   if((p >= static_cast<boost::int32_t>(BOOST_MP_CPP_DEC_FLOAT_NTT_CUTOFF)) || (p >= static_cast<boost::int32_t>(1800)))
+   {
+      const unsigned n = static_cast<unsigned>(p);
+      std::vector<boost::uint32_t, typename detail::dec_scratch_allocator<Allocator>::type> scratch(4 * n + detail::dec_multiply_scratch_size(n));
+      boost::uint32_t* a = &scratch[0];
+      boost::uint32_t* b = a + n;
+      boost::uint32_t* r = b + n;
+      std::reverse_copy(u, u + n, a);
+      if(u == v)
+         b = a;
+      else
+         std::reverse_copy(v, v + n, b);
+      detail::dec_multiply_recursive(r, a, n, b, n, r + 2 * n);
+      std::reverse_copy(r + n - 1, r + 2 * n - 1, u);
+      return r[2 * n - 1];
+   }
 
    boost::uint64_t carry = static_cast<boost::uint64_t>(0u);
 
@@ -2378,6 +3051,116 @@ boost::uint32_t cpp_dec_float<Digits10, ExponentType, Allocator>::mul_loop_uv(bo
    return static_cast<boost::uint32_t>(carry);
 }
 
+template <unsigned Digits10, class ExponentType, class Allocator>
+bool cpp_dec_float<Digits10, ExponentType, Allocator>::div_loop_uv(boost::uint32_t* const u, const boost::uint32_t* const v, const boost::int32_t p)
+{
+   //
+   // Schoolbook long division, Knuth's algorithm D, of u[0, p) by v[0, p) which are both
+   // normalised (non-zero leading limb).  Sets u[0, p) to the leading limbs of the quotient
+   // and returns true if the first limb of the quotient proper was zero, in which case the
+   // result is one limb lower than the exponents alone suggest.  Up to 3p + 2 limbs of
+   // working storage are needed, which come from the stack for the precisions which
+   // normally take this path:
+   //
+   static const boost::int32_t local_limbs = static_cast<boost::int32_t>(3 * ((cpp_dec_float_elem_number < BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF) ? cpp_dec_float_elem_number : BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF) + 2);
+   boost::uint32_t local[local_limbs];
+   std::vector<boost::uint32_t, typename detail::dec_scratch_allocator<Allocator>::type> scratch;
+
+   static const boost::uint32_t b = static_cast<boost::uint32_t>(cpp_dec_float_elem_mask);
+
+   // Trailing zero limbs of the divisor play no part in the division.
+   boost::int32_t m = p;
+   while(v[m - 1] == static_cast<boost::uint32_t>(0u))
+   {
+      --m;
+   }
+
+   boost::uint32_t* w = local;
+   if(p + 2 * m + 1 > local_limbs)
+   {
+      scratch.resize(static_cast<std::size_t>(p + 2 * m + 1));
+      w = &scratch[0];
+   }
+   boost::uint32_t* vn = w + (p + m + 1);
+
+   // Scale both by d so that the divisor's leading limb is at least b / 2, then each
+   // estimate of a quotient limb from the leading limbs is at most 2 too large.
+   // w[0, p + m] holds the scaled dividend extended with zeros.
+   const boost::uint32_t d = b / (v[0] + 1u);
+   boost::uint64_t carry = 0u;
+   for(boost::int32_t i = m - 1; i >= 0; --i)
+   {
+      const boost::uint64_t t = static_cast<boost::uint64_t>(v[i]) * d + carry;
+      carry = t / b;
+      vn[i] = static_cast<boost::uint32_t>(t - carry * b);
+   }
+   carry = 0u;
+   for(boost::int32_t i = p - 1; i >= 0; --i)
+   {
+      const boost::uint64_t t = static_cast<boost::uint64_t>(u[i]) * d + carry;
+      carry = t / b;
+      w[i + 1] = static_cast<boost::uint32_t>(t - carry * b);
+   }
+   w[0] = static_cast<boost::uint32_t>(carry);
+   std::fill(w + (p + 1), w + (p + m + 1), static_cast<boost::uint32_t>(0u));
+
+   // One quotient limb for each of w[0, p], the first of which may be zero.  Each is
+   // stored in place of the leading limb of the remainder, which is then zero.
+   for(boost::int32_t j = 0; j <= p; ++j)
+   {
+      const boost::uint64_t num = static_cast<boost::uint64_t>(w[j]) * b + w[j + 1];
+      boost::uint64_t qhat = num / vn[0];
+      boost::uint64_t rhat = num - qhat * vn[0];
+      if(qhat >= b)
+      {
+         qhat = b - 1u;
+         rhat = num - qhat * vn[0];
+      }
+      if(m > 1)
+      {
+         while((rhat < b) && (qhat * vn[1] > rhat * b + w[j + 2]))
+         {
+            --qhat;
+            rhat += vn[0];
+         }
+      }
+
+      // w[j, j + m] -= qhat * vn.  The high half of each limb product is subtracted along
+      // with the low half of the next one up, so that only the borrow, of at most 2, is
+      // carried from limb to limb and the divisions by b don't depend on one another.
+      boost::uint32_t hi = 0u;
+      boost::int32_t borrow = 0;
+      for(boost::int32_t i = m - 1; i >= 0; --i)
+      {
+         const boost::uint64_t t = qhat * vn[i];
+         const boost::uint32_t t_hi = static_cast<boost::uint32_t>(t / b);
+         const boost::uint32_t t_lo = static_cast<boost::uint32_t>(t - static_cast<boost::uint64_t>(t_hi) * b);
+         boost::int32_t wi = static_cast<boost::int32_t>(w[j + 1 + i]) - static_cast<boost::int32_t>(t_lo) - static_cast<boost::int32_t>(hi) - borrow;
+         borrow = (wi < 0) ? ((wi < -static_cast<boost::int32_t>(b)) ? 2 : 1) : 0;
+         w[j + 1 + i] = static_cast<boost::uint32_t>(wi + borrow * static_cast<boost::int32_t>(b));
+         hi = t_hi;
+      }
+      if(static_cast<boost::uint64_t>(w[j]) < static_cast<boost::uint64_t>(hi) + static_cast<boost::uint32_t>(borrow))
+      {
+         // The estimate was one too large, add one divisor back in.
+         --qhat;
+         boost::uint32_t add_carry = 0u;
+         for(boost::int32_t i = m - 1; i >= 0; --i)
+         {
+            boost::uint32_t& wi = w[j + 1 + i];
+            const boost::uint32_t t = wi + vn[i] + add_carry;
+            add_carry = (t >= b) ? 1u : 0u;
+            wi = add_carry ? t - b : t;
+         }
+      }
+      w[j] = static_cast<boost::uint32_t>(qhat);
+   }
+
+   const bool b_leading_zero = (w[0] == static_cast<boost::uint32_t>(0u));
+   std::copy(w + (b_leading_zero ? 1 : 0), w + (b_leading_zero ? p + 1 : p), u);
+   return b_leading_zero;
+}
+
 template <unsigned Digits10, class ExponentType, class Allocator>
 boost::uint32_t cpp_dec_float<Digits10, ExponentType, Allocator>::mul_loop_n(boost::uint32_t* const u, boost::uint32_t n, const boost::int32_t p)
 {
@@ -2409,271 +3192,76 @@ boost::uint32_t cpp_dec_float<Digits10, ExponentType, Allocator>::div_loop_n(boo
    return static_cast<boost::uint32_t>(prev);
 }
 
+template <unsigned Digits10, class ExponentType, class Allocator>
+cpp_dec_float<Digits10, ExponentType, Allocator> cpp_dec_float<Digits10, ExponentType, Allocator>::power_of_ten(const ExponentType e)
+{
+   // 10^e for e a multiple of the limb size, set directly rather than parsed from a string.
+   cpp_dec_float<Digits10, ExponentType, Allocator> result;
+   result.data[0u] = static_cast<boost::uint32_t>(1u);
+   result.exp = e;
+   return result;
+}
+
+template <unsigned Digits10, class ExponentType, class Allocator>
+boost::array<cpp_dec_float<Digits10, ExponentType, Allocator>, 255u> cpp_dec_float<Digits10, ExponentType, Allocator>::pow2_table()
+{
+   // Each entry is set exactly from the limbs of an integer: 2^p itself for p >= 0, and
+   // for p < 0, 2^p = 5^-p * 10^r * 10^(p - r) with r chosen to make the exponent a
+   // multiple of the limb size.  Neither integer needs more than 12 limbs, the
+   // entries are truncated to the precision like any other value.
+   boost::array<cpp_dec_float<Digits10, ExponentType, Allocator>, 255u> result;
+
+   static const boost::uint32_t powers_of_ten[8u] = { 1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u };
+   boost::uint32_t pow_2[13u] = { 1u };
+   boost::uint32_t pow_5[13u] = { 1u };
+   unsigned n2 = 1u;
+   unsigned n5 = 1u;
+
+   for(boost::int32_t k = 0; k < 128; ++k)
+   {
+      if(k != 0)
+      {
+         const boost::uint32_t carry_2 = detail::dec_multiply_limbs_1(pow_2, n2, 2u);
+         if(carry_2 != 0u) { pow_2[n2++] = carry_2; }
+         const boost::uint32_t carry_5 = detail::dec_multiply_limbs_1(pow_5, n5, 5u);
+         if(carry_5 != 0u) { pow_5[n5++] = carry_5; }
+      }
+
+      cpp_dec_float<Digits10, ExponentType, Allocator>& positive = result[static_cast<std::size_t>(127 + k)];
+      for(boost::int32_t i = 0; (i < static_cast<boost::int32_t>(n2)) && (i < cpp_dec_float_elem_number); ++i)
+      {
+         positive.data[i] = pow_2[n2 - 1u - i];
+      }
+      positive.exp = static_cast<ExponentType>((n2 - 1u) * cpp_dec_float_elem_digits10);
+
+      if(k != 0)
+      {
+         const boost::int32_t r = (cpp_dec_float_elem_digits10 - (k % cpp_dec_float_elem_digits10)) % cpp_dec_float_elem_digits10;
+         boost::uint32_t scaled[13u];
+         std::copy(pow_5, pow_5 + n5, scaled);
+         unsigned n = n5;
+         const boost::uint32_t carry = detail::dec_multiply_limbs_1(scaled, n, powers_of_ten[r]);
+         if(carry != 0u) { scaled[n++] = carry; }
+
+         cpp_dec_float<Digits10, ExponentType, Allocator>& negative = result[static_cast<std::size_t>(127 - k)];
+         for(boost::int32_t i = 0; (i < static_cast<boost::int32_t>(n)) && (i < cpp_dec_float_elem_number); ++i)
+         {
+            negative.data[i] = scaled[n - 1u - i];
+         }
+         negative.exp = static_cast<ExponentType>(static_cast<boost::int32_t>((n - 1u) * cpp_dec_float_elem_digits10) - (k + r));
+      }
+   }
+   return result;
+}
+
 template <unsigned Digits10, class ExponentType, class Allocator>
 cpp_dec_float<Digits10, ExponentType, Allocator> cpp_dec_float<Digits10, ExponentType, Allocator>::pow2(const boost::long_long_type p)
 {
-   // Create a static const table of p^2 for -128 < p < +128.
+   // A table of 2^p for -128 < p < +128, built on first use.
    // Note: The size of this table must be odd-numbered and
    // symmetric about 0.
    init.do_nothing();
-   static const boost::array<cpp_dec_float<Digits10, ExponentType, Allocator>, 255u> p2_data =
-   {{
-       cpp_dec_float("5.877471754111437539843682686111228389093327783860437607543758531392086297273635864257812500000000000e-39"),
-       cpp_dec_float("1.175494350822287507968736537222245677818665556772087521508751706278417259454727172851562500000000000e-38"),
-       cpp_dec_float("2.350988701644575015937473074444491355637331113544175043017503412556834518909454345703125000000000000e-38"),
-       cpp_dec_float("4.701977403289150031874946148888982711274662227088350086035006825113669037818908691406250000000000000e-38"),
-       cpp_dec_float("9.403954806578300063749892297777965422549324454176700172070013650227338075637817382812500000000000000e-38"),
-       cpp_dec_float("1.880790961315660012749978459555593084509864890835340034414002730045467615127563476562500000000000000e-37"),
-       cpp_dec_float("3.761581922631320025499956919111186169019729781670680068828005460090935230255126953125000000000000000e-37"),
-       cpp_dec_float("7.523163845262640050999913838222372338039459563341360137656010920181870460510253906250000000000000000e-37"),
-       cpp_dec_float("1.504632769052528010199982767644474467607891912668272027531202184036374092102050781250000000000000000e-36"),
-       cpp_dec_float("3.009265538105056020399965535288948935215783825336544055062404368072748184204101562500000000000000000e-36"),
-       cpp_dec_float("6.018531076210112040799931070577897870431567650673088110124808736145496368408203125000000000000000000e-36"),
-       cpp_dec_float("1.203706215242022408159986214115579574086313530134617622024961747229099273681640625000000000000000000e-35"),
-       cpp_dec_float("2.407412430484044816319972428231159148172627060269235244049923494458198547363281250000000000000000000e-35"),
-       cpp_dec_float("4.814824860968089632639944856462318296345254120538470488099846988916397094726562500000000000000000000e-35"),
-       cpp_dec_float("9.629649721936179265279889712924636592690508241076940976199693977832794189453125000000000000000000000e-35"),
-       cpp_dec_float("1.925929944387235853055977942584927318538101648215388195239938795566558837890625000000000000000000000e-34"),
-       cpp_dec_float("3.851859888774471706111955885169854637076203296430776390479877591133117675781250000000000000000000000e-34"),
-       cpp_dec_float("7.703719777548943412223911770339709274152406592861552780959755182266235351562500000000000000000000000e-34"),
-       cpp_dec_float("1.540743955509788682444782354067941854830481318572310556191951036453247070312500000000000000000000000e-33"),
-       cpp_dec_float("3.081487911019577364889564708135883709660962637144621112383902072906494140625000000000000000000000000e-33"),
-       cpp_dec_float("6.162975822039154729779129416271767419321925274289242224767804145812988281250000000000000000000000000e-33"),
-       cpp_dec_float("1.232595164407830945955825883254353483864385054857848444953560829162597656250000000000000000000000000e-32"),
-       cpp_dec_float("2.465190328815661891911651766508706967728770109715696889907121658325195312500000000000000000000000000e-32"),
-       cpp_dec_float("4.930380657631323783823303533017413935457540219431393779814243316650390625000000000000000000000000000e-32"),
-       cpp_dec_float("9.860761315262647567646607066034827870915080438862787559628486633300781250000000000000000000000000000e-32"),
-       cpp_dec_float("1.972152263052529513529321413206965574183016087772557511925697326660156250000000000000000000000000000e-31"),
-       cpp_dec_float("3.944304526105059027058642826413931148366032175545115023851394653320312500000000000000000000000000000e-31"),
-       cpp_dec_float("7.888609052210118054117285652827862296732064351090230047702789306640625000000000000000000000000000000e-31"),
-       cpp_dec_float("1.577721810442023610823457130565572459346412870218046009540557861328125000000000000000000000000000000e-30"),
-       cpp_dec_float("3.155443620884047221646914261131144918692825740436092019081115722656250000000000000000000000000000000e-30"),
-       cpp_dec_float("6.310887241768094443293828522262289837385651480872184038162231445312500000000000000000000000000000000e-30"),
-       cpp_dec_float("1.262177448353618888658765704452457967477130296174436807632446289062500000000000000000000000000000000e-29"),
-       cpp_dec_float("2.524354896707237777317531408904915934954260592348873615264892578125000000000000000000000000000000000e-29"),
-       cpp_dec_float("5.048709793414475554635062817809831869908521184697747230529785156250000000000000000000000000000000000e-29"),
-       cpp_dec_float("1.009741958682895110927012563561966373981704236939549446105957031250000000000000000000000000000000000e-28"),
-       cpp_dec_float("2.019483917365790221854025127123932747963408473879098892211914062500000000000000000000000000000000000e-28"),
-       cpp_dec_float("4.038967834731580443708050254247865495926816947758197784423828125000000000000000000000000000000000000e-28"),
-       cpp_dec_float("8.077935669463160887416100508495730991853633895516395568847656250000000000000000000000000000000000000e-28"),
-       cpp_dec_float("1.615587133892632177483220101699146198370726779103279113769531250000000000000000000000000000000000000e-27"),
-       cpp_dec_float("3.231174267785264354966440203398292396741453558206558227539062500000000000000000000000000000000000000e-27"),
-       cpp_dec_float("6.462348535570528709932880406796584793482907116413116455078125000000000000000000000000000000000000000e-27"),
-       cpp_dec_float("1.292469707114105741986576081359316958696581423282623291015625000000000000000000000000000000000000000e-26"),
-       cpp_dec_float("2.584939414228211483973152162718633917393162846565246582031250000000000000000000000000000000000000000e-26"),
-       cpp_dec_float("5.169878828456422967946304325437267834786325693130493164062500000000000000000000000000000000000000000e-26"),
-       cpp_dec_float("1.033975765691284593589260865087453566957265138626098632812500000000000000000000000000000000000000000e-25"),
-       cpp_dec_float("2.067951531382569187178521730174907133914530277252197265625000000000000000000000000000000000000000000e-25"),
-       cpp_dec_float("4.135903062765138374357043460349814267829060554504394531250000000000000000000000000000000000000000000e-25"),
-       cpp_dec_float("8.271806125530276748714086920699628535658121109008789062500000000000000000000000000000000000000000000e-25"),
-       cpp_dec_float("1.654361225106055349742817384139925707131624221801757812500000000000000000000000000000000000000000000e-24"),
-       cpp_dec_float("3.308722450212110699485634768279851414263248443603515625000000000000000000000000000000000000000000000e-24"),
-       cpp_dec_float("6.617444900424221398971269536559702828526496887207031250000000000000000000000000000000000000000000000e-24"),
-       cpp_dec_float("1.323488980084844279794253907311940565705299377441406250000000000000000000000000000000000000000000000e-23"),
-       cpp_dec_float("2.646977960169688559588507814623881131410598754882812500000000000000000000000000000000000000000000000e-23"),
-       cpp_dec_float("5.293955920339377119177015629247762262821197509765625000000000000000000000000000000000000000000000000e-23"),
-       cpp_dec_float("1.058791184067875423835403125849552452564239501953125000000000000000000000000000000000000000000000000e-22"),
-       cpp_dec_float("2.117582368135750847670806251699104905128479003906250000000000000000000000000000000000000000000000000e-22"),
-       cpp_dec_float("4.235164736271501695341612503398209810256958007812500000000000000000000000000000000000000000000000000e-22"),
-       cpp_dec_float("8.470329472543003390683225006796419620513916015625000000000000000000000000000000000000000000000000000e-22"),
-       cpp_dec_float("1.694065894508600678136645001359283924102783203125000000000000000000000000000000000000000000000000000e-21"),
-       cpp_dec_float("3.388131789017201356273290002718567848205566406250000000000000000000000000000000000000000000000000000e-21"),
-       cpp_dec_float("6.776263578034402712546580005437135696411132812500000000000000000000000000000000000000000000000000000e-21"),
-       cpp_dec_float("1.355252715606880542509316001087427139282226562500000000000000000000000000000000000000000000000000000e-20"),
-       cpp_dec_float("2.710505431213761085018632002174854278564453125000000000000000000000000000000000000000000000000000000e-20"),
-       cpp_dec_float("5.421010862427522170037264004349708557128906250000000000000000000000000000000000000000000000000000000e-20"),
-       cpp_dec_float("1.084202172485504434007452800869941711425781250000000000000000000000000000000000000000000000000000000e-19"),
-       cpp_dec_float("2.168404344971008868014905601739883422851562500000000000000000000000000000000000000000000000000000000e-19"),
-       cpp_dec_float("4.336808689942017736029811203479766845703125000000000000000000000000000000000000000000000000000000000e-19"),
-       cpp_dec_float("8.673617379884035472059622406959533691406250000000000000000000000000000000000000000000000000000000000e-19"),
-       cpp_dec_float("1.734723475976807094411924481391906738281250000000000000000000000000000000000000000000000000000000000e-18"),
-       cpp_dec_float("3.469446951953614188823848962783813476562500000000000000000000000000000000000000000000000000000000000e-18"),
-       cpp_dec_float("6.938893903907228377647697925567626953125000000000000000000000000000000000000000000000000000000000000e-18"),
-       cpp_dec_float("1.387778780781445675529539585113525390625000000000000000000000000000000000000000000000000000000000000e-17"),
-       cpp_dec_float("2.775557561562891351059079170227050781250000000000000000000000000000000000000000000000000000000000000e-17"),
-       cpp_dec_float("5.551115123125782702118158340454101562500000000000000000000000000000000000000000000000000000000000000e-17"),
-       cpp_dec_float("1.110223024625156540423631668090820312500000000000000000000000000000000000000000000000000000000000000e-16"),
-       cpp_dec_float("2.220446049250313080847263336181640625000000000000000000000000000000000000000000000000000000000000000e-16"),
-       cpp_dec_float("4.440892098500626161694526672363281250000000000000000000000000000000000000000000000000000000000000000e-16"),
-       cpp_dec_float("8.881784197001252323389053344726562500000000000000000000000000000000000000000000000000000000000000000e-16"),
-       cpp_dec_float("1.776356839400250464677810668945312500000000000000000000000000000000000000000000000000000000000000000e-15"),
-       cpp_dec_float("3.552713678800500929355621337890625000000000000000000000000000000000000000000000000000000000000000000e-15"),
-       cpp_dec_float("7.105427357601001858711242675781250000000000000000000000000000000000000000000000000000000000000000000e-15"),
-       cpp_dec_float("1.421085471520200371742248535156250000000000000000000000000000000000000000000000000000000000000000000e-14"),
-       cpp_dec_float("2.842170943040400743484497070312500000000000000000000000000000000000000000000000000000000000000000000e-14"),
-       cpp_dec_float("5.684341886080801486968994140625000000000000000000000000000000000000000000000000000000000000000000000e-14"),
-       cpp_dec_float("1.136868377216160297393798828125000000000000000000000000000000000000000000000000000000000000000000000e-13"),
-       cpp_dec_float("2.273736754432320594787597656250000000000000000000000000000000000000000000000000000000000000000000000e-13"),
-       cpp_dec_float("4.547473508864641189575195312500000000000000000000000000000000000000000000000000000000000000000000000e-13"),
-       cpp_dec_float("9.094947017729282379150390625000000000000000000000000000000000000000000000000000000000000000000000000e-13"),
-       cpp_dec_float("1.818989403545856475830078125000000000000000000000000000000000000000000000000000000000000000000000000e-12"),
-       cpp_dec_float("3.637978807091712951660156250000000000000000000000000000000000000000000000000000000000000000000000000e-12"),
-       cpp_dec_float("7.275957614183425903320312500000000000000000000000000000000000000000000000000000000000000000000000000e-12"),
-       cpp_dec_float("1.455191522836685180664062500000000000000000000000000000000000000000000000000000000000000000000000000e-11"),
-       cpp_dec_float("2.910383045673370361328125000000000000000000000000000000000000000000000000000000000000000000000000000e-11"),
-       cpp_dec_float("5.820766091346740722656250000000000000000000000000000000000000000000000000000000000000000000000000000e-11"),
-       cpp_dec_float("1.164153218269348144531250000000000000000000000000000000000000000000000000000000000000000000000000000e-10"),
-       cpp_dec_float("2.328306436538696289062500000000000000000000000000000000000000000000000000000000000000000000000000000e-10"),
-       cpp_dec_float("4.656612873077392578125000000000000000000000000000000000000000000000000000000000000000000000000000000e-10"),
-       cpp_dec_float("9.313225746154785156250000000000000000000000000000000000000000000000000000000000000000000000000000000e-10"),
-       cpp_dec_float("1.862645149230957031250000000000000000000000000000000000000000000000000000000000000000000000000000000e-9"),
-       cpp_dec_float("3.725290298461914062500000000000000000000000000000000000000000000000000000000000000000000000000000000e-9"),
-       cpp_dec_float("7.450580596923828125000000000000000000000000000000000000000000000000000000000000000000000000000000000e-9"),
-       cpp_dec_float("1.490116119384765625000000000000000000000000000000000000000000000000000000000000000000000000000000000e-8"),
-       cpp_dec_float("2.980232238769531250000000000000000000000000000000000000000000000000000000000000000000000000000000000e-8"),
-       cpp_dec_float("5.960464477539062500000000000000000000000000000000000000000000000000000000000000000000000000000000000e-8"),
-       cpp_dec_float("1.192092895507812500000000000000000000000000000000000000000000000000000000000000000000000000000000000e-7"),
-       cpp_dec_float("2.384185791015625000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-7"),
-       cpp_dec_float("4.768371582031250000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-7"),
-       cpp_dec_float("9.536743164062500000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-7"),
-       cpp_dec_float("1.907348632812500000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-6"),
-       cpp_dec_float("3.814697265625000000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-6"),
-       cpp_dec_float("7.629394531250000000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-6"),
-       cpp_dec_float("0.000015258789062500000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000030517578125000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000061035156250000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000122070312500000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000244140625000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000488281250000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.000976562500000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.001953125000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.003906250000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.007812500000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.01562500000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.03125000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.06250000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"),
-       cpp_dec_float("0.125"),
-       cpp_dec_float("0.25"),
-       cpp_dec_float("0.5"),
-       one(),
-       two(),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(4)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(8)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(16)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(32)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(64)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(128)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(256)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(512)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(1024)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(2048)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(4096)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(8192)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(16384)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(32768)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(65536)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(131072)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(262144)),
-       cpp_dec_float(static_cast<boost::ulong_long_type>(524288)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 20u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 21u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 22u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 23u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 24u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 25u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 26u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 27u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 28u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 29u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 30u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uL << 31u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 32u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 33u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 34u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 35u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 36u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 37u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 38u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 39u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 40u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 41u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 42u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 43u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 44u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 45u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 46u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 47u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 48u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 49u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 50u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 51u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 52u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 53u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 54u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 55u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 56u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 57u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 58u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 59u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 60u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 61u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 62u)),
-       cpp_dec_float(static_cast<boost::uint64_t>(1uLL << 63u)),
-       cpp_dec_float("1.844674407370955161600000000000000000000000000000000000000000000000000000000000000000000000000000000e19"),
-       cpp_dec_float("3.689348814741910323200000000000000000000000000000000000000000000000000000000000000000000000000000000e19"),
-       cpp_dec_float("7.378697629483820646400000000000000000000000000000000000000000000000000000000000000000000000000000000e19"),
-       cpp_dec_float("1.475739525896764129280000000000000000000000000000000000000000000000000000000000000000000000000000000e20"),
-       cpp_dec_float("2.951479051793528258560000000000000000000000000000000000000000000000000000000000000000000000000000000e20"),
-       cpp_dec_float("5.902958103587056517120000000000000000000000000000000000000000000000000000000000000000000000000000000e20"),
-       cpp_dec_float("1.180591620717411303424000000000000000000000000000000000000000000000000000000000000000000000000000000e21"),
-       cpp_dec_float("2.361183241434822606848000000000000000000000000000000000000000000000000000000000000000000000000000000e21"),
-       cpp_dec_float("4.722366482869645213696000000000000000000000000000000000000000000000000000000000000000000000000000000e21"),
-       cpp_dec_float("9.444732965739290427392000000000000000000000000000000000000000000000000000000000000000000000000000000e21"),
-       cpp_dec_float("1.888946593147858085478400000000000000000000000000000000000000000000000000000000000000000000000000000e22"),
-       cpp_dec_float("3.777893186295716170956800000000000000000000000000000000000000000000000000000000000000000000000000000e22"),
-       cpp_dec_float("7.555786372591432341913600000000000000000000000000000000000000000000000000000000000000000000000000000e22"),
-       cpp_dec_float("1.511157274518286468382720000000000000000000000000000000000000000000000000000000000000000000000000000e23"),
-       cpp_dec_float("3.022314549036572936765440000000000000000000000000000000000000000000000000000000000000000000000000000e23"),
-       cpp_dec_float("6.044629098073145873530880000000000000000000000000000000000000000000000000000000000000000000000000000e23"),
-       cpp_dec_float("1.208925819614629174706176000000000000000000000000000000000000000000000000000000000000000000000000000e24"),
-       cpp_dec_float("2.417851639229258349412352000000000000000000000000000000000000000000000000000000000000000000000000000e24"),
-       cpp_dec_float("4.835703278458516698824704000000000000000000000000000000000000000000000000000000000000000000000000000e24"),
-       cpp_dec_float("9.671406556917033397649408000000000000000000000000000000000000000000000000000000000000000000000000000e24"),
-       cpp_dec_float("1.934281311383406679529881600000000000000000000000000000000000000000000000000000000000000000000000000e25"),
-       cpp_dec_float("3.868562622766813359059763200000000000000000000000000000000000000000000000000000000000000000000000000e25"),
-       cpp_dec_float("7.737125245533626718119526400000000000000000000000000000000000000000000000000000000000000000000000000e25"),
-       cpp_dec_float("1.547425049106725343623905280000000000000000000000000000000000000000000000000000000000000000000000000e26"),
-       cpp_dec_float("3.094850098213450687247810560000000000000000000000000000000000000000000000000000000000000000000000000e26"),
-       cpp_dec_float("6.189700196426901374495621120000000000000000000000000000000000000000000000000000000000000000000000000e26"),
-       cpp_dec_float("1.237940039285380274899124224000000000000000000000000000000000000000000000000000000000000000000000000e27"),
-       cpp_dec_float("2.475880078570760549798248448000000000000000000000000000000000000000000000000000000000000000000000000e27"),
-       cpp_dec_float("4.951760157141521099596496896000000000000000000000000000000000000000000000000000000000000000000000000e27"),
-       cpp_dec_float("9.903520314283042199192993792000000000000000000000000000000000000000000000000000000000000000000000000e27"),
-       cpp_dec_float("1.980704062856608439838598758400000000000000000000000000000000000000000000000000000000000000000000000e28"),
-       cpp_dec_float("3.961408125713216879677197516800000000000000000000000000000000000000000000000000000000000000000000000e28"),
-       cpp_dec_float("7.922816251426433759354395033600000000000000000000000000000000000000000000000000000000000000000000000e28"),
-       cpp_dec_float("1.584563250285286751870879006720000000000000000000000000000000000000000000000000000000000000000000000e29"),
-       cpp_dec_float("3.169126500570573503741758013440000000000000000000000000000000000000000000000000000000000000000000000e29"),
-       cpp_dec_float("6.338253001141147007483516026880000000000000000000000000000000000000000000000000000000000000000000000e29"),
-       cpp_dec_float("1.267650600228229401496703205376000000000000000000000000000000000000000000000000000000000000000000000e30"),
-       cpp_dec_float("2.535301200456458802993406410752000000000000000000000000000000000000000000000000000000000000000000000e30"),
-       cpp_dec_float("5.070602400912917605986812821504000000000000000000000000000000000000000000000000000000000000000000000e30"),
-       cpp_dec_float("1.014120480182583521197362564300800000000000000000000000000000000000000000000000000000000000000000000e31"),
-       cpp_dec_float("2.028240960365167042394725128601600000000000000000000000000000000000000000000000000000000000000000000e31"),
-       cpp_dec_float("4.056481920730334084789450257203200000000000000000000000000000000000000000000000000000000000000000000e31"),
-       cpp_dec_float("8.112963841460668169578900514406400000000000000000000000000000000000000000000000000000000000000000000e31"),
-       cpp_dec_float("1.622592768292133633915780102881280000000000000000000000000000000000000000000000000000000000000000000e32"),
-       cpp_dec_float("3.245185536584267267831560205762560000000000000000000000000000000000000000000000000000000000000000000e32"),
-       cpp_dec_float("6.490371073168534535663120411525120000000000000000000000000000000000000000000000000000000000000000000e32"),
-       cpp_dec_float("1.298074214633706907132624082305024000000000000000000000000000000000000000000000000000000000000000000e33"),
-       cpp_dec_float("2.596148429267413814265248164610048000000000000000000000000000000000000000000000000000000000000000000e33"),
-       cpp_dec_float("5.192296858534827628530496329220096000000000000000000000000000000000000000000000000000000000000000000e33"),
-       cpp_dec_float("1.038459371706965525706099265844019200000000000000000000000000000000000000000000000000000000000000000e34"),
-       cpp_dec_float("2.076918743413931051412198531688038400000000000000000000000000000000000000000000000000000000000000000e34"),
-       cpp_dec_float("4.153837486827862102824397063376076800000000000000000000000000000000000000000000000000000000000000000e34"),
-       cpp_dec_float("8.307674973655724205648794126752153600000000000000000000000000000000000000000000000000000000000000000e34"),
-       cpp_dec_float("1.661534994731144841129758825350430720000000000000000000000000000000000000000000000000000000000000000e35"),
-       cpp_dec_float("3.323069989462289682259517650700861440000000000000000000000000000000000000000000000000000000000000000e35"),
-       cpp_dec_float("6.646139978924579364519035301401722880000000000000000000000000000000000000000000000000000000000000000e35"),
-       cpp_dec_float("1.329227995784915872903807060280344576000000000000000000000000000000000000000000000000000000000000000e36"),
-       cpp_dec_float("2.658455991569831745807614120560689152000000000000000000000000000000000000000000000000000000000000000e36"),
-       cpp_dec_float("5.316911983139663491615228241121378304000000000000000000000000000000000000000000000000000000000000000e36"),
-       cpp_dec_float("1.063382396627932698323045648224275660800000000000000000000000000000000000000000000000000000000000000e37"),
-       cpp_dec_float("2.126764793255865396646091296448551321600000000000000000000000000000000000000000000000000000000000000e37"),
-       cpp_dec_float("4.253529586511730793292182592897102643200000000000000000000000000000000000000000000000000000000000000e37"),
-       cpp_dec_float("8.507059173023461586584365185794205286400000000000000000000000000000000000000000000000000000000000000e37"),
-       cpp_dec_float("1.701411834604692317316873037158841057280000000000000000000000000000000000000000000000000000000000000e38")
-   }};
+   static const boost::array<cpp_dec_float<Digits10, ExponentType, Allocator>, 255u> p2_data = pow2_table();
 
    if((p > static_cast<boost::long_long_type>(-128)) && (p < static_cast<boost::long_long_type>(+128)))
    {
@@ -2716,6 +3304,51 @@ inline void eval_divide(cpp_dec_float<Digits10, ExponentType, Allocator>& result
 {
    result /= o;
 }
+//
+// Fused multiply-add, the product isn't truncated before the addition:
+//
+template <unsigned Digits10, class ExponentType, class Allocator>
+inline void eval_multiply_add(cpp_dec_float<Digits10, ExponentType, Allocator>& result, const cpp_dec_float<Digits10, ExponentType, Allocator>& a, const cpp_dec_float<Digits10, ExponentType, Allocator>& b)
+{
+   result.multiply_add(a, b);
+}
+template <unsigned Digits10, class ExponentType, class Allocator>
+inline void eval_multiply_add(cpp_dec_float<Digits10, ExponentType, Allocator>& result, const cpp_dec_float<Digits10, ExponentType, Allocator>& a, const cpp_dec_float<Digits10, ExponentType, Allocator>& b, const cpp_dec_float<Digits10, ExponentType, Allocator>& c)
+{
+   if((&result == &a) || (&result == &b))
+   {
+      cpp_dec_float<Digits10, ExponentType, Allocator> t(c);
+      t.multiply_add(a, b);
+      result = t;
+   }
+   else
+   {
+      result = c;
+      result.multiply_add(a, b);
+   }
+}
+template <unsigned Digits10, class ExponentType, class Allocator>
+inline void eval_multiply_subtract(cpp_dec_float<Digits10, ExponentType, Allocator>& result, const cpp_dec_float<Digits10, ExponentType, Allocator>& a, const cpp_dec_float<Digits10, ExponentType, Allocator>& b)
+{
+   result.multiply_add(a, b, true);
+}
+template <unsigned Digits10, class ExponentType, class Allocator>
+inline void eval_multiply_subtract(cpp_dec_float<Digits10, ExponentType, Allocator>& result, const cpp_dec_float<Digits10, ExponentType, Allocator>& a, const cpp_dec_float<Digits10, ExponentType, Allocator>& b, const cpp_dec_float<Digits10, ExponentType, Allocator>& c)
+{
+   // a * b - c == -(c - a * b):
+   if((&result == &a) || (&result == &b))
+   {
+      cpp_dec_float<Digits10, ExponentType, Allocator> t(c);
+      t.multiply_add(a, b, true);
+      result = t;
+   }
+   else
+   {
+      result = c;
+      result.multiply_add(a, b, true);
+   }
+   result.negate();
+}
 
 template <unsigned Digits10, class ExponentType, class Allocator>
 inline void eval_add(cpp_dec_float<Digits10, ExponentType, Allocator>& result, const boost::ulong_long_type& o)
@@ -16,6 +16,7 @@
 #include <boost/array.hpp>
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_empty.hpp>
 #include <boost/multiprecision/cpp_int/cpp_int_config.hpp>
 #include <boost/multiprecision/rational_adaptor.hpp>
 #include <boost/multiprecision/traits/is_byte_container.hpp>
@@ -27,6 +28,7 @@
 #ifdef BOOST_MP_USER_DEFINED_LITERALS
 #include <boost/multiprecision/cpp_int/value_pack.hpp>
 #endif
+#include <boost/multiprecision/cpp_int/limb_pool.hpp>
 
 namespace boost{
 namespace multiprecision{
@@ -191,6 +193,23 @@ struct cpp_int_base<MinBits, MaxBits, signed_magnitude, Checked, Allocator, fals
 
 private:
    typedef boost::empty_value<allocator_type> base_type;
+   //
+   // Stateful allocators (such as arena_allocator) may not propagate on assignment or swap, in which
+   // case storage is never exchanged between values whose allocators compare unequal, the limbs
+   // are copied instead:
+   //
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+   typedef std::allocator_traits<allocator_type>                             allocator_traits_type;
+   typedef typename allocator_traits_type::propagate_on_container_copy_assignment propagate_on_copy;
+   typedef typename allocator_traits_type::propagate_on_container_move_assignment propagate_on_move;
+   typedef typename allocator_traits_type::propagate_on_container_swap            propagate_on_swap;
+   typedef is_empty<allocator_type>                                          allocator_always_equal;
+#else
+   typedef mpl::true_ propagate_on_copy;
+   typedef mpl::true_ propagate_on_move;
+   typedef mpl::true_ propagate_on_swap;
+   typedef mpl::true_ allocator_always_equal;
+#endif
 
    struct limb_data
    {
@@ -298,7 +317,12 @@ public:
       while((m_limbs-1) && !p[m_limbs - 1])--m_limbs;
    }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR cpp_int_base() BOOST_NOEXCEPT : m_data(), m_limbs(1), m_sign(false), m_internal(true) {}
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+   BOOST_MP_FORCEINLINE cpp_int_base(const cpp_int_base& o)
+      : base_type(boost::empty_init_t(), allocator_traits_type::select_on_container_copy_construction(o.allocator())), m_limbs(0), m_internal(true)
+#else
    BOOST_MP_FORCEINLINE cpp_int_base(const cpp_int_base& o) : base_type(o), m_limbs(0), m_internal(true)
+#endif
    {
       resize(o.size(), o.size());
       std::memcpy(limbs(), o.limbs(), o.size() * sizeof(limbs()[0]));
@@ -319,8 +343,14 @@ public:
          o.m_internal = true;
       }
    }
-   cpp_int_base& operator = (cpp_int_base&& o) BOOST_NOEXCEPT
+   cpp_int_base& operator = (cpp_int_base&& o) BOOST_MP_NOEXCEPT_IF(propagate_on_move::value || allocator_always_equal::value)
    {
+      if(!propagate_on_move::value && !shares_allocator(o))
+      {
+         // Our allocator can't take over o's storage:
+         assign(o);
+         return *this;
+      }
       if(!m_internal)
          allocator().deallocate(m_data.ld.data, m_data.ld.capacity);
       *static_cast<base_type*>(this) = static_cast<base_type&&>(o);
@@ -349,7 +379,15 @@ public:
    {
       if(this != &o)
       {
-         static_cast<base_type&>(*this) = static_cast<const base_type&>(o);
+         if(propagate_on_copy::value)
+         {
+            if(!m_internal && !shares_allocator(o))
+            {
+               allocator().deallocate(limbs(), capacity());
+               m_internal = true;
+            }
+            static_cast<base_type&>(*this) = static_cast<const base_type&>(o);
+         }
          m_limbs = 0;
          resize(o.size(), o.size());
          std::memcpy(limbs(), o.limbs(), o.size() * sizeof(limbs()[0]));
@@ -370,9 +408,32 @@ public:
    {
       return m_sign;
    }
-   BOOST_MP_FORCEINLINE void do_swap(cpp_int_base& o) BOOST_NOEXCEPT
+   BOOST_MP_FORCEINLINE void do_swap(cpp_int_base& o) BOOST_MP_NOEXCEPT_IF(propagate_on_swap::value || allocator_always_equal::value)
    {
-      std::swap(m_data, o.m_data);
+      if(!propagate_on_swap::value && !shares_allocator(o))
+      {
+         // Each value keeps its own allocator, so the values have to be copied:
+         cpp_int_base t(o);
+         o.assign(*this);
+         assign(t);
+         return;
+      }
+      if(propagate_on_swap::value)
+         std::swap(allocator(), o.allocator());
+      //
+      // When MinBits makes the internal buffer large, swapping the whole union is wasteful,
+      // so only the limbs in use are moved:
+      //
+      if(sizeof(m_data) <= 2 * sizeof(limb_data))
+         std::swap(m_data, o.m_data);
+      else if(m_internal && o.m_internal)
+         std::swap_ranges(m_data.la, m_data.la + (std::max)(m_limbs, o.m_limbs), o.m_data.la);
+      else if(m_internal)
+         swap_internal_with_external(*this, o);
+      else if(o.m_internal)
+         swap_internal_with_external(o, *this);
+      else
+         std::swap(m_data.ld, o.m_data.ld);
       std::swap(m_sign, o.m_sign);
       std::swap(m_internal, o.m_internal);
       std::swap(m_limbs, o.m_limbs);
@@ -380,6 +441,17 @@ public:
 protected:
    template <class A>
    void check_in_range(const A&) BOOST_NOEXCEPT {}
+private:
+   bool shares_allocator(const cpp_int_base& o)const BOOST_NOEXCEPT
+   {
+      return allocator_always_equal::value || (allocator() == o.allocator());
+   }
+   static void swap_internal_with_external(cpp_int_base& i, cpp_int_base& e) BOOST_NOEXCEPT
+   {
+      limb_data ld = e.m_data.ld;
+      std::memcpy(e.m_data.la, i.m_data.la, i.m_limbs * sizeof(limb_type));
+      i.m_data.ld = ld;
+   }
 };
 
 #ifndef BOOST_NO_INCLASS_MEMBER_INITIALIZATION
@@ -1500,8 +1572,14 @@ private:
          else
          {
             // Base 10, we extract blocks of size 10^9 at a time, that way
-            // the number of multiplications is kept to a minimum:
+            // the number of multiplications is kept to a minimum, long strings
+            // are split in two recursively:
             limb_type block_mult = max_block_10;
+            if(n >= BOOST_MP_DECIMAL_DC_CUTOFF * digits_per_block_10)
+            {
+               decimal_parse(result, s, n);
+               s += n;
+            }
             while(*s)
             {
                limb_type block = 0;
@@ -1535,7 +1613,7 @@ public:
       do_assign_string(s, trivial_tag());
       return *this;
    }
-   BOOST_MP_FORCEINLINE void swap(cpp_int_backend& o) BOOST_NOEXCEPT
+   BOOST_MP_FORCEINLINE void swap(cpp_int_backend& o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<base_type&>().do_swap(std::declval<base_type&>())))
    {
       this->do_swap(o);
    }
@@ -1694,38 +1772,14 @@ private:
       else
       {
          result.assign(Bits / 3 + 1, '0');
-         std::string::difference_type pos = result.size() - 1;
-         cpp_int_backend t(*this);
-         cpp_int_backend r;
-         bool neg = false;
-         if(t.sign())
-         {
-            t.negate();
-            neg = true;
-         }
+         bool neg = this->sign();
          if(this->size() == 1)
          {
-            result = boost::lexical_cast<std::string>(t.limbs()[0]);
+            result = boost::lexical_cast<std::string>(this->limbs()[0]);
          }
          else
          {
-            cpp_int_backend block10;
-            block10 = max_block_10;
-            while(eval_get_sign(t) != 0)
-            {
-               cpp_int_backend t2;
-               divide_unsigned_helper(&t2, t, block10, r);
-               t = t2;
-               limb_type v = r.limbs()[0];
-               for(unsigned i = 0; i < digits_per_block_10; ++i)
-               {
-                  char c = '0' + v % 10;
-                  v /= 10;
-                  result[pos] = c;
-                  if(pos-- == 0)
-                     break;
-               }
-            }
+            decimal_digits(&result[0], result.size(), *this);
          }
          std::string::size_type n = result.find_first_not_of('0');
          result.erase(0, n);
@@ -1922,6 +1976,10 @@ struct number_category<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allo
 typedef number<cpp_int_backend<> >                   cpp_int;
 typedef rational_adaptor<cpp_int_backend<> >         cpp_rational_backend;
 typedef number<cpp_rational_backend>                 cpp_rational;
+#ifdef BOOST_MP_HAS_LIMB_POOL
+// As cpp_int, but with storage from the per-thread limb pool:
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, limb_pool_allocator<limb_type> > > cpp_int_pooled;
+#endif
 
 // Fixed precision unsigned types:
 typedef number<cpp_int_backend<128, 128, unsigned_magnitude, unchecked, void> >   uint128_t;
@@ -1970,17 +2028,23 @@ struct is_explicitly_convertible<cpp_int_backend<MinBits, MaxBits, SignType, Che
 //
 // Last of all we include the implementations of all the eval_* non member functions:
 //
+#include <boost/multiprecision/cpp_int/limb_kernels.hpp>
+#include <boost/multiprecision/cpp_int/bitwise_kernels.hpp>
 #include <boost/multiprecision/cpp_int/comparison.hpp>
 #include <boost/multiprecision/cpp_int/add.hpp>
 #include <boost/multiprecision/cpp_int/multiply.hpp>
 #include <boost/multiprecision/cpp_int/divide.hpp>
 #include <boost/multiprecision/cpp_int/bitwise.hpp>
 #include <boost/multiprecision/cpp_int/misc.hpp>
+#include <boost/multiprecision/cpp_int/modular.hpp>
+#include <boost/multiprecision/cpp_int/decimal.hpp>
+#include <boost/multiprecision/cpp_int/sqrt.hpp>
 #include <boost/multiprecision/cpp_int/limits.hpp>
 #ifdef BOOST_MP_USER_DEFINED_LITERALS
 #include <boost/multiprecision/cpp_int/literals.hpp>
 #endif
 #include <boost/multiprecision/cpp_int/serialize.hpp>
 #include <boost/multiprecision/cpp_int/import_export.hpp>
+#include <boost/multiprecision/cpp_int/view.hpp>
 
 #endif
@@ -23,8 +23,6 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
 {
    using std::swap;
 
-   // Nothing fancy, just let uintmax_t take the strain:
-   double_limb_type carry = 0;
    unsigned m, x;
    unsigned as = a.size();
    unsigned bs = b.size();
@@ -46,17 +44,8 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
       swap(pa, pb);
    
    // First where a and b overlap:
-   while(pr != pr_end)
-   {
-      carry += static_cast<double_limb_type>(*pa) + static_cast<double_limb_type>(*pb);
-#ifdef __MSVC_RUNTIME_CHECKS
-      *pr = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-      *pr = static_cast<limb_type>(carry);
-#endif
-      carry >>= CppInt1::limb_bits;
-      ++pr, ++pa, ++pb;
-   }
+   limb_type carry = add_n(pr, pa, pb, m);
+   pr += m, pa += m;
    pr_end += x - m;
    // Now where only a has digits:
    while(pr != pr_end)
@@ -71,13 +60,8 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
 #endif
          break;
       }
-      carry += static_cast<double_limb_type>(*pa);
-#ifdef __MSVC_RUNTIME_CHECKS
-      *pr = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-      *pr = static_cast<limb_type>(carry);
-#endif
-      carry >>= CppInt1::limb_bits;
+      *pr = *pa + carry;
+      carry = *pr < carry;
       ++pr, ++pa;
    }
    if(carry)
@@ -85,7 +69,7 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
       // We overflowed, need to add one more limb:
       result.resize(x + 1, x + 1);
       if(result.size() > x)
-         result.limbs()[x] = static_cast<limb_type>(carry);
+         result.limbs()[x] = carry;
    }
    result.normalize();
    result.sign(a.sign());
@@ -140,8 +124,6 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const CppInt3&
 {
    using std::swap;
 
-   // Nothing fancy, just let uintmax_t take the strain:
-   double_limb_type borrow = 0;
    unsigned m, x;
    minmax(a.size(), b.size(), m, x);
    //
@@ -182,21 +164,15 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const CppInt3&
       return;
    }
    
-   unsigned i = 0;
    // First where a and b overlap:
-   while(i < m)
-   {
-      borrow = static_cast<double_limb_type>(pa[i]) - static_cast<double_limb_type>(pb[i]) - borrow;
-      pr[i] = static_cast<limb_type>(borrow);
-      borrow = (borrow >> CppInt1::limb_bits) & 1u;
-      ++i;
-   }
+   limb_type borrow = sub_n(pr, pa, pb, m);
+   unsigned i = m;
    // Now where only a has digits, only as long as we've borrowed:
    while(borrow && (i < x))
    {
-      borrow = static_cast<double_limb_type>(pa[i]) - borrow;
-      pr[i] = static_cast<limb_type>(borrow);
-      borrow = (borrow >> CppInt1::limb_bits) & 1u;
+      limb_type t = pa[i];
+      pr[i] = t - borrow;
+      borrow = t < borrow;
       ++i;
    }
    // Any remaining digits are the same as those in pa:
@@ -45,6 +45,32 @@ template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_
 void is_valid_bitwise_op(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>&, const mpl::int_<unchecked>&){}
 
+struct bit_and{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a & b; } };
+struct bit_or { limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a | b; } };
+struct bit_xor{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a ^ b; } };
+
+//
+// r[0, n) = a[0, n) op b[0, n) using the limb vector kernels:
+//
+inline void bitwise_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n, const bit_and&) BOOST_NOEXCEPT
+{
+   and_n(r, a, b, n);
+}
+inline void bitwise_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n, const bit_or&) BOOST_NOEXCEPT
+{
+   or_n(r, a, b, n);
+}
+inline void bitwise_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n, const bit_xor&) BOOST_NOEXCEPT
+{
+   xor_n(r, a, b, n);
+}
+template <class Op>
+inline void bitwise_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n, const Op& op) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      r[i] = op(a[i], b[i]);
+}
+
 template <class CppInt1, class CppInt2, class Op>
 void bitwise_op(
    CppInt1& result,
@@ -84,8 +110,7 @@ void bitwise_op(
    {
       if(!o.sign())
       {
-         for(unsigned i = 0; i < os; ++i)
-            pr[i] = op(pr[i], po[i]);
+         bitwise_n(pr, pr, po, os, op);
          for(unsigned i = os; i < x; ++i)
             pr[i] = op(pr[i], limb_type(0));
       }
@@ -206,18 +231,13 @@ void bitwise_op(
    for(unsigned i = rs; i < x; ++i)
       pr[i] = 0;
 
-   for(unsigned i = 0; i < os; ++i)
-      pr[i] = op(pr[i], po[i]);
+   bitwise_n(pr, pr, po, os, op);
    for(unsigned i = os; i < x; ++i)
       pr[i] = op(pr[i], limb_type(0));
 
    result.normalize();
 }
 
-struct bit_and{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a & b; } };
-struct bit_or { limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a | b; } };
-struct bit_xor{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a ^ b; } };
-
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
 BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
    eval_bitwise_and(
@@ -299,8 +319,7 @@ BOOST_MP_FORCEINLINE typename enable_if_c<is_unsigned_number<cpp_int_backend<Min
 {
    unsigned os = o.size();
    result.resize(UINT_MAX, os);
-   for(unsigned i = 0; i < os; ++i)
-      result.limbs()[i] = ~o.limbs()[i];
+   com_n(result.limbs(), o.limbs(), os);
    for(unsigned i = os; i < result.size(); ++i)
       result.limbs()[i] = ~static_cast<limb_type>(0);
    result.normalize();
@@ -382,47 +401,28 @@ inline void left_shift_generic(Int& result, double_limb_type s)
       ++rs; // Most significant limb will overflow when shifted
    rs += offset;
    result.resize(rs, rs);
-   bool truncated = result.size() != rs;
+   rs = result.size();
 
    typename Int::limb_pointer pr = result.limbs();
 
-   if(offset > rs)
+   if(offset >= rs)
    {
       // The result is shifted past the end of the result:
       result = static_cast<limb_type>(0);
       return;
    }
-
-   unsigned i = rs - result.size();
    // This code only works when shift is non-zero, otherwise we invoke undefined behaviour!
    BOOST_ASSERT(shift);
-   if(!truncated)
-   {
-      if(rs > ors + offset)
-      {
-         pr[rs - 1 - i] = pr[ors - 1 - i] >> (Int::limb_bits - shift);
-         --rs;
-      }
-      else
-      {
-         pr[rs - 1 - i] = pr[ors - 1 - i] << shift;
-         if(ors > 1)
-            pr[rs - 1 - i] |= pr[ors - 2 - i] >> (Int::limb_bits - shift);
-         ++i;
-      }
-   }
-   for(; rs - i >= 2 + offset; ++i)
-   {
-      pr[rs - 1 - i] = pr[rs - 1 - i - offset] << shift;
-      pr[rs - 1 - i] |= pr[rs - 2 - i - offset] >> (Int::limb_bits - shift);
-   }
-   if(rs - i >= 1 + offset)
-   {
-      pr[rs - 1 - i] = pr[rs - 1 - i - offset] << shift;
-      ++i;
-   }
-   for(; i < rs; ++i)
-      pr[rs - 1 - i] = 0;
+   //
+   // Shift the limbs which still fit into place from the top down, the bits shifted out of the
+   // last of them go in the next limb up if there is one:
+   //
+   unsigned count = (std::min)(ors, static_cast<unsigned>(rs - offset));
+   limb_type carry = lshift_n(pr + offset, pr, count, static_cast<unsigned>(shift));
+   if(offset + count < rs)
+      pr[offset + count] = carry;
+   for(unsigned i = 0; i < offset; ++i)
+      pr[i] = 0;
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
@@ -539,16 +539,9 @@ inline void right_shift_generic(Int& result, double_limb_type s)
          return;
       }
    }
-   unsigned i = 0;
-
    // This code only works for non-zero shift, otherwise we invoke undefined behaviour!
    BOOST_ASSERT(shift);
-   for(; i + offset + 1 < ors; ++i)
-   {
-      pr[i] = pr[i + offset] >> shift;
-      pr[i] |= pr[i + offset + 1] << (Int::limb_bits - shift);
-   }
-   pr[i] = pr[i + offset] >> shift;
+   rshift_n(pr, pr + offset, ors - static_cast<unsigned>(offset), static_cast<unsigned>(shift));
    result.resize(rs, rs);
 }
 
@@ -0,0 +1,372 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Limb vector primitives for the bitwise operations, shifts and popcount of cpp_int_backend.
+//
+#ifndef BOOST_MP_CPP_INT_BITWISE_KERNELS_HPP
+#define BOOST_MP_CPP_INT_BITWISE_KERNELS_HPP
+
+#include <boost/multiprecision/detail/bitscan.hpp>
+
+//
+// On x86-64 with GCC or clang there are SSE2 versions of these (SSE2 is always present), plus AVX2 and
+// POPCNT versions which are selected at runtime when the processor supports them.  These need 64-bit
+// limbs.  Define BOOST_MP_NO_SIMD_BITWISE to use the portable loops everywhere:
+//
+#if !defined(BOOST_MP_NO_SIMD_BITWISE) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && defined(BOOST_HAS_INT128)
+#  define BOOST_MP_HAS_SIMD_BITWISE
+#  include <immintrin.h>
+#  define BOOST_MP_TARGET_AVX2 __attribute__((target("avx2")))
+#  define BOOST_MP_TARGET_POPCNT __attribute__((target("popcnt")))
+#endif
+//
+// Vectors shorter than this many limbs don't go through the runtime dispatch:
+//
+#ifndef BOOST_MP_SIMD_BITWISE_CUTOFF
+#  define BOOST_MP_SIMD_BITWISE_CUTOFF 16
+#endif
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef BOOST_MP_HAS_SIMD_BITWISE
+
+namespace simd{
+
+BOOST_STATIC_ASSERT(sizeof(limb_type) == 8);
+
+inline bool has_avx2() BOOST_NOEXCEPT
+{
+   static const bool result = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+   return result;
+}
+inline bool has_popcnt() BOOST_NOEXCEPT
+{
+   static const bool result = (__builtin_cpu_init(), __builtin_cpu_supports("popcnt") != 0);
+   return result;
+}
+
+struct and_op
+{
+   static limb_type apply(limb_type a, limb_type b) BOOST_NOEXCEPT { return a & b; }
+   static __m128i apply(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_and_si128(a, b); }
+   BOOST_MP_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_and_si256(a, b); }
+};
+struct or_op
+{
+   static limb_type apply(limb_type a, limb_type b) BOOST_NOEXCEPT { return a | b; }
+   static __m128i apply(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_or_si128(a, b); }
+   BOOST_MP_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_or_si256(a, b); }
+};
+struct xor_op
+{
+   static limb_type apply(limb_type a, limb_type b) BOOST_NOEXCEPT { return a ^ b; }
+   static __m128i apply(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_xor_si128(a, b); }
+   BOOST_MP_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_xor_si256(a, b); }
+};
+
+template <class Op>
+inline void bitwise_n_sse2(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      __m128i x0 = Op::apply(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+      __m128i x1 = Op::apply(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 2)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 2)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), x0);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i + 2), x1);
+   }
+   for(; i < n; ++i)
+      r[i] = Op::apply(a[i], b[i]);
+}
+template <class Op>
+BOOST_MP_TARGET_AVX2 inline void bitwise_n_avx2(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned i = 0;
+   for(; i + 8 <= n; i += 8)
+   {
+      __m256i x0 = Op::apply(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+      __m256i x1 = Op::apply(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 4)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 4)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), x0);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i + 4), x1);
+   }
+   for(; i < n; ++i)
+      r[i] = Op::apply(a[i], b[i]);
+}
+
+inline void com_n_sse2(limb_type* r, const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   const __m128i ones = _mm_set1_epi32(-1);
+   unsigned i = 0;
+   for(; i + 2 <= n; i += 2)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), ones));
+   for(; i < n; ++i)
+      r[i] = ~a[i];
+}
+BOOST_MP_TARGET_AVX2 inline void com_n_avx2(limb_type* r, const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   const __m256i ones = _mm256_set1_epi32(-1);
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), ones));
+   for(; i < n; ++i)
+      r[i] = ~a[i];
+}
+//
+// The shifts combine two overlapping unaligned loads, one limb apart.  Left shifts run from the top down
+// and right shifts from the bottom up, so the destination may overlap the source in the same way as the
+// portable versions allow:
+//
+inline limb_type lshift_n_sse2(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[n - 1] >> rshift;
+   const __m128i sl = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i sr = _mm_cvtsi32_si128(static_cast<int>(rshift));
+   unsigned i = n - 1;
+   for(; i >= 2; i -= 2)
+   {
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 1));
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 2));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i - 1), _mm_or_si128(_mm_sll_epi64(hi, sl), _mm_srl_epi64(lo, sr)));
+   }
+   for(; i > 0; --i)
+      r[i] = (a[i] << shift) | (a[i - 1] >> rshift);
+   r[0] = a[0] << shift;
+   return result;
+}
+BOOST_MP_TARGET_AVX2 inline limb_type lshift_n_avx2(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[n - 1] >> rshift;
+   const __m128i sl = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i sr = _mm_cvtsi32_si128(static_cast<int>(rshift));
+   unsigned i = n - 1;
+   for(; i >= 4; i -= 4)
+   {
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - 3));
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - 4));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i - 3), _mm256_or_si256(_mm256_sll_epi64(hi, sl), _mm256_srl_epi64(lo, sr)));
+   }
+   for(; i > 0; --i)
+      r[i] = (a[i] << shift) | (a[i - 1] >> rshift);
+   r[0] = a[0] << shift;
+   return result;
+}
+inline limb_type rshift_n_sse2(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[0] << lshift;
+   const __m128i sr = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i sl = _mm_cvtsi32_si128(static_cast<int>(lshift));
+   unsigned i = 0;
+   for(; i + 3 <= n; i += 2)
+   {
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_or_si128(_mm_srl_epi64(lo, sr), _mm_sll_epi64(hi, sl)));
+   }
+   for(; i + 1 < n; ++i)
+      r[i] = (a[i] >> shift) | (a[i + 1] << lshift);
+   r[n - 1] = a[n - 1] >> shift;
+   return result;
+}
+BOOST_MP_TARGET_AVX2 inline limb_type rshift_n_avx2(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[0] << lshift;
+   const __m128i sr = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i sl = _mm_cvtsi32_si128(static_cast<int>(lshift));
+   unsigned i = 0;
+   for(; i + 5 <= n; i += 4)
+   {
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_or_si256(_mm256_srl_epi64(lo, sr), _mm256_sll_epi64(hi, sl)));
+   }
+   for(; i + 1 < n; ++i)
+      r[i] = (a[i] >> shift) | (a[i + 1] << lshift);
+   r[n - 1] = a[n - 1] >> shift;
+   return result;
+}
+//
+// Population count: SSE2 uses the usual divide and conquer bit count in each 64-bit lane, AVX2 looks up
+// the counts of each nibble with a byte shuffle (Mula's method), both then sum the bytes with psadbw:
+//
+inline unsigned popcount_n_sse2(const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   const __m128i m1 = _mm_set1_epi8(0x55);
+   const __m128i m2 = _mm_set1_epi8(0x33);
+   const __m128i m4 = _mm_set1_epi8(0x0f);
+   __m128i acc = _mm_setzero_si128();
+   unsigned i = 0;
+   for(; i + 2 <= n; i += 2)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      v = _mm_sub_epi64(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+      v = _mm_add_epi64(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+      v = _mm_and_si128(_mm_add_epi64(v, _mm_srli_epi64(v, 4)), m4);
+      acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+   }
+   unsigned result = static_cast<unsigned>(_mm_cvtsi128_si64(acc) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+   for(; i < n; ++i)
+      result += boost::multiprecision::detail::count_bits(a[i]);
+   return result;
+}
+BOOST_MP_TARGET_POPCNT inline unsigned popcount_n_popcnt(const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned result = 0;
+   for(unsigned i = 0; i < n; ++i)
+      result += static_cast<unsigned>(__builtin_popcountll(a[i]));
+   return result;
+}
+BOOST_MP_TARGET_AVX2 inline unsigned popcount_n_avx2(const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m256i low = _mm256_set1_epi8(0x0f);
+   __m256i acc = _mm256_setzero_si256();
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, low)), _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+      acc = _mm256_add_epi64(acc, _mm256_sad_epu8(c, _mm256_setzero_si256()));
+   }
+   __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+   unsigned result = static_cast<unsigned>(_mm_cvtsi128_si64(sum) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum)));
+   for(; i < n; ++i)
+      result += boost::multiprecision::detail::count_bits(a[i]);
+   return result;
+}
+
+} // namespace simd
+
+//
+// r[0, n) = a[0, n) op b[0, n), r may alias a or b:
+//
+inline void and_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      simd::bitwise_n_avx2<simd::and_op>(r, a, b, n);
+   else
+      simd::bitwise_n_sse2<simd::and_op>(r, a, b, n);
+}
+inline void or_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      simd::bitwise_n_avx2<simd::or_op>(r, a, b, n);
+   else
+      simd::bitwise_n_sse2<simd::or_op>(r, a, b, n);
+}
+inline void xor_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      simd::bitwise_n_avx2<simd::xor_op>(r, a, b, n);
+   else
+      simd::bitwise_n_sse2<simd::xor_op>(r, a, b, n);
+}
+//
+// r[0, n) = ~a[0, n), r may alias a:
+//
+inline void com_n(limb_type* r, const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      simd::com_n_avx2(r, a, n);
+   else
+      simd::com_n_sse2(r, a, n);
+}
+//
+// r[0, n) = a[0, n) << shift, returns the bits shifted out of the top limb.  0 < shift < limb bits, n > 0,
+// and r may be equal to or above a:
+//
+inline limb_type lshift_n(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      return simd::lshift_n_avx2(r, a, n, shift);
+   return simd::lshift_n_sse2(r, a, n, shift);
+}
+//
+// r[0, n) = a[0, n) >> shift, returns the bits shifted out of the bottom limb (in its high bits).
+// 0 < shift < limb bits, n > 0, and r may be equal to or below a:
+//
+inline limb_type rshift_n(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   if((n >= BOOST_MP_SIMD_BITWISE_CUTOFF) && simd::has_avx2())
+      return simd::rshift_n_avx2(r, a, n, shift);
+   return simd::rshift_n_sse2(r, a, n, shift);
+}
+//
+// The number of bits set in a[0, n):
+//
+inline unsigned popcount_n(const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+#ifndef __POPCNT__
+   if(n >= BOOST_MP_SIMD_BITWISE_CUTOFF)
+   {
+#endif
+      if(simd::has_avx2())
+         return simd::popcount_n_avx2(a, n);
+      if(simd::has_popcnt())
+         return simd::popcount_n_popcnt(a, n);
+#ifndef __POPCNT__
+   }
+   return simd::popcount_n_sse2(a, n);
+#else
+   return simd::popcount_n_popcnt(a, n);
+#endif
+}
+
+#else
+
+inline void and_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      r[i] = a[i] & b[i];
+}
+inline void or_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      r[i] = a[i] | b[i];
+}
+inline void xor_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      r[i] = a[i] ^ b[i];
+}
+inline void com_n(limb_type* r, const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      r[i] = ~a[i];
+}
+inline limb_type lshift_n(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[n - 1] >> rshift;
+   for(unsigned i = n - 1; i > 0; --i)
+      r[i] = (a[i] << shift) | (a[i - 1] >> rshift);
+   r[0] = a[0] << shift;
+   return result;
+}
+inline limb_type rshift_n(limb_type* r, const limb_type* a, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   limb_type result = a[0] << lshift;
+   for(unsigned i = 0; i + 1 < n; ++i)
+      r[i] = (a[i] >> shift) | (a[i + 1] << lshift);
+   r[n - 1] = a[n - 1] >> shift;
+   return result;
+}
+inline unsigned popcount_n(const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned result = 0;
+   for(unsigned i = 0; i < n; ++i)
+      result += boost::multiprecision::detail::count_bits(a[i]);
+   return result;
+}
+
+#endif
+
+}}} // namespaces
+
+#endif
@@ -120,6 +120,16 @@ inline limb_type block_multiplier(unsigned count)
 
 static const unsigned bits_per_limb = sizeof(limb_type) * CHAR_BIT;
 
+//
+// Values with at least this many limbs (or decimal strings with this many blocks of
+// digits_per_block_10 digits) are converted to and from decimal by splitting them
+// in half by a power of 10, so that the work is done by the subquadratic multiplication
+// and division routines:
+//
+#ifndef BOOST_MP_DECIMAL_DC_CUTOFF
+#define BOOST_MP_DECIMAL_DC_CUTOFF 160
+#endif
+
 template <class T>
 inline void minmax(const T& a, const T& b, T& aa, T& bb)
 {
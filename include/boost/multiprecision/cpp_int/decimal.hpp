@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Divide and conquer decimal string conversion for cpp_int_backend.
+//
+#ifndef BOOST_MP_CPP_INT_DECIMAL_HPP
+#define BOOST_MP_CPP_INT_DECIMAL_HPP
+
+#include <vector>
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+//
+// Divides p[0, n) in place by the single limb d and returns the remainder:
+//
+inline limb_type divide_limbs_by_limb(limb_type* p, unsigned n, limb_type d) BOOST_NOEXCEPT
+{
+   double_limb_type r = 0;
+   for(unsigned i = n; i-- > 0;)
+   {
+      r = (r << bits_per_limb) | p[i];
+      p[i] = static_cast<limb_type>(r / d);
+      r %= d;
+   }
+   return static_cast<limb_type>(r);
+}
+//
+// Writes the value p[0, n) as exactly "digits" decimal digits, right aligned, into
+// out[0, digits) which must already be filled with '0'.  Destroys p:
+//
+inline void decimal_digits_basecase(char* out, std::size_t digits, limb_type* p, unsigned n)
+{
+   char* pos = out + digits;
+   while((n > 1) || *p)
+   {
+      limb_type v = divide_limbs_by_limb(p, n, max_block_10);
+      while((n > 1) && !p[n - 1])
+         --n;
+      for(unsigned i = 0; (i < digits_per_block_10) && (pos != out); ++i)
+      {
+         *--pos = static_cast<char>('0' + v % 10);
+         v /= 10;
+      }
+   }
+}
+//
+// powers[k] = max_block_10^(2^k):
+//
+inline void decimal_digits_recursive(char* out, std::size_t digits, cpp_int_backend<>& x, const std::vector<cpp_int_backend<> >& powers)
+{
+   if(x.size() < BOOST_MP_DECIMAL_DC_CUTOFF)
+   {
+      decimal_digits_basecase(out, digits, x.limbs(), x.size());
+      return;
+   }
+   //
+   // Split by the largest power that has at most half as many limbs as x, which
+   // leaves x strictly greater than the power, so both halves are non-empty:
+   //
+   unsigned k = static_cast<unsigned>(powers.size()) - 1;
+   while(k && (powers[k].size() > (x.size() + 1) / 2))
+      --k;
+   std::size_t low = static_cast<std::size_t>(digits_per_block_10) << k;
+   BOOST_ASSERT(low < digits);
+   cpp_int_backend<> q, r;
+   divide_unsigned_helper(&q, x, powers[k], r);
+   decimal_digits_recursive(out + digits - low, low, r, powers);
+   decimal_digits_recursive(out, digits - low, q, powers);
+}
+//
+// Writes the decimal digits of |a| right aligned into out[0, digits), which must be
+// long enough and already filled with '0':
+//
+template <class CppInt>
+void decimal_digits(char* out, std::size_t digits, const CppInt& a)
+{
+   cpp_int_backend<> x;
+   x.resize(a.size(), a.size());
+   std::memcpy(x.limbs(), a.limbs(), a.size() * sizeof(limb_type));
+   x.normalize();
+   std::vector<cpp_int_backend<> > powers;
+   if(x.size() >= BOOST_MP_DECIMAL_DC_CUTOFF)
+   {
+      powers.push_back(cpp_int_backend<>(max_block_10));
+      while(powers.back().size() * 2 <= (x.size() + 1) / 2)
+      {
+         cpp_int_backend<> t;
+         eval_multiply(t, powers.back(), powers.back());
+         powers.push_back(t);
+      }
+   }
+   decimal_digits_recursive(out, digits, x, powers);
+}
+
+//
+// The value of the n decimal digits at s, one block at a time:
+//
+inline void decimal_parse_basecase(cpp_int_backend<>& result, const char* s, std::size_t n)
+{
+   std::vector<limb_type> p(n / digits_per_block_10 + 2, 0);
+   unsigned pn = 1;
+   while(n)
+   {
+      unsigned count = static_cast<unsigned>((std::min)(n, static_cast<std::size_t>(digits_per_block_10)));
+      limb_type block = 0;
+      for(unsigned i = 0; i < count; ++i, ++s)
+      {
+         if(*s < '0' || *s > '9')
+            BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected character encountered in input."));
+         block *= 10;
+         block += static_cast<limb_type>(*s - '0');
+      }
+      n -= count;
+      limb_type block_mult = count == digits_per_block_10 ? max_block_10 : block_multiplier(count - 1);
+      limb_type carry = mul_1(&p[0], &p[0], pn, block_mult);
+      for(unsigned i = 0; block && (i < pn); ++i)
+      {
+         p[i] += block;
+         block = p[i] < block;
+      }
+      carry += block;
+      if(carry)
+         p[pn++] = carry;
+   }
+   result.resize(pn, pn);
+   std::memcpy(result.limbs(), &p[0], pn * sizeof(limb_type));
+   result.normalize();
+}
+//
+// powers[k] = max_block_10^(2^k):
+//
+inline void decimal_parse_recursive(cpp_int_backend<>& result, const char* s, std::size_t n, const std::vector<cpp_int_backend<> >& powers)
+{
+   if(n < BOOST_MP_DECIMAL_DC_CUTOFF * digits_per_block_10)
+   {
+      decimal_parse_basecase(result, s, n);
+      return;
+   }
+   //
+   // The low part has digits_per_block_10 * 2^k digits, between a quarter and a half of the total:
+   //
+   unsigned k = static_cast<unsigned>(powers.size()) - 1;
+   while(k && ((static_cast<std::size_t>(digits_per_block_10) << k) > n / 2))
+      --k;
+   std::size_t low = static_cast<std::size_t>(digits_per_block_10) << k;
+   cpp_int_backend<> hi, lo;
+   decimal_parse_recursive(hi, s, n - low, powers);
+   decimal_parse_recursive(lo, s + n - low, low, powers);
+   eval_multiply(result, hi, powers[k]);
+   eval_add(result, lo);
+}
+//
+// Sets result to the value of the n decimal digits at s, the value is formed in an
+// unbounded integer so that fixed precision types truncate or throw on assignment:
+//
+template <class CppInt>
+void decimal_parse(CppInt& result, const char* s, std::size_t n)
+{
+   std::vector<cpp_int_backend<> > powers;
+   if(n >= BOOST_MP_DECIMAL_DC_CUTOFF * digits_per_block_10)
+   {
+      powers.push_back(cpp_int_backend<>(max_block_10));
+      while((static_cast<std::size_t>(digits_per_block_10) << powers.size()) <= n / 2)
+      {
+         cpp_int_backend<> t;
+         eval_multiply(t, powers.back(), powers.back());
+         powers.push_back(t);
+      }
+   }
+   cpp_int_backend<> v;
+   decimal_parse_recursive(v, s, n, powers);
+   result = v;
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+}}} // namespaces
+
+#endif
@@ -10,6 +10,233 @@
 
 namespace boost{ namespace multiprecision{ namespace backends{
 
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+//
+// Divisions by multi-limb values whose quotient has at least BOOST_MP_KNUTH_DIVIDE_CUTOFF limbs
+// normalise the divisor and use Knuth's algorithm D on the raw limbs, once both divisor and quotient
+// have at least BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF limbs the quotient is computed recursively a half at
+// a time (Burnikel and Ziegler "Fast Recursive Division"), so that the work is done by the subquadratic
+// multiplication routines:
+//
+#ifndef BOOST_MP_KNUTH_DIVIDE_CUTOFF
+#define BOOST_MP_KNUTH_DIVIDE_CUTOFF 3
+#endif
+#ifndef BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF
+#define BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF 40
+#endif
+
+//
+// Knuth's algorithm D, divides a[0, bn + k) by b[0, bn) which must be normalised (top bit set):
+// the quotient is qh * B^k + q[0, k) and the remainder is left in a[0, bn):
+//
+inline limb_type divide_limbs_basecase(limb_type* q, limb_type* a, unsigned k, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(b[bn - 1] >> (bits_per_limb - 1));
+   limb_type qh = 0;
+   if(compare_limbs(a + k, b, bn) >= 0)
+   {
+      subtract_limbs(a + k, a + k, bn, b, bn);
+      qh = 1;
+   }
+   limb_type b1 = b[bn - 1];
+   limb_type b0 = bn > 1 ? b[bn - 2] : 0;
+   for(unsigned j = k; j-- > 0;)
+   {
+      //
+      // Estimate the next quotient limb from the top 3 limbs of the remainder and the top 2 of
+      // the divisor, which is then at most 1 too large:
+      //
+      limb_type* p = a + j;
+      limb_type qhat;
+      if(p[bn] >= b1)
+         qhat = ~static_cast<limb_type>(0u);
+      else
+      {
+         double_limb_type num = (static_cast<double_limb_type>(p[bn]) << bits_per_limb) | p[bn - 1];
+         qhat = static_cast<limb_type>(num / b1);
+         double_limb_type rhat = num - static_cast<double_limb_type>(qhat) * b1;
+         limb_type next = bn > 1 ? p[bn - 2] : 0;
+         while(!(rhat >> bits_per_limb) && (static_cast<double_limb_type>(qhat) * b0 > ((rhat << bits_per_limb) | next)))
+         {
+            --qhat;
+            rhat += b1;
+         }
+      }
+      //
+      // p[0, bn] -= qhat * b:
+      //
+      limb_type carry = submul_1(p, b, bn, qhat);
+      limb_type borrow = p[bn] < carry;
+      p[bn] -= carry;
+      //
+      // Add back while the remainder is negative:
+      //
+      while(borrow)
+      {
+         --qhat;
+         limb_type c = add_limbs(p, p, bn, b, bn);
+         p[bn] += c;
+         if(p[bn] < c)
+            borrow = 0;
+      }
+      BOOST_ASSERT(p[bn] == 0);
+      q[j] = qhat;
+   }
+   return qh;
+}
+//
+// Divides a[0, bn + k) by b[0, bn) with k <= bn, as above, t must have room for bn limbs and
+// scratch for multiply_limbs_scratch_size(bn).  For k < bn the quotient is estimated by dividing
+// by the top k limbs of b and then corrected using the product with the rest, for k == bn the
+// two halves of the quotient are computed in turn:
+//
+inline limb_type divide_limbs_recursive(limb_type* q, limb_type* a, unsigned k, const limb_type* b, unsigned bn, limb_type* t, limb_type* scratch)
+{
+   BOOST_ASSERT(k <= bn);
+   if(k < BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF)
+      return divide_limbs_basecase(q, a, k, b, bn);
+   if(k == bn)
+   {
+      unsigned lo = bn / 2;
+      unsigned hi = bn - lo;
+      limb_type qh = divide_limbs_recursive(q + lo, a + lo, hi, b, bn, t, scratch);
+      limb_type ql = divide_limbs_recursive(q, a, lo, b, bn, t, scratch);
+      BOOST_ASSERT(ql == 0);
+      (void)ql;
+      return qh;
+   }
+   unsigned lo = bn - k;
+   limb_type qh = divide_limbs_recursive(q, a + lo, k, b + lo, k, t, scratch);
+   multiply_limbs_recursive(t, q, k, b, lo, scratch);
+   limb_type borrow = subtract_limbs(a, a, bn, t, bn);
+   if(qh)
+      borrow += subtract_limbs(a + k, a + k, lo, b, lo);
+   while(borrow)
+   {
+      static const limb_type one = 1;
+      qh -= subtract_limbs(q, q, k, &one, 1);
+      borrow -= add_limbs(a, a, bn, b, bn);
+   }
+   return qh;
+}
+//
+// The most working space divide_unsigned_limbs can need for operands of types CppInt2 and
+// CppInt3.  When both are fixed precision it's small enough to go on the stack, so that
+// dividing fixed precision types never allocates:
+//
+template <class CppInt2, class CppInt3>
+struct divide_scratch_on_stack
+{
+   BOOST_STATIC_CONSTANT(unsigned, limbs = 2 * (CppInt2::internal_limb_count + 1) + 2 * CppInt3::internal_limb_count + multiply_limbs_scratch_bound<CppInt3::internal_limb_count>::value);
+   BOOST_STATIC_CONSTANT(bool, value = !CppInt2::variable && !CppInt3::variable && (limbs <= BOOST_MP_MULTIPLY_STACK_LIMBS));
+};
+//
+// Sets result and r to the quotient and remainder of the magnitudes of x and y, x >= y,
+// via the raw limb routines above:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, class CppInt2, class CppInt3>
+void divide_unsigned_limbs(
+   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>* result,
+   const CppInt2& x,
+   const CppInt3& y,
+   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& r)
+{
+   typedef typename scratch_allocator_type<Allocator1>::type allocator_type;
+
+   unsigned xn = x.size();
+   unsigned bn = y.size();
+   unsigned an = xn + 1;
+   unsigned qn = an - bn + 1;
+   unsigned total = an + bn + qn + bn + multiply_limbs_scratch_size(bn);
+   //
+   // Small divisions, and all those by fixed precision types, avoid the allocation altogether:
+   //
+   static const unsigned local_size = divide_scratch_on_stack<CppInt2, CppInt3>::value ? divide_scratch_on_stack<CppInt2, CppInt3>::limbs : 64;
+   BOOST_ASSERT((!divide_scratch_on_stack<CppInt2, CppInt3>::value || (total <= local_size)));
+   limb_type local[local_size];
+   scoped_limb_storage<allocator_type> storage(scratch_allocator(r, is_void<Allocator1>()), total > local_size ? total : 0);
+   limb_type* a = total > local_size ? storage.data() : local;
+   limb_type* b = a + an;
+   limb_type* q = b + bn;
+   limb_type* t = q + qn;
+   limb_type* scratch = t + bn;
+   //
+   // Normalise so that the top bit of the divisor is set:
+   //
+   typename CppInt2::const_limb_pointer px = x.limbs();
+   typename CppInt3::const_limb_pointer py = y.limbs();
+   unsigned shift = 0;
+   while(!((py[bn - 1] << shift) >> (bits_per_limb - 1)))
+      ++shift;
+   if(shift)
+   {
+      for(unsigned i = bn - 1; i > 0; --i)
+         b[i] = (py[i] << shift) | (py[i - 1] >> (bits_per_limb - shift));
+      b[0] = py[0] << shift;
+      a[xn] = px[xn - 1] >> (bits_per_limb - shift);
+      for(unsigned i = xn - 1; i > 0; --i)
+         a[i] = (px[i] << shift) | (px[i - 1] >> (bits_per_limb - shift));
+      a[0] = px[0] << shift;
+   }
+   else
+   {
+      std::memcpy(b, py, bn * sizeof(limb_type));
+      std::memcpy(a, px, xn * sizeof(limb_type));
+      a[xn] = 0;
+   }
+   //
+   // The quotient is found a block of bn limbs at a time from the top, starting with any
+   // partial block.  Only the first block can produce a high quotient limb, which also
+   // takes care of the top limb of a when normalisation didn't need it:
+   //
+   if(!a[xn])
+   {
+      --an;
+      q[--qn] = 0;
+   }
+   unsigned k = (an - bn) % bn;
+   if(!k && (an > bn))
+      k = bn;
+   unsigned pos = an - bn - k;
+   q[an - bn] = divide_limbs_recursive(q + pos, a + pos, k, b, bn, t, scratch);
+   while(pos)
+   {
+      pos -= bn;
+      limb_type qh = divide_limbs_recursive(q + pos, a + pos, bn, b, bn, t, scratch);
+      BOOST_ASSERT(qh == 0);
+      (void)qh;
+   }
+   //
+   // Denormalise the remainder:
+   //
+   if(shift)
+   {
+      for(unsigned i = 0; i < bn - 1; ++i)
+         a[i] = (a[i] >> shift) | (a[i + 1] << (bits_per_limb - shift));
+      a[bn - 1] >>= shift;
+   }
+   unsigned rn = bn;
+   while((rn > 1) && !a[rn - 1])
+      --rn;
+   r.resize(rn, rn);
+   std::memcpy(r.limbs(), a, r.size() * sizeof(limb_type));
+   r.sign(false);
+   r.normalize();
+   if(result)
+   {
+      while((qn > 1) && !q[qn - 1])
+         --qn;
+      result->resize(qn, qn);
+      std::memcpy(result->limbs(), q, result->size() * sizeof(limb_type));
+      result->sign(false);
+      result->normalize();
+   }
+}
+
 template <class CppInt1, class CppInt2, class CppInt3>
 void divide_unsigned_helper(
    CppInt1* result, 
@@ -31,8 +258,9 @@ void divide_unsigned_helper(
    }
 
    /*
-    Very simple, fairly braindead long division.
-    Start by setting the remainder equal to x, and the
+    Long division for quotients of fewer than BOOST_MP_KNUTH_DIVIDE_CUTOFF limbs
+    (one or two by default), larger quotients are handed off to divide_unsigned_limbs
+    below.  Start by setting the remainder equal to x, and the
     result equal to 0.  Then in each loop we calculate our
     "best guess" for how many times y divides into r,
     add our guess to the result, and subtract guess*y
@@ -42,9 +270,7 @@ void divide_unsigned_helper(
     is determined by dividing the most-significant-limb of the
     current remainder by the most-significant-limb of y.
 
-    Note that there are more efficient algorithms than this
-    available, in particular see Knuth Vol 2.  However for small
-    numbers of limbs this generally outperforms the alternatives
+    For such short quotients this is quicker than Knuth's algorithm D,
     and avoids the normalisation step which would require extra storage.
     */
 
@@ -105,6 +331,12 @@ void divide_unsigned_helper(
       }
    }
 
+   if(r_order - y_order + 1 >= BOOST_MP_KNUTH_DIVIDE_CUTOFF)
+   {
+      divide_unsigned_limbs(result, x, y, r);
+      return;
+   }
+
    CppInt1 t;
    bool r_neg = false;
 
@@ -218,29 +450,15 @@ void divide_unsigned_helper(
       // Calculate guess * y, we use a fused mutiply-shift O(N) for this
       // rather than a full O(N^2) multiply:
       //
-      double_limb_type carry = 0;
       t.resize(y.size() + shift + 1, y.size() + shift);
       bool truncated_t = (t.size() != y.size() + shift + 1);
       typename CppInt1::limb_pointer pt = t.limbs();
       for(unsigned i = 0; i < shift; ++i)
          pt[i] = 0;
-      for(unsigned i = 0; i < y.size(); ++i)
-      {
-         carry += static_cast<double_limb_type>(py[i]) * static_cast<double_limb_type>(guess);
-#ifdef __MSVC_RUNTIME_CHECKS
-         pt[i + shift] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-         pt[i + shift] = static_cast<limb_type>(carry);
-#endif
-         carry >>= CppInt1::limb_bits;
-      }
+      limb_type carry = mul_1(pt + shift, py, y.size(), guess);
       if(carry && !truncated_t)
       {
-#ifdef __MSVC_RUNTIME_CHECKS
-         pt[t.size() - 1] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-         pt[t.size() - 1] = static_cast<limb_type>(carry);
-#endif
+         pt[t.size() - 1] = carry;
       }
       else if(!truncated_t)
       {
@@ -650,6 +868,10 @@ BOOST_MP_FORCEINLINE typename enable_if_c<
    result.sign(result.sign());
 }
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 }}} // namespaces
 
 #endif
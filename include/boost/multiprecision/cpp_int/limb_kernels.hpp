@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Limb vector primitives for cpp_int_backend, all the inner loops of addition,
+// subtraction, multiplication and division are built from these:
+//
+#ifndef BOOST_MP_CPP_INT_LIMB_KERNELS_HPP
+#define BOOST_MP_CPP_INT_LIMB_KERNELS_HPP
+
+//
+// The portable versions let double_limb_type take the strain, compilers don't turn those
+// into carry chains though.  Defining BOOST_MP_USE_LIMB_INTRINSICS before including cpp_int.hpp
+// selects versions built on the x86-64 _addcarry_u64 / _subborrow_u64 intrinsics instead, and
+// on _mulx_u64 too when BMI2 instructions are enabled (for example with -mbmi2 or -march=native):
+//
+#if defined(BOOST_MP_USE_LIMB_INTRINSICS) && defined(BOOST_HAS_INT128) && (defined(__x86_64__) || defined(_M_X64))
+#  define BOOST_MP_HAS_LIMB_INTRINSICS
+#  include <immintrin.h>
+#endif
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef BOOST_MP_HAS_LIMB_INTRINSICS
+
+BOOST_STATIC_ASSERT(sizeof(limb_type) == sizeof(unsigned long long));
+
+BOOST_MP_FORCEINLINE unsigned char addcarry_limb(unsigned char carry, limb_type a, limb_type b, limb_type* r) BOOST_NOEXCEPT
+{
+   return _addcarry_u64(carry, a, b, reinterpret_cast<unsigned long long*>(r));
+}
+BOOST_MP_FORCEINLINE unsigned char subborrow_limb(unsigned char borrow, limb_type a, limb_type b, limb_type* r) BOOST_NOEXCEPT
+{
+   return _subborrow_u64(borrow, a, b, reinterpret_cast<unsigned long long*>(r));
+}
+//
+// Returns the low half of a * b and sets hi to the high half:
+//
+BOOST_MP_FORCEINLINE limb_type multiply_limb(limb_type a, limb_type b, limb_type* hi) BOOST_NOEXCEPT
+{
+#ifdef __BMI2__
+   return _mulx_u64(a, b, reinterpret_cast<unsigned long long*>(hi));
+#else
+   double_limb_type p = static_cast<double_limb_type>(a) * static_cast<double_limb_type>(b);
+   *hi = static_cast<limb_type>(p >> bits_per_limb);
+   return static_cast<limb_type>(p);
+#endif
+}
+//
+// r[0, n) = a[0, n) + b[0, n), returns the carry, r may alias a or b:
+//
+inline limb_type add_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned char carry = 0;
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      carry = addcarry_limb(carry, a[i], b[i], r + i);
+      carry = addcarry_limb(carry, a[i + 1], b[i + 1], r + i + 1);
+      carry = addcarry_limb(carry, a[i + 2], b[i + 2], r + i + 2);
+      carry = addcarry_limb(carry, a[i + 3], b[i + 3], r + i + 3);
+   }
+   for(; i < n; ++i)
+      carry = addcarry_limb(carry, a[i], b[i], r + i);
+   return carry;
+}
+//
+// r[0, n) = a[0, n) - b[0, n), returns the borrow, r may alias a or b:
+//
+inline limb_type sub_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned char borrow = 0;
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      borrow = subborrow_limb(borrow, a[i], b[i], r + i);
+      borrow = subborrow_limb(borrow, a[i + 1], b[i + 1], r + i + 1);
+      borrow = subborrow_limb(borrow, a[i + 2], b[i + 2], r + i + 2);
+      borrow = subborrow_limb(borrow, a[i + 3], b[i + 3], r + i + 3);
+   }
+   for(; i < n; ++i)
+      borrow = subborrow_limb(borrow, a[i], b[i], r + i);
+   return borrow;
+}
+//
+// r[0, n) = a[0, n) * b, returns the high limb, r may alias a:
+//
+inline limb_type mul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   limb_type hi = 0, prev = 0;
+   unsigned char carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      limb_type lo = multiply_limb(a[i], b, &hi);
+      carry = addcarry_limb(carry, lo, prev, r + i);
+      prev = hi;
+   }
+   return prev + carry;
+}
+//
+// r[0, n) += a[0, n) * b, returns the carry limb.  The high halves of the products are carried
+// in a register so that only the additions into r use the carry flag:
+//
+inline limb_type addmul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   limb_type carry = 0;
+   unsigned char c = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      double_limb_type p = static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(b) + carry;
+      carry = static_cast<limb_type>(p >> bits_per_limb);
+      c = addcarry_limb(c, r[i], static_cast<limb_type>(p), r + i);
+   }
+   return carry + c;
+}
+//
+// r[0, n) -= a[0, n) * b, returns the borrow limb:
+//
+inline limb_type submul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   limb_type carry = 0;
+   unsigned char c = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      double_limb_type p = static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(b) + carry;
+      carry = static_cast<limb_type>(p >> bits_per_limb);
+      c = subborrow_limb(c, r[i], static_cast<limb_type>(p), r + i);
+   }
+   return carry + c;
+}
+
+#else
+
+inline limb_type add_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(a[i]) + static_cast<double_limb_type>(b[i]);
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      r[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= bits_per_limb;
+   }
+   return static_cast<limb_type>(carry);
+}
+inline limb_type sub_n(limb_type* r, const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   double_limb_type borrow = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      borrow = static_cast<double_limb_type>(a[i]) - static_cast<double_limb_type>(b[i]) - borrow;
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[i] = static_cast<limb_type>(borrow & ~static_cast<limb_type>(0));
+#else
+      r[i] = static_cast<limb_type>(borrow);
+#endif
+      borrow = (borrow >> bits_per_limb) & 1u;
+   }
+   return static_cast<limb_type>(borrow);
+}
+inline limb_type mul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(b);
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      r[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= bits_per_limb;
+   }
+   return static_cast<limb_type>(carry);
+}
+inline limb_type addmul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(b) + r[i];
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      r[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= bits_per_limb;
+   }
+   return static_cast<limb_type>(carry);
+}
+inline limb_type submul_1(limb_type* r, const limb_type* a, unsigned n, limb_type b) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   limb_type borrow = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(b);
+      limb_type lo = static_cast<limb_type>(carry);
+      carry >>= bits_per_limb;
+      limb_type t = r[i] - lo;
+      limb_type bw = r[i] < lo;
+      r[i] = t - borrow;
+      borrow = bw | (t < borrow);
+   }
+   return static_cast<limb_type>(carry + borrow);
+}
+
+#endif
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,266 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// A thread local, size class segregated pool for the limb storage of cpp_int and friends.
+//
+#ifndef BOOST_MP_CPP_INT_LIMB_POOL_HPP
+#define BOOST_MP_CPP_INT_LIMB_POOL_HPP
+
+#include <boost/config.hpp>
+#include <boost/multiprecision/detail/bitscan.hpp>
+#include <cstddef>
+#include <new>
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+#  define BOOST_MP_HAS_LIMB_POOL
+#endif
+
+//
+// Blocks of up to BOOST_MP_LIMB_POOL_MAX_BYTES bytes are cached, in size classes which are powers of 2,
+// and each thread keeps at most BOOST_MP_LIMB_POOL_MAX_BLOCKS free blocks of each size:
+//
+#ifndef BOOST_MP_LIMB_POOL_MAX_BYTES
+#  define BOOST_MP_LIMB_POOL_MAX_BYTES 131072
+#endif
+#ifndef BOOST_MP_LIMB_POOL_MAX_BLOCKS
+#  define BOOST_MP_LIMB_POOL_MAX_BLOCKS 64
+#endif
+
+#ifdef BOOST_MP_HAS_LIMB_POOL
+
+namespace boost{ namespace multiprecision{
+
+struct limb_pool_statistics
+{
+   std::size_t hits;          // Allocations served from the pool.
+   std::size_t misses;        // Allocations passed on to operator new.
+   std::size_t cached_blocks; // Free blocks currently held by the pool.
+   std::size_t cached_bytes;  // Total size of those blocks.
+};
+
+namespace detail{
+
+class limb_pool
+{
+public:
+   limb_pool() BOOST_NOEXCEPT
+   {
+      for(unsigned i = 0; i < size_classes; ++i)
+      {
+         m_free[i] = 0;
+         m_count[i] = 0;
+      }
+      m_stats.hits = m_stats.misses = m_stats.cached_blocks = m_stats.cached_bytes = 0;
+   }
+   ~limb_pool()
+   {
+      release();
+      destroyed() = true;
+   }
+   //
+   // The pool for the current thread, or null once the thread's pool has been destroyed
+   // (for example when a value with static storage duration is destroyed after it):
+   //
+   static limb_pool* instance()
+   {
+      if(destroyed())
+         return 0;
+      static thread_local limb_pool pool;
+      return &pool;
+   }
+
+   void* allocate(std::size_t bytes)
+   {
+      unsigned c = size_class(bytes);
+      if(c < size_classes)
+      {
+         if(free_block* p = m_free[c])
+         {
+            m_free[c] = p->next;
+            --m_count[c];
+            ++m_stats.hits;
+            --m_stats.cached_blocks;
+            m_stats.cached_bytes -= class_bytes(c);
+            return p;
+         }
+      }
+      ++m_stats.misses;
+      return ::operator new(block_bytes(bytes));
+   }
+   void deallocate(void* p, std::size_t bytes) BOOST_NOEXCEPT
+   {
+      unsigned c = size_class(bytes);
+      if((c < size_classes) && (m_count[c] < BOOST_MP_LIMB_POOL_MAX_BLOCKS))
+      {
+         free_block* b = static_cast<free_block*>(p);
+         b->next = m_free[c];
+         m_free[c] = b;
+         ++m_count[c];
+         ++m_stats.cached_blocks;
+         m_stats.cached_bytes += class_bytes(c);
+      }
+      else
+         ::operator delete(p);
+   }
+   //
+   // Returns all the cached blocks to operator delete:
+   //
+   void release() BOOST_NOEXCEPT
+   {
+      for(unsigned i = 0; i < size_classes; ++i)
+      {
+         while(free_block* p = m_free[i])
+         {
+            m_free[i] = p->next;
+            ::operator delete(p);
+         }
+         m_count[i] = 0;
+      }
+      m_stats.cached_blocks = m_stats.cached_bytes = 0;
+   }
+   limb_pool_statistics& statistics() BOOST_NOEXCEPT { return m_stats; }
+   //
+   // The size actually allocated for a request of bytes: any block which may later join a free list
+   // must be the full size of its class, even when it was allocated without a pool:
+   //
+   static std::size_t block_bytes(std::size_t bytes) BOOST_NOEXCEPT
+   {
+      unsigned c = size_class(bytes);
+      return c < size_classes ? class_bytes(c) : bytes;
+   }
+
+private:
+   struct free_block
+   {
+      free_block* next;
+   };
+   //
+   // Size class c holds blocks of min_bytes << c bytes, the smallest must have room for the free list link:
+   //
+   BOOST_STATIC_CONSTANT(std::size_t, min_bytes = sizeof(free_block) < 8 ? 8 : sizeof(free_block));
+   BOOST_STATIC_CONSTANT(unsigned, size_classes = 32);
+
+   static std::size_t class_bytes(unsigned c) BOOST_NOEXCEPT
+   {
+      return static_cast<std::size_t>(min_bytes) << c;
+   }
+   //
+   // Returns size_classes for blocks which are too large to be cached:
+   //
+   static unsigned size_class(std::size_t bytes) BOOST_NOEXCEPT
+   {
+      if(bytes > BOOST_MP_LIMB_POOL_MAX_BYTES)
+         return size_classes;
+      if(bytes <= min_bytes)
+         return 0;
+      return boost::multiprecision::detail::find_msb((bytes - 1) / min_bytes) + 1;
+   }
+   static bool& destroyed() BOOST_NOEXCEPT
+   {
+      static thread_local bool b = false;
+      return b;
+   }
+
+   free_block*          m_free[size_classes];
+   unsigned             m_count[size_classes];
+   limb_pool_statistics m_stats;
+};
+
+} // namespace detail
+
+//
+// An allocator which takes its memory from the pool for the current thread.  Memory may be
+// freed on a different thread to the one which allocated it, in which case it joins the
+// pool of the thread which freed it:
+//
+template <class T>
+class limb_pool_allocator
+{
+public:
+   typedef T              value_type;
+   typedef T*             pointer;
+   typedef const T*       const_pointer;
+   typedef T&             reference;
+   typedef const T&       const_reference;
+   typedef std::size_t    size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef limb_pool_allocator<U> other;
+   };
+
+   limb_pool_allocator() BOOST_NOEXCEPT {}
+   template <class U>
+   limb_pool_allocator(const limb_pool_allocator<U>&) BOOST_NOEXCEPT {}
+
+   T* allocate(std::size_t n)
+   {
+      if(detail::limb_pool* pool = detail::limb_pool::instance())
+         return static_cast<T*>(pool->allocate(n * sizeof(T)));
+      return static_cast<T*>(::operator new(detail::limb_pool::block_bytes(n * sizeof(T))));
+   }
+   void deallocate(T* p, std::size_t n) BOOST_NOEXCEPT
+   {
+      if(detail::limb_pool* pool = detail::limb_pool::instance())
+         pool->deallocate(p, n * sizeof(T));
+      else
+         ::operator delete(p);
+   }
+   std::size_t max_size()const BOOST_NOEXCEPT
+   {
+      return static_cast<std::size_t>(-1) / sizeof(T);
+   }
+   void construct(T* p, const T& val)
+   {
+      ::new(static_cast<void*>(p)) T(val);
+   }
+   void destroy(T* p)
+   {
+      p->~T();
+   }
+};
+
+template <class T, class U>
+inline bool operator == (const limb_pool_allocator<T>&, const limb_pool_allocator<U>&) BOOST_NOEXCEPT
+{
+   return true;
+}
+template <class T, class U>
+inline bool operator != (const limb_pool_allocator<T>&, const limb_pool_allocator<U>&) BOOST_NOEXCEPT
+{
+   return false;
+}
+
+//
+// Statistics for the pool of the current thread:
+//
+inline limb_pool_statistics get_limb_pool_statistics()
+{
+   limb_pool_statistics result = { 0, 0, 0, 0 };
+   if(detail::limb_pool* pool = detail::limb_pool::instance())
+      result = pool->statistics();
+   return result;
+}
+inline void reset_limb_pool_statistics()
+{
+   if(detail::limb_pool* pool = detail::limb_pool::instance())
+      pool->statistics().hits = pool->statistics().misses = 0;
+}
+//
+// Frees the blocks cached by the pool of the current thread:
+//
+inline void release_limb_pool()
+{
+   if(detail::limb_pool* pool = detail::limb_pool::instance())
+      pool->release();
+}
+
+}} // namespaces
+
+#endif
+
+#endif
@@ -230,6 +230,20 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    return eval_msb_imp(a);
 }
 
+//
+// Get the number of bits set:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, unsigned>::type
+   eval_popcount(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a)
+{
+   if(a.sign())
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Counting the bits in negative values is not supported - results are undefined."));
+   }
+   return popcount_n(a.limbs(), a.size());
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, bool>::type
    eval_bit_test(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& val, unsigned index) BOOST_NOEXCEPT
@@ -394,6 +408,484 @@ inline double_limb_type integer_gcd_reduce(double_limb_type u, double_limb_type
    return u;
 }
 
+//
+// Lehmer and half-GCD reduction of multi-limb values.
+//
+// Values of at least BOOST_MP_HGCD_CUTOFF limbs are reduced with the subquadratic half-GCD (Moller
+// "On Schonhage's algorithm and subquadratic integer GCD computation"), smaller ones with Lehmer's
+// algorithm on the leading two limbs.  Both can keep track of the cofactor of the first argument,
+// so that Bezout coefficients and modular inverses come from the same code:
+//
+#ifndef BOOST_MP_HGCD_CUTOFF
+#define BOOST_MP_HGCD_CUTOFF 200
+#endif
+
+//
+// Returns bits [k, k + 2 * bits_per_limb) of p[0, n):
+//
+inline double_limb_type extract_double_limb(const limb_type* p, unsigned n, unsigned k) BOOST_NOEXCEPT
+{
+   unsigned i = k / bits_per_limb;
+   unsigned shift = k % bits_per_limb;
+   limb_type l0 = i < n ? p[i] : 0;
+   limb_type l1 = i + 1 < n ? p[i + 1] : 0;
+   double_limb_type r = (static_cast<double_limb_type>(l1) << bits_per_limb) | l0;
+   r >>= shift;
+   if(shift && (i + 2 < n))
+      r |= static_cast<double_limb_type>(p[i + 2]) << (2 * bits_per_limb - shift);
+   return r;
+}
+//
+// Lehmer's algorithm (Knuth 4.5.2, algorithm L) recast without swaps: given the leading bits ah and bh
+// of two values a and b, both taken from bit k upwards, finds the matrix m = [m0 m1; m2 m3] with single
+// limb entries and determinant 1 such that (a, b) = m (a', b'), where (a', b') is reached from (a, b) by
+// repeatedly subtracting a multiple of the smaller value from the larger.  Only steps whose quotients
+// are fixed by the leading bits, and which leave both values at least t * 2^k, are taken.  Returns
+// false if there were none:
+//
+inline bool lehmer_matrix(double_limb_type ah, double_limb_type bh, double_limb_type t, limb_type* m) BOOST_NOEXCEPT
+{
+   static const double_limb_type max_entry = static_cast<limb_type>(~static_cast<limb_type>(0u));
+   //
+   // (px, py) = m^-1 (ah, bh + 1) and (qx, qy) = m^-1 (ah + 1, bh) bound the reduced values,
+   // px <= a' / 2^k < qx and qy <= b' / 2^k < py:
+   //
+   signed_double_limb_type px = ah, py = bh + 1, qx = ah + 1, qy = bh;
+   signed_double_limb_type st = t;
+   double_limb_type m0 = 1, m1 = 0, m2 = 0, m3 = 1;
+   bool progress = false;
+   for(;;)
+   {
+      if((px >= py) && (qy > 0))
+      {
+         // a' > b' and a' -= q * b':
+         signed_double_limb_type q = px / py;
+         if((q != qx / qy) || (px - q * py < st) || (static_cast<double_limb_type>(q) > max_entry))
+            break;
+         double_limb_type n1 = m1 + static_cast<double_limb_type>(q) * m0;
+         double_limb_type n3 = m3 + static_cast<double_limb_type>(q) * m2;
+         if((n1 > max_entry) || (n3 > max_entry))
+            break;
+         px -= q * py;
+         qx -= q * qy;
+         m1 = n1;
+         m3 = n3;
+      }
+      else if((qy >= qx) && (px > 0))
+      {
+         // b' > a' and b' -= q * a':
+         signed_double_limb_type q = qy / qx;
+         if((q != py / px) || (qy - q * qx < st) || (static_cast<double_limb_type>(q) > max_entry))
+            break;
+         double_limb_type n0 = m0 + static_cast<double_limb_type>(q) * m1;
+         double_limb_type n2 = m2 + static_cast<double_limb_type>(q) * m3;
+         if((n0 > max_entry) || (n2 > max_entry))
+            break;
+         py -= q * px;
+         qy -= q * qx;
+         m0 = n0;
+         m2 = n2;
+      }
+      else
+         break;
+      progress = true;
+   }
+   m[0] = static_cast<limb_type>(m0);
+   m[1] = static_cast<limb_type>(m1);
+   m[2] = static_cast<limb_type>(m2);
+   m[3] = static_cast<limb_type>(m3);
+   return progress;
+}
+//
+// Finds the Lehmer matrix for the non-zero values a and b, taking only steps which leave both at
+// least 2^min_bits:
+//
+template <class CppInt>
+bool find_lehmer_matrix(const CppInt& a, const CppInt& b, unsigned min_bits, limb_type* m) BOOST_NOEXCEPT
+{
+   static const unsigned lehmer_bits = 2 * bits_per_limb - 2;
+   unsigned n = (std::max)(a.size(), b.size());
+   limb_type top = (std::max)(a.size() == n ? a.limbs()[n - 1] : 0, b.size() == n ? b.limbs()[n - 1] : 0);
+   unsigned bits = (n - 1) * bits_per_limb + boost::multiprecision::detail::find_msb(top) + 1;
+   unsigned k = bits > lehmer_bits ? bits - lehmer_bits : 0;
+   if(min_bits >= k + lehmer_bits)
+      return false;
+   double_limb_type t = min_bits > k ? static_cast<double_limb_type>(1u) << (min_bits - k) : 1u;
+   return lehmer_matrix(extract_double_limb(a.limbs(), a.size(), k), extract_double_limb(b.limbs(), b.size(), k), t, m);
+}
+//
+// r[0, n) = x[0, xn) * mx - y[0, yn) * my, the caller guarantees that the result is non-negative
+// and fits in n limbs, r may alias x or y:
+//
+inline void multiply_subtract_limbs(limb_type* r, unsigned n, const limb_type* x, unsigned xn, limb_type mx, const limb_type* y, unsigned yn, limb_type my) BOOST_NOEXCEPT
+{
+   double_limb_type cx = 0;
+   double_limb_type cy = 0;
+   limb_type borrow = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      cx += static_cast<double_limb_type>(i < xn ? x[i] : 0) * mx;
+      cy += static_cast<double_limb_type>(i < yn ? y[i] : 0) * my;
+      limb_type lx = static_cast<limb_type>(cx);
+      limb_type ly = static_cast<limb_type>(cy);
+      cx >>= bits_per_limb;
+      cy >>= bits_per_limb;
+      limb_type d = lx - ly;
+      limb_type bw = lx < ly;
+      r[i] = d - borrow;
+      borrow = bw | (d < borrow);
+   }
+   BOOST_ASSERT(cx == cy + borrow);
+}
+//
+// (a, b) = m^-1 (a, b) = (m3 a - m1 b, m0 b - m2 a) for a matrix found by lehmer_matrix, t is scratch:
+//
+template <class CppInt>
+void apply_lehmer_matrix(CppInt& a, CppInt& b, const limb_type* m, CppInt& t)
+{
+   unsigned an = a.size();
+   unsigned bn = b.size();
+   unsigned n = (std::max)(an, bn);
+   t.resize(n, n);
+   multiply_subtract_limbs(t.limbs(), n, a.limbs(), an, m[3], b.limbs(), bn, m[1]);
+   b.resize(n, n);
+   multiply_subtract_limbs(b.limbs(), n, b.limbs(), bn, m[0], a.limbs(), an, m[2]);
+   t.sign(false);
+   t.normalize();
+   b.normalize();
+   a.swap(t);
+}
+//
+// The same for signed values and any kind of matrix entries, used for the cofactors and by the half-GCD:
+//
+template <class Coefficient>
+void apply_inverse_matrix(cpp_int_backend<>& a, cpp_int_backend<>& b, const Coefficient* m)
+{
+   cpp_int_backend<> t1, t2;
+   eval_multiply(t1, a, m[3]);
+   eval_multiply(t2, b, m[1]);
+   eval_subtract(t1, t2);
+   eval_multiply(t2, b, m[0]);
+   eval_multiply(b, a, m[2]);
+   eval_subtract(t2, b);
+   a.swap(t1);
+   b.swap(t2);
+}
+//
+// m = m * n:
+//
+template <class Coefficient>
+void multiply_matrix(cpp_int_backend<>* m, const Coefficient* n)
+{
+   cpp_int_backend<> t1, t2, t3;
+   for(unsigned row = 0; row < 4; row += 2)
+   {
+      eval_multiply(t1, m[row], n[0]);
+      eval_multiply(t2, m[row + 1], n[2]);
+      eval_add(t1, t2);
+      eval_multiply(t3, m[row], n[1]);
+      eval_multiply(t2, m[row + 1], n[3]);
+      eval_add(t3, t2);
+      m[row].swap(t1);
+      m[row + 1].swap(t3);
+   }
+}
+//
+// The same for single limb entries, as each Lehmer step in the half-GCD needs:
+//
+inline void multiply_matrix(cpp_int_backend<>* m, const limb_type* n)
+{
+   cpp_int_backend<> t1, t2;
+   for(unsigned row = 0; row < 4; row += 2)
+   {
+      const cpp_int_backend<>& x = m[row];
+      const cpp_int_backend<>& y = m[row + 1];
+      unsigned sz = (std::max)(x.size(), y.size()) + 1;
+      t1.resize(sz, sz);
+      t2.resize(sz, sz);
+      double_limb_type c[4] = { 0, 0, 0, 0 };
+      for(unsigned i = 0; i < sz; ++i)
+      {
+         limb_type xi = i < x.size() ? x.limbs()[i] : 0;
+         limb_type yi = i < y.size() ? y.limbs()[i] : 0;
+         c[0] += static_cast<double_limb_type>(xi) * n[0];
+         c[1] += static_cast<double_limb_type>(yi) * n[2] + static_cast<limb_type>(c[0]);
+         c[2] += static_cast<double_limb_type>(xi) * n[1];
+         c[3] += static_cast<double_limb_type>(yi) * n[3] + static_cast<limb_type>(c[2]);
+         t1.limbs()[i] = static_cast<limb_type>(c[1]);
+         t2.limbs()[i] = static_cast<limb_type>(c[3]);
+         for(unsigned j = 0; j < 4; ++j)
+            c[j] >>= bits_per_limb;
+      }
+      BOOST_ASSERT(!c[0] && !c[1] && !c[2] && !c[3]);
+      t1.normalize();
+      t2.normalize();
+      m[row].swap(t1);
+      m[row + 1].swap(t2);
+   }
+}
+
+struct hgcd_matrix
+{
+   cpp_int_backend<> m[4];
+   hgcd_matrix()
+   {
+      m[0] = static_cast<limb_type>(1u);
+      m[3] = static_cast<limb_type>(1u);
+   }
+};
+//
+// One step of the half-GCD: reduces (a, b) by subtracting multiples of the smaller value from the
+// larger while both stay at least B^s, with a Lehmer step where possible and otherwise a single
+// division.  m (if non-null) is updated so that it still maps the reduced (a, b) to the original.
+// Returns false if no step is possible:
+//
+inline bool hgcd_step(cpp_int_backend<>& a, cpp_int_backend<>& b, unsigned s, hgcd_matrix* m)
+{
+   using default_ops::eval_is_zero;
+
+   limb_type lm[4];
+   if(find_lehmer_matrix(a, b, s * bits_per_limb, lm))
+   {
+      cpp_int_backend<> t;
+      apply_lehmer_matrix(a, b, lm, t);
+      if(m)
+         multiply_matrix(m->m, lm);
+      return true;
+   }
+   bool swapped = a.compare(b) < 0;
+   cpp_int_backend<>& x = swapped ? b : a;
+   cpp_int_backend<>& y = swapped ? a : b;
+   cpp_int_backend<> limit(static_cast<limb_type>(1u)), q, t;
+   eval_left_shift(limit, s * bits_per_limb);
+   //
+   // The largest q with x - q * y >= B^s:
+   //
+   eval_subtract(t, x, y);
+   if(t.compare(limit) < 0)
+      return false;
+   eval_subtract(t, x, limit);
+   eval_divide(q, t, y);
+   eval_multiply(t, q, y);
+   eval_subtract(x, t);
+   if(m)
+   {
+      unsigned i = swapped ? 0 : 1;
+      eval_multiply(t, q, m->m[1 - i]);
+      eval_add(m->m[i], t);
+      eval_multiply(t, q, m->m[3 - i]);
+      eval_add(m->m[2 + i], t);
+   }
+   return true;
+}
+
+inline bool hgcd(cpp_int_backend<>& a, cpp_int_backend<>& b, hgcd_matrix* m);
+//
+// Reduces a and b by the half-GCD of the values formed by their limbs above p, m (if non-null) is
+// updated to match, or simply replaced if it is the identity.  Returns false if the high parts
+// could not be reduced:
+//
+inline bool hgcd_reduce(cpp_int_backend<>& a, cpp_int_backend<>& b, unsigned p, hgcd_matrix* m, bool identity)
+{
+   cpp_int_backend<> ah(a), bh(b), al, bl;
+   eval_right_shift(ah, p * bits_per_limb);
+   eval_right_shift(bh, p * bits_per_limb);
+   hgcd_matrix m1;
+   if(!hgcd(ah, bh, &m1))
+      return false;
+   //
+   // The steps taken on the high parts are valid for the whole values, so that
+   // (a, b) = m1 (ah' B^p + m3 al - m1 bl, bh' B^p + m0 bl - m2 al) with both positive:
+   //
+   unsigned an = (std::min)(p, a.size());
+   unsigned bn = (std::min)(p, b.size());
+   al.resize(an, an);
+   std::memcpy(al.limbs(), a.limbs(), an * sizeof(limb_type));
+   al.normalize();
+   bl.resize(bn, bn);
+   std::memcpy(bl.limbs(), b.limbs(), bn * sizeof(limb_type));
+   bl.normalize();
+   apply_inverse_matrix(al, bl, m1.m);
+   eval_left_shift(ah, p * bits_per_limb);
+   eval_add(a, ah, al);
+   eval_left_shift(bh, p * bits_per_limb);
+   eval_add(b, bh, bl);
+   BOOST_ASSERT(!a.sign() && !b.sign());
+   if(m)
+   {
+      if(identity)
+      {
+         for(unsigned i = 0; i < 4; ++i)
+            m->m[i].swap(m1.m[i]);
+      }
+      else
+         multiply_matrix(m->m, m1.m);
+   }
+   return true;
+}
+//
+// The half-GCD: with n the size of the larger of a and b and s = n / 2 + 1, reduces (a, b) as far as
+// possible by subtracting multiples of the smaller value from the larger while both stay at least B^s.
+// m (if non-null) must be the identity on entry, and on exit maps the reduced (a, b) to the original.
+// Large values are reduced recursively, first by the half-GCD of their top halves which leaves about
+// 3n/4 limbs, and then by that of their top 2(n - s) limbs which leaves a little over s.  Returns false
+// if (a, b) could not be reduced at all:
+//
+inline bool hgcd(cpp_int_backend<>& a, cpp_int_backend<>& b, hgcd_matrix* m)
+{
+   unsigned n = (std::max)(a.size(), b.size());
+   unsigned s = n / 2 + 1;
+   if((std::min)(a.size(), b.size()) <= s)
+      return false;
+   bool progress = false;
+   if(n >= BOOST_MP_HGCD_CUTOFF)
+   {
+      progress = hgcd_reduce(a, b, n / 2, m, true);
+      unsigned limit = (3 * n) / 4 + 1;
+      for(n = (std::max)(a.size(), b.size()); n > limit; n = (std::max)(a.size(), b.size()))
+      {
+         if(!hgcd_step(a, b, s, m))
+            return progress;
+         progress = true;
+      }
+      if((n > s + 2) && hgcd_reduce(a, b, 2 * s - n + 1, m, !progress))
+         progress = true;
+   }
+   while(hgcd_step(a, b, s, m))
+      progress = true;
+   return progress;
+}
+//
+// The cofactors of the first of the original arguments in each of the working values:
+//
+struct gcd_cofactors
+{
+   cpp_int_backend<> u, v;
+};
+//
+// Lehmer's GCD of the non-negative values u and v, which leaves the result in u.  If c is non-null
+// the cofactors are kept up to date:
+//
+template <class CppInt>
+void gcd_lehmer(CppInt& u, CppInt& v, gcd_cofactors* c)
+{
+   using default_ops::eval_is_zero;
+
+   CppInt q, r;
+   cpp_int_backend<> t;
+   limb_type m[4];
+   for(;;)
+   {
+      if(u.compare(v) < 0)
+      {
+         u.swap(v);
+         if(c)
+            c->u.swap(c->v);
+      }
+      if(eval_is_zero(v))
+         break;
+      if(!c && (u.size() <= 2))
+      {
+         //
+         // Finish off with the binary GCD of the double limb values:
+         //
+         double_limb_type x = u.limbs()[0], y = v.limbs()[0];
+         if(u.size() > 1)
+            x |= static_cast<double_limb_type>(u.limbs()[1]) << bits_per_limb;
+         if(v.size() > 1)
+            y |= static_cast<double_limb_type>(v.limbs()[1]) << bits_per_limb;
+         unsigned shift = 0;
+         while(!((x | y) & 1u))
+         {
+            x >>= 1;
+            y >>= 1;
+            ++shift;
+         }
+         while(!(x & 1u))
+            x >>= 1;
+         while(!(y & 1u))
+            y >>= 1;
+         u = integer_gcd_reduce(x, y);
+         eval_left_shift(u, shift);
+         return;
+      }
+      if(find_lehmer_matrix(u, v, 0, m))
+      {
+         apply_lehmer_matrix(u, v, m, r);
+         if(c)
+            apply_inverse_matrix(c->u, c->v, m);
+      }
+      else
+      {
+         eval_qr(u, v, q, r);
+         u.swap(r);
+         if(c)
+         {
+            eval_multiply(t, q, c->v);
+            eval_subtract(c->u, t);
+         }
+      }
+   }
+}
+//
+// The GCD of the non-negative values u and v by the half-GCD, handing over to Lehmer's algorithm
+// once the values drop below BOOST_MP_HGCD_CUTOFF limbs, the result is left in u:
+//
+inline void gcd_subquadratic(cpp_int_backend<>& u, cpp_int_backend<>& v, gcd_cofactors* c)
+{
+   using default_ops::eval_is_zero;
+
+   cpp_int_backend<> q, r;
+   for(;;)
+   {
+      if(u.compare(v) < 0)
+      {
+         u.swap(v);
+         if(c)
+            c->u.swap(c->v);
+      }
+      if(eval_is_zero(v))
+         break;
+      if(u.size() < BOOST_MP_HGCD_CUTOFF)
+         break;
+      if(v.size() > u.size() / 2 + 1)
+      {
+         hgcd_matrix m;
+         if(hgcd(u, v, c ? &m : 0))
+         {
+            if(c)
+               apply_inverse_matrix(c->u, c->v, m.m);
+            continue;
+         }
+      }
+      eval_qr(u, v, q, r);
+      u.swap(r);
+      if(c)
+      {
+         eval_multiply(r, q, c->v);
+         eval_subtract(c->u, r);
+      }
+   }
+   gcd_lehmer(u, v, c);
+}
+//
+// Sets g = gcd(a, b) and s such that s * a + t * b = g for some t, s is the cofactor the Euclidean
+// algorithm would produce so that |s| <= |b| / g:
+//
+inline void gcd_extended(cpp_int_backend<>& g, cpp_int_backend<>& s, const cpp_int_backend<>& a, const cpp_int_backend<>& b)
+{
+   gcd_cofactors c;
+   cpp_int_backend<> v(b);
+   g = a;
+   g.sign(false);
+   v.sign(false);
+   c.u = static_cast<limb_type>(1u);
+   gcd_subquadratic(g, v, &c);
+   s.swap(c.u);
+   if(a.sign())
+      s.negate();
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
    eval_gcd(
@@ -426,6 +918,18 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       result = u;
       return;
    }
+   //
+   // gcd(u, v) = gcd(u mod v, v), which fits in a single limb:
+   //
+   if(u.size() > 2)
+   {
+      u = eval_integer_modulus(u, v);
+      if(eval_is_zero(u))
+      {
+         result = v;
+         return;
+      }
+   }
 
    /* Let shift := lg K, where K is the greatest power of 2
    dividing both u and v. */
@@ -488,7 +992,6 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, 
       const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& b)
 {
-   using default_ops::eval_lsb;
    using default_ops::eval_is_zero;
    using default_ops::eval_get_sign;
 
@@ -503,8 +1006,6 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       return;
    }
 
-   int shift;
-
    cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> u(a), v(b);
 
    int s = eval_get_sign(u);
@@ -530,45 +1031,164 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       return;
    }
 
-   /* Let shift := lg K, where K is the greatest power of 2
-   dividing both u and v. */
+   if((std::max)(u.size(), v.size()) >= BOOST_MP_HGCD_CUTOFF)
+   {
+      cpp_int_backend<> x(u), y(v);
+      gcd_subquadratic(x, y, static_cast<gcd_cofactors*>(0));
+      result = x;
+      return;
+   }
+   gcd_lehmer(u, v, static_cast<gcd_cofactors*>(0));
+   result.swap(u);
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_gcdext(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& g, 
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& s, 
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& t, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& b)
+{
+   using default_ops::eval_is_zero;
+   //
+   // The cofactor of a comes from the Lehmer / half-GCD code, that of b from t = (g - s * a) / b
+   // which is an exact division:
+   //
+   cpp_int_backend<> x(a), y(b), gx, sx, tx;
+   gcd_extended(gx, sx, x, y);
+   if(eval_is_zero(y))
+      tx = static_cast<limb_type>(0u);
+   else
+   {
+      eval_multiply(tx, sx, x);
+      tx.negate();
+      eval_add(tx, gx);
+      eval_divide(tx, y);
+   }
+   g = gx;
+   s = sx;
+   t = tx;
+}
+//
+// Sets x = x mod 2^bits for x >= 0:
+//
+inline void truncate_bits(cpp_int_backend<>& x, unsigned bits)
+{
+   unsigned n = bits / bits_per_limb + (bits % bits_per_limb ? 1 : 0);
+   if(n == 0)
+   {
+      x = static_cast<limb_type>(0u);
+      return;
+   }
+   if(x.size() > n)
+      x.resize(n, n);
+   if((bits % bits_per_limb) && (x.size() == n))
+      x.limbs()[n - 1] &= (static_cast<limb_type>(1u) << (bits % bits_per_limb)) - 1;
+   x.normalize();
+}
+//
+// Inverse of a modulo m for single limb values, 0 if there is none:
+//
+inline limb_type inverse_mod_limb(limb_type a, limb_type m) BOOST_NOEXCEPT
+{
+   limb_type u1 = 1, u3 = a, v1 = 0, v3 = m;
+   bool negative = false;
+   while(v3)
+   {
+      limb_type q = u3 / v3;
+      limb_type t = u3 - q * v3;
+      u3 = v3;
+      v3 = t;
+      t = u1 + q * v1;
+      u1 = v1;
+      v1 = t;
+      negative = !negative;
+   }
+   if((u3 != 1) || (m == 1))
+      return 0;
+   return negative ? m - u1 : u1;
+}
+//
+// Inverse of an odd a modulo 2^k by Newton (Hensel) iteration: if a * x = 1 mod 2^j then
+// x' = x - x * (a * x - 1) satisfies a * x' = 1 mod 2^2j.  We start from the single limb inverse
+// and only ever multiply numbers of the current precision:
+//
+inline void inverse_mod_pow2(cpp_int_backend<>& result, const cpp_int_backend<>& a, unsigned k)
+{
+   limb_type inv = *a.limbs();
+   // a is its own inverse to 3 bits:
+   for(unsigned i = 0; i < 5; ++i)
+      inv *= 2 - *a.limbs() * inv;
+   cpp_int_backend<> x, e, y, one;
+   x = inv;
+   one = static_cast<limb_type>(1u);
+   for(unsigned bits = bits_per_limb; bits < k;)
+   {
+      bits = (std::min)(2 * bits, k);
+      y = a;
+      truncate_bits(y, bits);
+      eval_multiply(e, y, x);
+      eval_subtract(e, one);
+      truncate_bits(e, bits);
+      eval_multiply(y, x, e);
+      truncate_bits(y, bits);
+      if(y.compare(x) > 0)
+         eval_bit_set(x, bits);
+      eval_subtract(x, y);
+   }
+   truncate_bits(x, k);
+   result.swap(x);
+}
 
-   unsigned us = eval_lsb(u);
-   unsigned vs = eval_lsb(v);
-   shift = (std::min)(us, vs);
-   eval_right_shift(u, us);
-   eval_right_shift(v, vs);
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_inverse_mod(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& m)
+{
+   using default_ops::eval_is_zero;
+   using default_ops::eval_lsb;
+   using default_ops::eval_msb;
 
-   do 
+   if(m.size() == 1)
    {
-      /* Now u and v are both odd, so diff(u, v) is even.
-      Let u = min(u, v), v = diff(u, v)/2. */
-      s = u.compare(v);
-      if(s > 0)
-         u.swap(v);
-      if(s == 0)
-         break;
-      if(v.size() <= 2)
-      {
-         if(v.size() == 1)
-            u = integer_gcd_reduce(*v.limbs(), *u.limbs());
-         else
-         {
-            double_limb_type i, j;
-            i = v.limbs()[0] | (static_cast<double_limb_type>(v.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
-            j = (u.size() == 1) ? *u.limbs() : u.limbs()[0] | (static_cast<double_limb_type>(u.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
-            u = integer_gcd_reduce(i, j);
-         }
-         break;
-      }
-      eval_subtract(v, u);
-      vs = eval_lsb(v);
-      eval_right_shift(v, vs);
-   } 
-   while(true);
-
-   result = u;
-   eval_left_shift(result, shift);
+      limb_type r = eval_integer_modulus(a, *m.limbs());
+      if(a.sign() && r)
+         r = *m.limbs() - r;
+      result = inverse_mod_limb(r, *m.limbs());
+      return;
+   }
+   cpp_int_backend<> x(a), y(m), g, s;
+   if(eval_lsb(m) == eval_msb(m))
+   {
+      //
+      // Power of 2 modulus, reduction is truncation and the inverse needs no division at all:
+      //
+      unsigned k = eval_lsb(m);
+      truncate_bits(x, k);
+      if(a.sign() && !eval_is_zero(x))
+         eval_subtract(x, y, x);
+      if(*x.limbs() & 1u)
+         inverse_mod_pow2(s, x, k);
+      else
+         s = static_cast<limb_type>(0u);
+      result = s;
+      return;
+   }
+   if(a.sign() || (a.compare(m) >= 0))
+   {
+      eval_modulus(x, x, y);
+      if(x.sign())
+         eval_add(x, y);
+   }
+   gcd_extended(g, s, x, y);
+   if((g.size() != 1) || (*g.limbs() != 1))
+      s = static_cast<limb_type>(0u);
+   else if(s.sign())
+      eval_add(s, y);
+   result = s;
 }
 //
 // Now again for trivial backends:
@@ -692,6 +1312,17 @@ inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits
    return eval_msb_imp(a);
 }
 
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, unsigned>::type
+   eval_popcount(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a)
+{
+   if(a.sign())
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Counting the bits in negative values is not supported - results are undefined."));
+   }
+   return boost::multiprecision::detail::count_bits(*a.limbs());
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline std::size_t hash_value(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& val) BOOST_NOEXCEPT
 {
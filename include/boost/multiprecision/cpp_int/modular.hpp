@@ -0,0 +1,425 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Division free modular arithmetic for cpp_int_backend, used by powm:
+//
+#ifndef BOOST_MP_CPP_INT_MODULAR_HPP
+#define BOOST_MP_CPP_INT_MODULAR_HPP
+
+#include <vector>
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+//
+// Truncated schoolbook products for Barrett reduction, r[0, k) = a[0, an) * b[0, bn) mod B^k:
+//
+inline void multiply_limbs_low(limb_type* r, unsigned k, const limb_type* a, unsigned an, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   std::memset(r, 0, k * sizeof(limb_type));
+   for(unsigned i = 0; i < (std::min)(an, k); ++i)
+   {
+      unsigned jn = (std::min)(bn, k - i);
+      limb_type carry = addmul_1(r + i, b, jn, a[i]);
+      if(i + jn < k)
+         r[i + jn] = carry;
+   }
+}
+//
+// r[0, an + bn) = a * b, except that the partial products in columns below k are skipped,
+// so the result is too small, but by less than B^(k + 2):
+//
+inline void multiply_limbs_high(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, unsigned k) BOOST_NOEXCEPT
+{
+   std::memset(r, 0, (an + bn) * sizeof(limb_type));
+   for(unsigned i = 0; i < an; ++i)
+   {
+      unsigned j = k > i ? k - i : 0;
+      r[i + bn] = j < bn ? addmul_1(r + i + j, b + j, bn - j, a[i]) : 0;
+   }
+}
+//
+// Precomputes everything needed to reduce modulo m once, after which products are
+// reduced with no divisions at all: odd moduli use Montgomery multiplication and even
+// ones Barrett reduction.  Values are held as arrays of size() limbs in "residue form"
+// (which for Montgomery is x * 2^(size() * bits_per_limb) mod m), use to_residue and
+// from_residue to convert, only multiply_normal works on values in normal form.  The
+// object holds its own work space, so it may be reused for any number of operations,
+// but must not be shared between threads.
+//
+class modular_reducer
+{
+   std::vector<limb_type> m_modulus;
+   std::vector<limb_type> m_r2;       // R^2 mod m, Montgomery only.
+   std::vector<limb_type> m_mu;       // floor(B^2n / m) for Barrett.
+   std::vector<limb_type> m_one;
+   std::vector<limb_type> m_product;
+   std::vector<limb_type> m_work;
+   std::vector<limb_type> m_scratch;
+   limb_type              m_inv;      // -1/m mod B
+   unsigned               m_size;
+   bool                   m_montgomery;
+
+   static void assign_limbs(cpp_int_backend<>& r, const limb_type* p, unsigned n)
+   {
+      r.resize(n, n);
+      std::memcpy(r.limbs(), p, n * sizeof(limb_type));
+      r.normalize();
+   }
+   //
+   // Word by word Montgomery reduction, r[0, n) = x * R^-1 mod m, for x[0, 2n) < m * R:
+   //
+   void montgomery_reduce(limb_type* r, limb_type* x)const
+   {
+      const limb_type* pm = &m_modulus[0];
+      unsigned n = m_size;
+      limb_type inv = m_inv;
+      limb_type top = 0;
+      for(unsigned i = 0; i < n; ++i)
+      {
+         limb_type u = x[i] * inv;
+         limb_type carry = addmul_1(x + i, pm, n, u);
+         //
+         // The row's carry goes into x[i + n], anything beyond that is deferred to the
+         // next row so there's no need for a ripple:
+         //
+         limb_type t = x[i + n] + carry;
+         limb_type c = t < carry;
+         x[i + n] = t + top;
+         top = c + (x[i + n] < top);
+      }
+      if(top || (compare_limbs(x + n, pm, n) >= 0))
+         subtract_limbs(r, x + n, n, pm, n);
+      else
+         std::memcpy(r, x + n, n * sizeof(limb_type));
+   }
+   //
+   // Barrett reduction, r[0, n) = x mod m, for x[0, 2n) (Handbook of Applied Cryptography 14.42):
+   //
+   void barrett_reduce(limb_type* r, const limb_type* x)
+   {
+      unsigned n = m_size;
+      unsigned mun = static_cast<unsigned>(m_mu.size());
+      limb_type* q = &m_product[2 * n];
+      limb_type* w = &m_work[0];
+      //
+      // q = floor(floor(x / B^(n-1)) * mu / B^(n+1)), which is at most 3 smaller than x / m
+      // even when the low columns of the product are skipped.  The remainder then fits in
+      // n + 1 limbs, so only the low limbs of q * m are needed:
+      //
+      if(n + 2 < BOOST_MP_KARATSUBA_CUTOFF)
+      {
+         multiply_limbs_high(q, x + n - 1, n + 1, &m_mu[0], mun, n - 1);
+         multiply_limbs_low(w, n + 1, q + n + 1, n + 1, &m_modulus[0], n);
+      }
+      else
+      {
+         multiply_limbs_recursive(q, x + n - 1, n + 1, &m_mu[0], mun, scratch());
+         multiply_limbs_recursive(w, q + n + 1, n + 1, &m_modulus[0], n, scratch());
+      }
+      subtract_limbs(w, x, n + 1, w, n + 1);
+      while((w[n] != 0) || (compare_limbs(w, &m_modulus[0], n) >= 0))
+      {
+         limb_type borrow = subtract_limbs(w, w, n, &m_modulus[0], n);
+         w[n] -= borrow;
+      }
+      std::memcpy(r, w, n * sizeof(limb_type));
+   }
+   //
+   // r[0, n) = x[0, 2n) reduced, destroys x:
+   //
+   void reduce(limb_type* r, limb_type* x)
+   {
+      if(m_montgomery)
+         montgomery_reduce(r, x);
+      else
+         barrett_reduce(r, x);
+   }
+   limb_type* product()
+   {
+      return &m_product[0];
+   }
+   limb_type* scratch()
+   {
+      return m_scratch.empty() ? 0 : &m_scratch[0];
+   }
+
+public:
+   //
+   // m[0, mn) is the modulus, which must be non-zero:
+   //
+   modular_reducer(const limb_type* m, unsigned mn)
+   {
+      while((mn > 1) && !m[mn - 1])
+         --mn;
+      BOOST_ASSERT(mn && m[mn - 1]);
+      m_size = mn;
+      m_montgomery = (m[0] & 1u) != 0;
+      m_modulus.assign(m, m + mn);
+      //
+      // Products of n + 2 limb values at most, with room for the Barrett quotient after
+      // the product in m_product:
+      //
+      m_product.resize(4 * mn + 8);
+      m_work.resize(2 * mn + 2);
+      m_scratch.resize(multiply_limbs_scratch_size(mn + 2));
+
+      cpp_int_backend<> modulus, t;
+      assign_limbs(modulus, m, mn);
+      t = static_cast<limb_type>(1u);
+      eval_left_shift(t, 2 * mn * bits_per_limb);
+      eval_divide(t, modulus);
+      m_mu.assign(t.limbs(), t.limbs() + t.size());
+      if(m_montgomery)
+      {
+         // Newton iteration for 1/m mod B, m is its own inverse to 3 bits:
+         limb_type inv = m[0];
+         for(unsigned i = 0; i < 5; ++i)
+            inv *= 2 - m[0] * inv;
+         m_inv = 0 - inv;
+         t = static_cast<limb_type>(1u);
+         eval_left_shift(t, 2 * mn * bits_per_limb);
+         eval_modulus(t, t, modulus);
+         m_r2.assign(mn, 0);
+         std::memcpy(&m_r2[0], t.limbs(), t.size() * sizeof(limb_type));
+         m_one.assign(mn, 0);
+         // R mod m is the Montgomery form of 1, and is R^2 mod m reduced once:
+         std::vector<limb_type> x(2 * mn, 0);
+         std::memcpy(&x[0], &m_r2[0], mn * sizeof(limb_type));
+         montgomery_reduce(&m_one[0], &x[0]);
+      }
+      else
+      {
+         m_inv = 0;
+         m_one.assign(mn, 0);
+         m_one[0] = 1;
+      }
+   }
+
+   unsigned size()const { return m_size; }
+   bool is_montgomery()const { return m_montgomery; }
+   const limb_type* modulus()const { return &m_modulus[0]; }
+   const limb_type* one()const { return &m_one[0]; }
+   //
+   // r[0, n) = a[0, an) in residue form, an must be no greater than size(),
+   // but a may be greater than the modulus:
+   //
+   void to_residue(limb_type* r, const limb_type* a, unsigned an)
+   {
+      BOOST_ASSERT(an <= m_size);
+      limb_type* x = product();
+      if(m_montgomery)
+      {
+         multiply_limbs_recursive(x, a, an, &m_r2[0], m_size, scratch());
+         std::fill(x + an + m_size, x + 2 * m_size, static_cast<limb_type>(0u));
+      }
+      else
+      {
+         std::memcpy(x, a, an * sizeof(limb_type));
+         std::fill(x + an, x + 2 * m_size, static_cast<limb_type>(0u));
+      }
+      reduce(r, x);
+   }
+   //
+   // r[0, n) = a[0, n) converted back to normal form, always less than the modulus:
+   //
+   void from_residue(limb_type* r, const limb_type* a)
+   {
+      limb_type* x = product();
+      std::memcpy(x, a, m_size * sizeof(limb_type));
+      std::fill(x + m_size, x + 2 * m_size, static_cast<limb_type>(0u));
+      reduce(r, x);
+   }
+   //
+   // Residue arithmetic, r may alias either argument:
+   //
+   void multiply(limb_type* r, const limb_type* a, const limb_type* b)
+   {
+      limb_type* x = product();
+      multiply_limbs_recursive(x, a, m_size, b, m_size, scratch());
+      reduce(r, x);
+   }
+   void square(limb_type* r, const limb_type* a)
+   {
+      multiply(r, a, a);
+   }
+   //
+   // r = a * b mod m for a and b in normal form, whatever the residue form is:
+   //
+   void multiply_normal(limb_type* r, const limb_type* a, const limb_type* b)
+   {
+      limb_type* x = product();
+      multiply_limbs_recursive(x, a, m_size, b, m_size, scratch());
+      barrett_reduce(r, x);
+   }
+   void add(limb_type* r, const limb_type* a, const limb_type* b)const
+   {
+      limb_type carry = add_limbs(r, a, m_size, b, m_size);
+      if(carry || (compare_limbs(r, &m_modulus[0], m_size) >= 0))
+         subtract_limbs(r, r, m_size, &m_modulus[0], m_size);
+   }
+   void subtract(limb_type* r, const limb_type* a, const limb_type* b)const
+   {
+      if(subtract_limbs(r, a, m_size, b, m_size))
+         add_limbs(r, r, m_size, &m_modulus[0], m_size);
+   }
+   //
+   // r = a^e with a in residue form, by left to right sliding window exponentiation:
+   //
+   void powm(limb_type* r, const limb_type* a, const limb_type* e, unsigned en)
+   {
+      while(en && !e[en - 1])
+         --en;
+      if(!en)
+      {
+         std::memcpy(r, one(), m_size * sizeof(limb_type));
+         return;
+      }
+      unsigned bits = (en - 1) * bits_per_limb + 1;
+      for(limb_type top = e[en - 1]; top >>= 1; )
+         ++bits;
+      unsigned window = bits <= 24 ? 1 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+      //
+      // Table of the odd powers a, a^3, ..., a^(2^window - 1):
+      //
+      unsigned n = m_size;
+      std::vector<limb_type> table((1u << (window - 1)) * n);
+      std::memcpy(&table[0], a, n * sizeof(limb_type));
+      if(window > 1)
+      {
+         std::vector<limb_type> a2(n);
+         square(&a2[0], a);
+         for(unsigned i = 1; i < (1u << (window - 1)); ++i)
+            multiply(&table[i * n], &table[(i - 1) * n], &a2[0]);
+      }
+      bool started = false;
+      int i = static_cast<int>(bits) - 1;
+      while(i >= 0)
+      {
+         if(!((e[i / bits_per_limb] >> (i % bits_per_limb)) & 1u))
+         {
+            square(r, r);
+            --i;
+            continue;
+         }
+         //
+         // Longest window [j, i] that ends in a set bit:
+         //
+         int j = (std::max)(i - static_cast<int>(window) + 1, 0);
+         while(!((e[j / bits_per_limb] >> (j % bits_per_limb)) & 1u))
+            ++j;
+         unsigned value = 0;
+         for(int k = i; k >= j; --k)
+            value = (value << 1) | static_cast<unsigned>((e[k / bits_per_limb] >> (k % bits_per_limb)) & 1u);
+         if(started)
+         {
+            for(int k = i; k >= j; --k)
+               square(r, r);
+            multiply(r, r, &table[(value >> 1) * n]);
+         }
+         else
+         {
+            std::memcpy(r, &table[(value >> 1) * n], n * sizeof(limb_type));
+            started = true;
+         }
+         i = j - 1;
+      }
+   }
+};
+
+//
+// Sets result to a^e mod c, where e is the limbs of a non-negative exponent and c is
+// non-zero.  Follows the same sign convention as eval_modulus: the result has the sign
+// of a^e and the magnitude of |a|^e mod |c|:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+void eval_powm_reduced(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a,
+      const limb_type* pe, unsigned en,
+      modular_reducer& red)
+{
+   unsigned n = red.size();
+   std::vector<limb_type> x(2 * n);
+   const limb_type* pa = a.limbs();
+   unsigned as = a.size();
+   cpp_int_backend<> t;
+   if(as > n)
+   {
+      // The base is larger than the modulus, reduce it the slow way, just this once:
+      cpp_int_backend<> m;
+      t.resize(as, as);
+      std::memcpy(t.limbs(), pa, as * sizeof(limb_type));
+      t.normalize();
+      m.resize(n, n);
+      std::memcpy(m.limbs(), red.modulus(), n * sizeof(limb_type));
+      m.normalize();
+      eval_modulus(t, t, m);
+      pa = t.limbs();
+      as = t.size();
+   }
+   red.to_residue(&x[0], pa, as);
+   red.powm(&x[n], &x[0], pe, en);
+   red.from_residue(&x[0], &x[n]);
+
+   unsigned rn = n;
+   while((rn > 1) && !x[rn - 1])
+      --rn;
+   result.resize(rn, rn);
+   std::memcpy(result.limbs(), &x[0], result.size() * sizeof(limb_type));
+   result.normalize();
+   result.sign(a.sign() && (pe[0] & 1u) && !eval_is_zero(result));
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value >::type
+   eval_powm(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& p,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   //
+   // The generic version raises the appropriate errors, and for a single limb modulus
+   // is quicker than setting up the reducer:
+   //
+   if(p.sign() || eval_is_zero(c) || (c.size() == 1))
+   {
+      default_ops::eval_powm(result, a, p, c);
+      return;
+   }
+   modular_reducer red(c.limbs(), c.size());
+   eval_powm_reduced(result, a, p.limbs(), p.size(), red);
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, class Integer>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && is_unsigned<Integer>::value && (sizeof(Integer) <= sizeof(limb_type))>::type
+   eval_powm(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a,
+      Integer p,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   if(eval_is_zero(c) || (c.size() == 1))
+   {
+      default_ops::eval_powm(result, a, p, c);
+      return;
+   }
+   limb_type e = static_cast<limb_type>(p);
+   modular_reducer red(c.limbs(), c.size());
+   eval_powm_reduced(result, a, &e, 1, red);
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+}}} // namespaces
+
+#endif
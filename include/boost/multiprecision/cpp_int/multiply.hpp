@@ -29,27 +29,13 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    }
    if((void*)&a != (void*)&result)
       result.resize(a.size(), a.size());
-   double_limb_type carry = 0;
-   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer p = result.limbs();
-   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer pe = result.limbs() + result.size();
-   typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pa = a.limbs();
-   while(p != pe)
-   {
-      carry += static_cast<double_limb_type>(*pa) * static_cast<double_limb_type>(val);
-#ifdef __MSVC_RUNTIME_CHECKS
-      *p = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-      *p = static_cast<limb_type>(carry);
-#endif
-      carry >>= cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
-      ++p, ++pa;
-   }
+   limb_type carry = mul_1(result.limbs(), a.limbs(), result.size(), val);
    if(carry)
    {
       unsigned i = result.size();
       result.resize(i + 1, i + 1);
       if(result.size() > i)
-         result.limbs()[i] = static_cast<limb_type>(carry);
+         result.limbs()[i] = carry;
    }
    result.sign(a.sign());
    if(!cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::variable)
@@ -71,18 +57,829 @@ inline void resize_for_carry(cpp_int_backend<MinBits1, MaxBits1, SignType1, chec
       result.resize(required, required);
 }
 
+//
+// Sub-quadratic multiplication.
+//
+// Above the following limb counts the schoolbook loop below hands over to the
+// Karatsuba, Toom-Cook 3-way and number theoretic transform routines, all of which
+// may be tuned by defining the macros before including cpp_int.hpp:
+//
+#ifndef BOOST_MP_KARATSUBA_CUTOFF
+#define BOOST_MP_KARATSUBA_CUTOFF 40
+#endif
+#ifndef BOOST_MP_TOOM3_CUTOFF
+#define BOOST_MP_TOOM3_CUTOFF 160
+#endif
+#ifndef BOOST_MP_NTT_CUTOFF
+#define BOOST_MP_NTT_CUTOFF 3000
+#endif
+//
+// Fixed precision types keep the scratch storage for these routines on the stack, so that
+// multiplying them never allocates, as long as it needs no more than this many limbs:
+//
+#ifndef BOOST_MP_MULTIPLY_STACK_LIMBS
+#define BOOST_MP_MULTIPLY_STACK_LIMBS 8192
+#endif
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_KARATSUBA_CUTOFF >= 8, "BOOST_MP_KARATSUBA_CUTOFF must be at least 8 limbs.");
+//
+// The routines below all work on raw limb arrays, they are all unsigned, none of
+// the output arrays may alias the inputs unless stated otherwise, and all temporaries
+// are carved out of a single block of scratch storage allocated up front.
+//
+// r[0, an) = a[0, an) + b[0, bn), an >= bn, returns the carry, r may alias a or b:
+//
+inline limb_type add_limbs(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(an >= bn);
+   limb_type carry = add_n(r, a, b, bn);
+   for(unsigned i = bn; i < an; ++i)
+   {
+      r[i] = a[i] + carry;
+      carry = r[i] < carry;
+   }
+   return carry;
+}
+//
+// r[0, an) = a[0, an) - b[0, bn), an >= bn, returns the borrow, r may alias a or b:
+//
+inline limb_type subtract_limbs(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(an >= bn);
+   limb_type borrow = sub_n(r, a, b, bn);
+   for(unsigned i = bn; i < an; ++i)
+   {
+      limb_type t = a[i];
+      r[i] = t - borrow;
+      borrow = t < borrow;
+   }
+   return borrow;
+}
+//
+// Compares a[0, n) with b[0, n):
+//
+inline int compare_limbs(const limb_type* a, const limb_type* b, unsigned n) BOOST_NOEXCEPT
+{
+   while(n--)
+   {
+      if(a[n] != b[n])
+         return a[n] > b[n] ? 1 : -1;
+   }
+   return 0;
+}
+//
+// r[0, an) = |a[0, an) - b[0, bn)|, an >= bn, returns true if a < b, r may alias a or b:
+//
+inline bool abs_difference_limbs(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(an >= bn);
+   unsigned n = an;
+   while((n > bn) && !a[n - 1])
+      --n;
+   if((n == bn) && (compare_limbs(a, b, bn) < 0))
+   {
+      subtract_limbs(r, b, bn, a, bn);
+      std::fill(r + bn, r + an, static_cast<limb_type>(0u));
+      return true;
+   }
+   subtract_limbs(r, a, an, b, bn);
+   return false;
+}
+//
+// Adds c[0, cn) into r[0, rn), the caller guarantees that the result fits in rn limbs:
+//
+inline void add_limbs_into(limb_type* r, unsigned rn, const limb_type* c, unsigned cn) BOOST_NOEXCEPT
+{
+   while(cn && !c[cn - 1])
+      --cn;
+   BOOST_ASSERT(cn <= rn);
+   limb_type carry = add_limbs(r, r, rn, c, cn);
+   BOOST_ASSERT(carry == 0);
+   (void)carry;
+}
+//
+// Schoolbook multiplication r[0, an + bn) = a * b, the base case for the recursive routines:
+//
+inline void multiply_limbs_schoolbook(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(an && bn);
+   r[bn] = mul_1(r, b, bn, a[0]);
+   for(unsigned i = 1; i < an; ++i)
+      r[i + bn] = addmul_1(r + i, b, bn, a[i]);
+}
+//
+// Schoolbook squaring r[0, 2n) = a * a, the off diagonal products a[i] * a[j] (i < j) are
+// formed once and doubled, before the squares of each limb are added in:
+//
+inline void square_limbs_schoolbook(limb_type* r, const limb_type* a, unsigned n) BOOST_NOEXCEPT
+{
+   std::memset(r, 0, 2 * n * sizeof(limb_type));
+   for(unsigned i = 0; i + 1 < n; ++i)
+      r[i + n] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+   limb_type shift_carry = 0;
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      double_limb_type sq = static_cast<double_limb_type>(a[i]) * static_cast<double_limb_type>(a[i]);
+      limb_type lo = r[2 * i];
+      limb_type hi = r[2 * i + 1];
+      carry += static_cast<double_limb_type>(static_cast<limb_type>((lo << 1) | shift_carry)) + static_cast<limb_type>(sq & ~static_cast<limb_type>(0));
+      shift_carry = lo >> (bits_per_limb - 1);
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[2 * i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      r[2 * i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= bits_per_limb;
+      carry += static_cast<double_limb_type>(static_cast<limb_type>((hi << 1) | shift_carry)) + static_cast<limb_type>(sq >> bits_per_limb);
+      shift_carry = hi >> (bits_per_limb - 1);
+#ifdef __MSVC_RUNTIME_CHECKS
+      r[2 * i + 1] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      r[2 * i + 1] = static_cast<limb_type>(carry);
+#endif
+      carry >>= bits_per_limb;
+   }
+   BOOST_ASSERT(!carry && !shift_carry);
+}
+//
+// Number theoretic transform multiplication for very large values: each limb is one
+// coefficient, the cyclic convolution is computed modulo three word sized primes of the
+// form k * 2^n + 1 and the product recovered by the Chinese Remainder Theorem.  The
+// primes are small enough that Montgomery reduction never overflows a double_limb_type.
+//
+#if defined(BOOST_HAS_INT128)
+
+inline limb_type ntt_prime(unsigned i)
+{
+   static const limb_type values[3] = { 0x3fdc000000000001uLL, 0x3fc6000000000001uLL, 0x3fa3000000000001uLL };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+inline limb_type ntt_generator(unsigned i)
+{
+   static const limb_type values[3] = { 3, 5, 5 };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+//
+// Transforms of up to 2^48 points, and with the product of the primes > 2^185 there is
+// no limit on the size of the coefficients that can be represented by an unsigned count:
+//
+inline bool ntt_multiply_supported(unsigned, unsigned) BOOST_NOEXCEPT
+{
+   return true;
+}
+
+#else
+
+inline limb_type ntt_prime(unsigned i)
+{
+   static const limb_type values[3] = { 469762049u, 167772161u, 754974721u };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+inline limb_type ntt_generator(unsigned i)
+{
+   static const limb_type values[3] = { 3, 3, 11 };
+   BOOST_ASSERT(i < 3);
+   return values[i];
+}
+//
+// Transforms of up to 2^24 points, and the product of the primes is ~2^85 so the shorter
+// operand must have no more than 2^21 limbs for the coefficients to be recoverable:
+//
+inline bool ntt_multiply_supported(unsigned an, unsigned bn) BOOST_NOEXCEPT
+{
+   return (an + bn <= (1u << 24)) && ((std::min)(an, bn) <= (1u << 21));
+}
+
+#endif
+//
+// Arithmetic modulo one of the primes above, multiply() is the Montgomery product
+// a * b / 2^bits_per_limb so values taking part in the transforms are held in
+// Montgomery form, and a Montgomery value multiplied by a normal one yields a normal one:
+//
+class ntt_modulus
+{
+   limb_type m_p, m_pinv, m_one, m_r2;
+public:
+   explicit ntt_modulus(limb_type p) BOOST_NOEXCEPT : m_p(p)
+   {
+      // Newton iteration for 1/p mod 2^bits_per_limb, p is its own inverse to 3 bits
+      // and each step doubles the number of correct bits:
+      limb_type inv = p;
+      for(unsigned i = 0; i < 5; ++i)
+         inv *= 2 - p * inv;
+      m_pinv = 0 - inv;
+      m_one = (~static_cast<limb_type>(0)) % p + 1;
+      m_r2 = static_cast<limb_type>(static_cast<double_limb_type>(m_one) * m_one % p);
+   }
+   limb_type modulus()const BOOST_NOEXCEPT { return m_p; }
+   limb_type one()const BOOST_NOEXCEPT { return m_one; }
+   limb_type multiply(limb_type a, limb_type b)const BOOST_NOEXCEPT
+   {
+      // Valid for any a * b < p * 2^bits_per_limb:
+      double_limb_type t = static_cast<double_limb_type>(a) * b;
+      limb_type m = static_cast<limb_type>(t & ~static_cast<limb_type>(0)) * m_pinv;
+      t = (t + static_cast<double_limb_type>(m) * m_p) >> bits_per_limb;
+      return static_cast<limb_type>(t >= m_p ? t - m_p : t);
+   }
+   limb_type add(limb_type a, limb_type b)const BOOST_NOEXCEPT
+   {
+      limb_type s = a + b;
+      return s >= m_p ? s - m_p : s;
+   }
+   limb_type subtract(limb_type a, limb_type b)const BOOST_NOEXCEPT
+   {
+      return a >= b ? a - b : a + (m_p - b);
+   }
+   limb_type to_montgomery(limb_type a)const BOOST_NOEXCEPT
+   {
+      return multiply(a, m_r2);
+   }
+   limb_type power(limb_type a, limb_type e)const BOOST_NOEXCEPT
+   {
+      limb_type result = m_one;
+      while(e)
+      {
+         if(e & 1u)
+            result = multiply(result, a);
+         a = multiply(a, a);
+         e >>= 1;
+      }
+      return result;
+   }
+};
+//
+// Transform length for a product with n coefficients, and the scratch space needed by
+// multiply_limbs_ntt for operands of up to n limbs each:
+//
+inline unsigned ntt_transform_length(unsigned n) BOOST_NOEXCEPT
+{
+   unsigned result = 1;
+   while(result < n)
+      result <<= 1;
+   return result;
+}
+inline unsigned ntt_scratch_size(unsigned n) BOOST_NOEXCEPT
+{
+   unsigned len = ntt_transform_length(2 * n - 1);
+   return 6 * n + len / 2 + 2 * len;
+}
+//
+// Forward transform by decimation in frequency, x is left in bit reversed order, and
+// tw[0, len / 2) holds the powers of the len'th root of unity:
+//
+inline void ntt_forward(limb_type* x, unsigned len, const limb_type* tw, const ntt_modulus& mod) BOOST_NOEXCEPT
+{
+   for(unsigned m = len / 2, stride = 1; m; m >>= 1, stride <<= 1)
+   {
+      for(unsigned s = 0; s < len; s += 2 * m)
+      {
+         for(unsigned j = 0; j < m; ++j)
+         {
+            limb_type u = x[s + j];
+            limb_type v = x[s + j + m];
+            x[s + j] = mod.add(u, v);
+            x[s + j + m] = mod.multiply(mod.subtract(u, v), tw[j * stride]);
+         }
+      }
+   }
+}
+//
+// Inverse (unscaled) transform by decimation in time, takes bit reversed input and
+// produces natural order output.  The inverse roots come from the same table since
+// w^-j == -w^(len/2 - j):
+//
+inline void ntt_inverse(limb_type* x, unsigned len, const limb_type* tw, const ntt_modulus& mod) BOOST_NOEXCEPT
+{
+   for(unsigned m = 1, stride = len / 2; m < len; m <<= 1, stride >>= 1)
+   {
+      for(unsigned s = 0; s < len; s += 2 * m)
+      {
+         limb_type u = x[s];
+         limb_type v = x[s + m];
+         x[s] = mod.add(u, v);
+         x[s + m] = mod.subtract(u, v);
+         for(unsigned j = 1; j < m; ++j)
+         {
+            u = x[s + j];
+            v = mod.multiply(x[s + j + m], mod.modulus() - tw[len / 2 - j * stride]);
+            x[s + j] = mod.add(u, v);
+            x[s + j + m] = mod.subtract(u, v);
+         }
+      }
+   }
+}
+//
+// r[0, an + bn) = a * b, scratch must have room for ntt_scratch_size(max(an, bn)) limbs:
+//
+inline void multiply_limbs_ntt(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(ntt_multiply_supported(an, bn));
+   unsigned n = an + bn - 1;
+   unsigned len = ntt_transform_length(n);
+   limb_type* residues = scratch;
+   limb_type* tw = residues + 3 * n;
+   limb_type* x = tw + len / 2;
+   limb_type* y = x + len;
+   bool square = (a == b) && (an == bn);
+
+   for(unsigned k = 0; k < 3; ++k)
+   {
+      ntt_modulus mod(ntt_prime(k));
+      limb_type p = mod.modulus();
+      limb_type w = mod.power(mod.to_montgomery(ntt_generator(k)), (p - 1) / len);
+      tw[0] = mod.one();
+      for(unsigned i = 1; i < len / 2; ++i)
+         tw[i] = mod.multiply(tw[i - 1], w);
+
+      for(unsigned i = 0; i < an; ++i)
+         x[i] = mod.to_montgomery(a[i]);
+      std::fill(x + an, x + len, static_cast<limb_type>(0));
+      ntt_forward(x, len, tw, mod);
+      if(square)
+      {
+         for(unsigned i = 0; i < len; ++i)
+            x[i] = mod.multiply(x[i], x[i]);
+      }
+      else
+      {
+         for(unsigned i = 0; i < bn; ++i)
+            y[i] = mod.to_montgomery(b[i]);
+         std::fill(y + bn, y + len, static_cast<limb_type>(0));
+         ntt_forward(y, len, tw, mod);
+         for(unsigned i = 0; i < len; ++i)
+            x[i] = mod.multiply(x[i], y[i]);
+      }
+      ntt_inverse(x, len, tw, mod);
+      //
+      // Scale by 1/len which is p - (p - 1) / len, this also takes us out of Montgomery form:
+      //
+      limb_type scale = p - (p - 1) / len;
+      for(unsigned i = 0; i < n; ++i)
+         residues[k * n + i] = mod.multiply(x[i], scale);
+   }
+   //
+   // Garner's algorithm: each coefficient is v1 + p1 * (v2 + p2 * v3) with vi < pi,
+   // which is then added into the result with a 3 limb carry:
+   //
+   ntt_modulus mod2(ntt_prime(1)), mod3(ntt_prime(2));
+   limb_type p1 = ntt_prime(0), p2 = ntt_prime(1), p3 = ntt_prime(2);
+   limb_type inv_p1_mod_p2 = mod2.power(mod2.to_montgomery(p1 % p2), p2 - 2);
+   limb_type inv_p1_mod_p3 = mod3.power(mod3.to_montgomery(p1 % p3), p3 - 2);
+   limb_type inv_p2_mod_p3 = mod3.power(mod3.to_montgomery(p2 % p3), p3 - 2);
+   limb_type carry[3] = { 0, 0, 0 };
+   for(unsigned i = 0; i < n; ++i)
+   {
+      limb_type v1 = residues[i];
+      limb_type v2 = mod2.multiply(mod2.subtract(residues[n + i], v1 % p2), inv_p1_mod_p2);
+      limb_type v3 = mod3.multiply(mod3.subtract(residues[2 * n + i], v1 % p3), inv_p1_mod_p3);
+      v3 = mod3.multiply(mod3.subtract(v3, v2 % p3), inv_p2_mod_p3);
+
+      double_limb_type t = static_cast<double_limb_type>(v3) * p2 + v2;
+      double_limb_type lo = static_cast<double_limb_type>(static_cast<limb_type>(t & ~static_cast<limb_type>(0))) * p1 + v1;
+      double_limb_type hi = (t >> bits_per_limb) * p1 + (lo >> bits_per_limb);
+
+      double_limb_type sum = static_cast<double_limb_type>(carry[0]) + static_cast<limb_type>(lo & ~static_cast<limb_type>(0));
+      r[i] = static_cast<limb_type>(sum & ~static_cast<limb_type>(0));
+      sum = (sum >> bits_per_limb) + carry[1] + static_cast<limb_type>(hi & ~static_cast<limb_type>(0));
+      carry[0] = static_cast<limb_type>(sum & ~static_cast<limb_type>(0));
+      sum = (sum >> bits_per_limb) + carry[2] + static_cast<limb_type>(hi >> bits_per_limb);
+      carry[1] = static_cast<limb_type>(sum & ~static_cast<limb_type>(0));
+      carry[2] = static_cast<limb_type>(sum >> bits_per_limb);
+   }
+   r[n] = carry[0];
+   BOOST_ASSERT((carry[1] == 0) && (carry[2] == 0));
+}
+//
+// Returns the amount of scratch storage (in limbs) required to multiply two values
+// the larger of which has n limbs, this is a (tight enough) upper bound on the
+// storage used by every branch of multiply_limbs_recursive below:
+//
+inline unsigned multiply_limbs_scratch_size(unsigned n) BOOST_NOEXCEPT
+{
+   unsigned result = 0;
+   unsigned total = 0;
+   while(n >= BOOST_MP_KARATSUBA_CUTOFF)
+   {
+      if(n >= BOOST_MP_NTT_CUTOFF)
+         result = (std::max)(result, total + ntt_scratch_size(n));
+      total += 5 * n + 32;
+      n = n / 2 + 2;
+   }
+   return (std::max)(result, total);
+}
+//
+// The same bound at compile time, for fixed precision values of up to N limbs:
+//
+template <unsigned N, unsigned L = 1, bool = (L >= N)>
+struct ntt_transform_length_bound
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = (ntt_transform_length_bound<N, 2 * L>::value));
+};
+template <unsigned N, unsigned L>
+struct ntt_transform_length_bound<N, L, true>
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = L);
+};
+template <unsigned N, bool = (N >= BOOST_MP_KARATSUBA_CUTOFF)>
+struct multiply_limbs_scratch_bound
+{
+   BOOST_STATIC_CONSTANT(unsigned, ntt_size = (N >= BOOST_MP_NTT_CUTOFF ? 6 * N + ntt_transform_length_bound<2 * N - 1>::value / 2 + 2 * ntt_transform_length_bound<2 * N - 1>::value : 0));
+   BOOST_STATIC_CONSTANT(unsigned, recursive_size = 5 * N + 32 + multiply_limbs_scratch_bound<N / 2 + 2>::value);
+   BOOST_STATIC_CONSTANT(unsigned, value = (ntt_size > recursive_size ? ntt_size : recursive_size));
+};
+template <unsigned N>
+struct multiply_limbs_scratch_bound<N, false>
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = 0);
+};
+
+inline void multiply_limbs_recursive(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch);
+
+//
+// Karatsuba multiplication, requires an >= bn > ceil(an / 2).  Uses the subtractive
+// form so that no temporary grows beyond its half-size operands:
+//
+// a * b = z2 * B^2h + (z2 + z0 + (a0 - a1)(b1 - b0)) * B^h + z0
+//
+inline void multiply_limbs_karatsuba(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch)
+{
+   unsigned h = (an + 1) / 2;
+   BOOST_ASSERT((an >= bn) && (bn > h));
+   const limb_type* a1 = a + h;
+   const limb_type* b1 = b + h;
+   unsigned a1n = an - h;
+   unsigned b1n = bn - h;
+
+   limb_type* t = scratch;
+   limb_type* u = t + h;
+   limb_type* m = u + h;
+   limb_type* z1 = m + 2 * h;
+   limb_type* next = z1 + 2 * h + 1;
+   //
+   // z0 and z2 go straight into their final locations:
+   //
+   multiply_limbs_recursive(r, a, h, b, h, next);
+   multiply_limbs_recursive(r + 2 * h, a1, a1n, b1, b1n, next);
+   //
+   // (a0 - a1)(b1 - b0) is negative when exactly one of the differences is:
+   //
+   bool a_neg = abs_difference_limbs(t, a, h, a1, a1n);
+   bool b_neg;
+   if((a == b) && (an == bn))
+   {
+      // Squaring, the middle product is -(a0 - a1)^2:
+      b_neg = !a_neg;
+      u = t;
+   }
+   else
+      b_neg = !abs_difference_limbs(u, b, h, b1, b1n);
+   multiply_limbs_recursive(m, t, h, u, h, next);
+
+   std::memcpy(z1, r, 2 * h * sizeof(limb_type));
+   z1[2 * h] = add_limbs(z1, z1, 2 * h, r + 2 * h, a1n + b1n);
+   if(a_neg != b_neg)
+      subtract_limbs(z1, z1, 2 * h + 1, m, 2 * h);
+   else
+      add_limbs(z1, z1, 2 * h + 1, m, 2 * h);
+
+   add_limbs_into(r + h, an + bn - h, z1, 2 * h + 1);
+}
+//
+// Helpers for Toom-3, the interpolation step needs signed values which we represent as
+// an n-limb magnitude plus a sign flag.  r = a + b, returns the sign of r, r may alias a or b:
+//
+inline bool add_signed_limbs(limb_type* r, const limb_type* a, bool a_neg, const limb_type* b, bool b_neg, unsigned n) BOOST_NOEXCEPT
+{
+   if(a_neg == b_neg)
+   {
+      add_limbs(r, a, n, b, n);
+      return a_neg;
+   }
+   int c = compare_limbs(a, b, n);
+   if(c >= 0)
+   {
+      subtract_limbs(r, a, n, b, n);
+      return c ? a_neg : false;
+   }
+   subtract_limbs(r, b, n, a, n);
+   return b_neg;
+}
+//
+// Exact in-place division by 3, and by 2:
+//
+inline void divide_limbs_by_3(limb_type* r, unsigned n) BOOST_NOEXCEPT
+{
+   double_limb_type rem = 0;
+   while(n--)
+   {
+      rem = (rem << bits_per_limb) | r[n];
+      r[n] = static_cast<limb_type>(rem / 3);
+      rem %= 3;
+   }
+   BOOST_ASSERT(rem == 0);
+}
+inline void divide_limbs_by_2(limb_type* r, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i + 1 < n; ++i)
+      r[i] = (r[i] >> 1) | (r[i + 1] << (bits_per_limb - 1));
+   r[n - 1] >>= 1;
+}
+//
+// r[0, k + 1) = a0 + 2 a1 + 4 a2, where a2 has a2n <= k limbs:
+//
+inline void toom3_evaluate_at_2(limb_type* r, const limb_type* a, unsigned k, unsigned a2n) BOOST_NOEXCEPT
+{
+   std::memcpy(r, a + 2 * k, a2n * sizeof(limb_type));
+   std::fill(r + a2n, r + k + 1, static_cast<limb_type>(0u));
+   add_limbs(r, r, k + 1, r, k + 1);
+   add_limbs(r, r, k + 1, a + k, k);
+   add_limbs(r, r, k + 1, r, k + 1);
+   add_limbs(r, r, k + 1, a, k);
+}
+//
+// Evaluates a at 1 and -1, p1 and pm1 each have k + 1 limbs, returns the sign of a(-1):
+//
+inline bool toom3_evaluate_at_1(limb_type* p1, limb_type* pm1, const limb_type* a, unsigned k, unsigned a2n) BOOST_NOEXCEPT
+{
+   p1[k] = add_limbs(p1, a, k, a + 2 * k, a2n);
+   bool neg = abs_difference_limbs(pm1, p1, k + 1, a + k, k);
+   add_limbs(p1, p1, k + 1, a + k, k);
+   return neg;
+}
+//
+// Toom-Cook 3-way multiplication, requires an >= bn > 2 * ceil(an / 3).  Evaluates at
+// 0, 1, -1, 2 and infinity, and interpolates with a Bodrato style sequence of exact
+// divisions by 2 and 3:
+//
+inline void multiply_limbs_toom3(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch)
+{
+   unsigned k = (an + 2) / 3;
+   BOOST_ASSERT((an >= bn) && (bn > 2 * k));
+   unsigned a2n = an - 2 * k;
+   unsigned b2n = bn - 2 * k;
+   unsigned w = k + 1;
+   unsigned pw = 2 * w;
+
+   limb_type* p1 = scratch;
+   limb_type* q1 = p1 + w;
+   limb_type* pm1 = q1 + w;
+   limb_type* qm1 = pm1 + w;
+   limb_type* p2 = qm1 + w;
+   limb_type* q2 = p2 + w;
+   limb_type* r1 = q2 + w;
+   limb_type* rm1 = r1 + pw;
+   limb_type* r2 = rm1 + pw;
+   limb_type* t = r2 + pw;
+   limb_type* next = t + pw;
+
+   bool rm1_neg = toom3_evaluate_at_1(p1, pm1, a, k, a2n);
+   toom3_evaluate_at_2(p2, a, k, a2n);
+   if((a == b) && (an == bn))
+   {
+      // Squaring, evaluate just once so that the pointwise products are squares too:
+      rm1_neg = false;
+      q1 = p1;
+      qm1 = pm1;
+      q2 = p2;
+   }
+   else
+   {
+      rm1_neg ^= toom3_evaluate_at_1(q1, qm1, b, k, b2n);
+      toom3_evaluate_at_2(q2, b, k, b2n);
+   }
+   //
+   // Pointwise products, r(0) and r(infinity) go straight into the result:
+   //
+   multiply_limbs_recursive(r, a, k, b, k, next);
+   multiply_limbs_recursive(r + 4 * k, a + 2 * k, a2n, b + 2 * k, b2n, next);
+   multiply_limbs_recursive(r1, p1, w, q1, w, next);
+   multiply_limbs_recursive(rm1, pm1, w, qm1, w, next);
+   multiply_limbs_recursive(r2, p2, w, q2, w, next);
+   //
+   // Interpolation, at the end r1, rm1 and r2 hold the coefficients of B^k, B^2k and B^3k:
+   //
+   bool r2_neg = add_signed_limbs(r2, r2, false, rm1, !rm1_neg, pw);    // r3 = (r(2) - r(-1)) / 3
+   divide_limbs_by_3(r2, pw);
+   add_signed_limbs(r1, r1, false, rm1, !rm1_neg, pw);                  // r1 = (r(1) - r(-1)) / 2
+   divide_limbs_by_2(r1, pw);
+   std::memcpy(t, r, 2 * k * sizeof(limb_type));
+   std::fill(t + 2 * k, t + pw, static_cast<limb_type>(0u));
+   rm1_neg = add_signed_limbs(rm1, rm1, rm1_neg, t, true, pw);           // r2 = r(-1) - r(0)
+   r2_neg = add_signed_limbs(r2, r2, r2_neg, rm1, !rm1_neg, pw);        // r3 = (r3 - r2) / 2 - 2 r(inf)
+   divide_limbs_by_2(r2, pw);
+   std::memcpy(t, r + 4 * k, (a2n + b2n) * sizeof(limb_type));
+   std::fill(t + a2n + b2n, t + pw, static_cast<limb_type>(0u));
+   r2_neg = add_signed_limbs(r2, r2, r2_neg, t, true, pw);
+   r2_neg = add_signed_limbs(r2, r2, r2_neg, t, true, pw);
+   rm1_neg = add_signed_limbs(rm1, rm1, rm1_neg, r1, false, pw);        // r2 = r2 + r1 - r(inf)
+   rm1_neg = add_signed_limbs(rm1, rm1, rm1_neg, t, true, pw);
+   r2_neg = add_signed_limbs(r2, r2, r2_neg, r1, true, pw);             // r3 = r3 - r1
+   bool r1_neg = add_signed_limbs(r1, r1, false, r2, !r2_neg, pw);      // r1 = r1 - r3
+   BOOST_ASSERT(!r1_neg && !rm1_neg && !r2_neg);
+   (void)r1_neg;
+   //
+   // Recomposition:
+   //
+   unsigned rn = an + bn;
+   std::fill(r + 2 * k, r + 4 * k, static_cast<limb_type>(0u));
+   add_limbs_into(r + k, rn - k, r1, pw);
+   add_limbs_into(r + 2 * k, rn - 2 * k, rm1, pw);
+   add_limbs_into(r + 3 * k, rn - 3 * k, r2, pw);
+}
+//
+// Multiplication where an is much larger than bn: slice a up into bn-sized chunks
+// and accumulate the partial products:
+//
+inline void multiply_limbs_unbalanced(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch)
+{
+   limb_type* t = scratch;
+   limb_type* next = t + 2 * bn;
+   std::memset(r, 0, (an + bn) * sizeof(limb_type));
+   for(unsigned i = 0; i < an; i += bn)
+   {
+      unsigned len = (std::min)(bn, an - i);
+      multiply_limbs_recursive(t, b, bn, a + i, len, next);
+      add_limbs_into(r + i, an + bn - i, t, bn + len);
+   }
+}
+//
+// r[0, an + bn) = a * b, picks the best algorithm for the operand sizes, scratch must
+// have room for multiply_limbs_scratch_size(max(an, bn)) limbs.  Passing the same
+// pointer and size for a and b selects the squaring variants:
+//
+inline void multiply_limbs_recursive(limb_type* r, const limb_type* a, unsigned an, const limb_type* b, unsigned bn, limb_type* scratch)
+{
+   if(an < bn)
+   {
+      std::swap(a, b);
+      std::swap(an, bn);
+   }
+   if((bn < BOOST_MP_KARATSUBA_CUTOFF) && (a == b) && (an == bn))
+      square_limbs_schoolbook(r, a, an);
+   else if(bn < BOOST_MP_KARATSUBA_CUTOFF)
+      multiply_limbs_schoolbook(r, a, an, b, bn);
+   else if((bn >= BOOST_MP_NTT_CUTOFF) && ntt_multiply_supported(an, bn))
+      multiply_limbs_ntt(r, a, an, b, bn, scratch);
+   else if((bn >= BOOST_MP_TOOM3_CUTOFF) && (bn > 2 * ((an + 2) / 3)))
+      multiply_limbs_toom3(r, a, an, b, bn, scratch);
+   else if(bn > (an + 1) / 2)
+      multiply_limbs_karatsuba(r, a, an, b, bn, scratch);
+   else
+      multiply_limbs_unbalanced(r, a, an, b, bn, scratch);
+}
+//
+// Scratch storage for the above, obtained with a single allocation from the
+// result's allocator, or from std::allocator when the result is fixed precision:
+//
+template <class Allocator>
+class scoped_limb_storage
+{
+   Allocator  m_alloc;
+   limb_type* m_data;
+   unsigned   m_size;
+
+   scoped_limb_storage(const scoped_limb_storage&);
+   scoped_limb_storage& operator=(const scoped_limb_storage&);
+public:
+   scoped_limb_storage(const Allocator& a, unsigned n) : m_alloc(a), m_data(n ? m_alloc.allocate(n) : 0), m_size(n) {}
+   ~scoped_limb_storage()
+   {
+      if(m_data)
+         m_alloc.deallocate(m_data, m_size);
+   }
+   limb_type* data() { return m_data; }
+};
+
+template <class CppInt>
+inline typename CppInt::allocator_type scratch_allocator(const CppInt& i, const mpl::false_&)
+{
+   return i.allocator();
+}
+template <class CppInt>
+inline std::allocator<limb_type> scratch_allocator(const CppInt&, const mpl::true_&)
+{
+   return std::allocator<limb_type>();
+}
+
+template <class Allocator>
+struct scratch_allocator_type
+{
+   typedef typename detail::rebind<limb_type, Allocator>::type type;
+};
+template <>
+struct scratch_allocator_type<void>
+{
+   typedef std::allocator<limb_type> type;
+};
+//
+// True when multiplying into CppInt uses stack scratch storage, the limbs needed are the scratch
+// for operands of up to the size of the result, plus room for the untruncated product:
+//
+template <class CppInt>
+struct multiply_scratch_on_stack
+{
+   BOOST_STATIC_CONSTANT(unsigned, limbs = multiply_limbs_scratch_bound<CppInt::internal_limb_count>::value + 2 * CppInt::internal_limb_count);
+   BOOST_STATIC_CONSTANT(bool, value = !CppInt::variable && (limbs <= BOOST_MP_MULTIPLY_STACK_LIMBS));
+};
+//
+// Sets result to the product of the magnitudes of a and b using the recursive routines above,
+// for fixed precision types the full product is formed in scratch storage and then truncated
+// (or an overflow_error thrown if result is checked).  This version uses stack storage:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void multiply_recursive(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, const mpl::true_&)
+{
+   typedef cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> result_type;
+   static const unsigned max_limbs = result_type::internal_limb_count;
+   static const unsigned scratch_size = multiply_limbs_scratch_bound<max_limbs>::value;
+
+   result.resize(as + bs, as + bs - 1);
+   //
+   // Only the low max_limbs limbs of each operand contribute to the truncated product, and if
+   // either is larger than that an overflow_error has already been thrown for checked types:
+   //
+   if(as > max_limbs)
+      as = max_limbs;
+   if(bs > max_limbs)
+      bs = max_limbs;
+   BOOST_ASSERT(multiply_limbs_scratch_size((std::max)(as, bs)) <= scratch_size);
+   limb_type storage[multiply_scratch_on_stack<result_type>::limbs];
+   if(result.size() == as + bs)
+      multiply_limbs_recursive(result.limbs(), pa, as, pb, bs, storage);
+   else
+   {
+      limb_type* t = storage + scratch_size;
+      multiply_limbs_recursive(t, pa, as, pb, bs, storage);
+      unsigned n = as + bs;
+      while((n > 1) && !t[n - 1])
+         --n;
+      result.resize(n, n);
+      std::memcpy(result.limbs(), t, result.size() * sizeof(limb_type));
+   }
+   result.normalize();
+}
+//
+// And this one allocates it, from the result's allocator if it has one:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void multiply_recursive(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, const mpl::false_&)
+{
+   typedef typename scratch_allocator_type<Allocator1>::type allocator_type;
+
+   unsigned scratch_size = multiply_limbs_scratch_size((std::max)(as, bs));
+   result.resize(as + bs, as + bs - 1);
+   if(result.size() == as + bs)
+   {
+      scoped_limb_storage<allocator_type> storage(scratch_allocator(result, is_void<Allocator1>()), scratch_size);
+      multiply_limbs_recursive(result.limbs(), pa, as, pb, bs, storage.data());
+   }
+   else
+   {
+      scoped_limb_storage<allocator_type> storage(scratch_allocator(result, is_void<Allocator1>()), scratch_size + as + bs);
+      limb_type* t = storage.data() + scratch_size;
+      multiply_limbs_recursive(t, pa, as, pb, bs, storage.data());
+      unsigned n = as + bs;
+      while((n > 1) && !t[n - 1])
+         --n;
+      result.resize(n, n);
+      std::memcpy(result.limbs(), t, result.size() * sizeof(limb_type));
+   }
+   result.normalize();
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void multiply_recursive(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs)
+{
+   multiply_recursive(result, pa, as, pb, bs, mpl::bool_<multiply_scratch_on_stack<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>());
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
    eval_multiply(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
-      const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
+      const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && multiply_scratch_on_stack<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
-   // Very simple long multiplication, only usable for small numbers of limb_type's
-   // but that's the typical use case for this type anyway:
+   // Very simple long multiplication for small numbers of limb_type's, larger
+   // values are handed off to the Karatsuba, Toom-3 and NTT routines above:
    //
    // Special cases first:
    //
+   if((void*)&a == (void*)&b)
+   {
+      eval_square(result, a);
+      return;
+   }
    unsigned as = a.size();
    unsigned bs = b.size();
    typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pa = a.limbs();
@@ -124,6 +921,13 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       return;
    }
 
+   if((as >= BOOST_MP_KARATSUBA_CUTOFF) && (bs >= BOOST_MP_KARATSUBA_CUTOFF))
+   {
+      multiply_recursive(result, pa, as, pb, bs);
+      result.sign(a.sign() != b.sign());
+      return;
+   }
+
    result.resize(as + bs, as + bs - 1);
    typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer pr = result.limbs();
 
@@ -131,43 +935,17 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    static const double_limb_type double_limb_max = ~static_cast<double_limb_type>(0u);
    BOOST_STATIC_ASSERT(double_limb_max - 2 * limb_max >= limb_max * limb_max);
 
-   double_limb_type carry = 0;
    std::memset(pr, 0, result.size() * sizeof(limb_type));
    for(unsigned i = 0; i < as; ++i)
    {
       unsigned inner_limit = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::variable ? bs : (std::min)(result.size() - i, bs);
-      unsigned j;
-      for(j = 0; j < inner_limit; ++j)
-      {
-         BOOST_ASSERT(i+j < result.size());
-#if (!defined(__GLIBCXX__) && !defined(__GLIBCPP__)) || !BOOST_WORKAROUND(BOOST_GCC_VERSION, <= 50100)
-         BOOST_ASSERT(!std::numeric_limits<double_limb_type>::is_specialized 
-            || ((std::numeric_limits<double_limb_type>::max)() - carry 
-                  > 
-                static_cast<double_limb_type>(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value) * static_cast<double_limb_type>(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value)));
-#endif
-         carry += static_cast<double_limb_type>(pa[i]) * static_cast<double_limb_type>(pb[j]);
-         BOOST_ASSERT(!std::numeric_limits<double_limb_type>::is_specialized || ((std::numeric_limits<double_limb_type>::max)() - carry >= pr[i+j]));
-         carry += pr[i + j];
-#ifdef __MSVC_RUNTIME_CHECKS
-         pr[i + j] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-         pr[i + j] = static_cast<limb_type>(carry);
-#endif
-         carry >>= cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
-         BOOST_ASSERT(carry <= (cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value));
-      }
+      limb_type carry = addmul_1(pr + i, pb, inner_limit, pa[i]);
       if(carry)
       {
-         resize_for_carry(result, i + j + 1);  // May throw if checking is enabled
-         if(i + j < result.size())
-#ifdef __MSVC_RUNTIME_CHECKS
-            pr[i + j] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-            pr[i + j] = static_cast<limb_type>(carry);
-#endif
+         resize_for_carry(result, i + inner_limit + 1);  // May throw if checking is enabled
+         if(i + inner_limit < result.size())
+            pr[i + inner_limit] = carry;
       }
-      carry = 0;
    }
    result.normalize();
    //
@@ -180,10 +958,58 @@ template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_
 BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_multiply(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
-      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && multiply_scratch_on_stack<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
     eval_multiply(result, result, a);
 }
+//
+// Squaring, needs only half as many limb products as a general multiply:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+   eval_square(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && multiply_scratch_on_stack<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
+{
+   unsigned as = a.size();
+   typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pa = a.limbs();
+   if(as == 1)
+   {
+      result = static_cast<double_limb_type>(*pa) * static_cast<double_limb_type>(*pa);
+      return;
+   }
+   if((void*)&result == (void*)&a)
+   {
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(a);
+      eval_square(result, t);
+      return;
+   }
+   if(as >= BOOST_MP_KARATSUBA_CUTOFF)
+   {
+      multiply_recursive(result, pa, as, pa, as);
+      result.sign(false);
+      return;
+   }
+   result.resize(2 * as, 2 * as - 1);
+   if(result.size() == 2 * as)
+      square_limbs_schoolbook(result.limbs(), pa, as);
+   else
+   {
+      //
+      // Fixed precision result too small for the full square, form it on the stack
+      // and then truncate (or throw if result is checked):
+      //
+      limb_type t[2 * BOOST_MP_KARATSUBA_CUTOFF];
+      square_limbs_schoolbook(t, pa, as);
+      unsigned n = 2 * as;
+      while((n > 1) && !t[n - 1])
+         --n;
+      result.resize(n, n);
+      std::memcpy(result.limbs(), t, result.size() * sizeof(limb_type));
+   }
+   result.normalize();
+   result.sign(false);
+}
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type 
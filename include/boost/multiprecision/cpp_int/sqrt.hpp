@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// Integer square root with remainder for cpp_int_backend.
+//
+#ifndef BOOST_MP_CPP_INT_SQRT_HPP
+#define BOOST_MP_CPP_INT_SQRT_HPP
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+//
+// r = the count limbs of x starting at limb offset:
+//
+inline void sqrt_extract_limbs(cpp_int_backend<>& r, const cpp_int_backend<>& x, unsigned offset, unsigned count)
+{
+   unsigned n = x.size() > offset ? (std::min)(count, x.size() - offset) : 0;
+   if(n == 0)
+   {
+      r = static_cast<limb_type>(0u);
+      return;
+   }
+   r.resize(n, n);
+   std::memcpy(r.limbs(), x.limbs() + offset, n * sizeof(limb_type));
+   r.normalize();
+}
+//
+// Square root and remainder of a value of at most 2 limbs, by Newton iteration from above
+// starting from a power of 2 greater than the root:
+//
+inline void sqrt_basecase(cpp_int_backend<>& s, cpp_int_backend<>& r, const cpp_int_backend<>& x)
+{
+   BOOST_ASSERT(x.size() <= 2);
+   limb_type hi = x.size() > 1 ? x.limbs()[1] : 0;
+   limb_type lo = x.limbs()[0];
+   double_limb_type v = (static_cast<double_limb_type>(hi) << bits_per_limb) | lo;
+   if(v == 0)
+   {
+      s = r = static_cast<limb_type>(0u);
+      return;
+   }
+   unsigned g = hi ? boost::multiprecision::detail::find_msb(hi) + bits_per_limb : boost::multiprecision::detail::find_msb(lo);
+   double_limb_type root = static_cast<double_limb_type>(1u) << (g / 2 + 1);
+   for(;;)
+   {
+      double_limb_type t = (root + v / root) >> 1;
+      if(t >= root)
+         break;
+      root = t;
+   }
+   s = static_cast<limb_type>(root);
+   r = static_cast<double_limb_type>(v - root * root);
+}
+//
+// Zimmermann's "Karatsuba square root" (INRIA research report 3805): s = floor(sqrt(x)) and
+// r = x - s^2, where x has at most 2n limbs and x >= B^2n / 4.  Writing x = a3 B^3l + a2 B^2l + a1 B^l + a0
+// the root of the top half is found recursively, and the next l limbs of the root come from a
+// single division of the remainder by twice that root, which is then corrected by at most 1.
+// There's only one recursive call so the cost is dominated by the division at the top level:
+//
+inline void sqrt_rem_recursive(cpp_int_backend<>& s, cpp_int_backend<>& r, const cpp_int_backend<>& x, unsigned n)
+{
+   if(n == 1)
+   {
+      sqrt_basecase(s, r, x);
+      return;
+   }
+   unsigned l = n / 2;
+   unsigned h = n - l;
+   cpp_int_backend<> xh, a, q, u, t;
+   sqrt_extract_limbs(xh, x, 2 * l, 2 * h);
+   sqrt_rem_recursive(s, r, xh, h);
+   //
+   // (q, u) = divrem(r' B^l + a1, 2s'):
+   //
+   sqrt_extract_limbs(a, x, l, l);
+   eval_left_shift(r, l * bits_per_limb);
+   eval_add(r, a);
+   t = s;
+   eval_left_shift(t, 1);
+   eval_qr(r, t, q, u);
+   //
+   // s = s' B^l + q and r = u B^l + a0 - q^2:
+   //
+   eval_left_shift(s, l * bits_per_limb);
+   eval_add(s, q);
+   sqrt_extract_limbs(a, x, 0, l);
+   r.swap(u);
+   eval_left_shift(r, l * bits_per_limb);
+   eval_add(r, a);
+   eval_multiply(t, q, q);
+   eval_subtract(r, t);
+   if(r.sign())
+   {
+      // s was one too large, r += 2s - 1 and s -= 1:
+      eval_add(r, s);
+      eval_add(r, s);
+      eval_subtract(r, static_cast<limb_type>(1u));
+      eval_subtract(s, static_cast<limb_type>(1u));
+   }
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_integer_sqrt(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& s,
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& r,
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x)
+{
+   using default_ops::eval_get_sign;
+   using default_ops::eval_msb;
+
+   if(eval_get_sign(x) == 0)
+   {
+      s = r = static_cast<limb_type>(0u);
+      return;
+   }
+   unsigned g = eval_msb(x);
+   //
+   // Normalize so that the value has an even number of limbs with one of the top two bits set,
+   // the root is then shifted back at the end and the remainder recomputed:
+   //
+   unsigned n = (x.size() + 1) / 2;
+   unsigned shift = (2 * n * bits_per_limb - 1 - g) / 2;
+   cpp_int_backend<> y(x), root, rem;
+   eval_left_shift(y, 2 * shift);
+   sqrt_rem_recursive(root, rem, y, n);
+   if(shift)
+   {
+      eval_right_shift(root, shift);
+      y = x;
+      eval_multiply(rem, root, root);
+      eval_subtract(y, rem);
+      rem.swap(y);
+   }
+   s = root;
+   r = rem;
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+}}} // namespaces
+
+#endif
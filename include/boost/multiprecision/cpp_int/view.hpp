@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// A read-only view of the limbs of a cpp_int, or of an integer stored in memory owned by someone else.
+//
+#ifndef BOOST_MP_CPP_INT_VIEW_HPP
+#define BOOST_MP_CPP_INT_VIEW_HPP
+
+#if !defined(BOOST_MP_NO_STD_SPAN) && defined(__has_include)
+#  if __has_include(<span>)
+#    include <span>
+#    ifdef __cpp_lib_span
+#      define BOOST_MP_HAS_STD_SPAN
+#    endif
+#  endif
+#endif
+
+namespace boost{ namespace multiprecision{
+
+//
+// Refers to a sequence of limbs, least significant first, plus a sign, without owning them: either those of
+// an existing (non-trivial) cpp_int, or an external buffer such as a memory mapped file or network packet,
+// so that the value can be hashed, compared and written out without first being copied into a cpp_int.
+// The limbs must stay valid and unchanged for as long as the view is in use, in particular a view of a
+// cpp_int is invalidated by any change to that value:
+//
+class cpp_int_view
+{
+public:
+   typedef limb_type        value_type;
+   typedef const limb_type* const_iterator;
+   typedef const limb_type* iterator;
+   typedef std::size_t      size_type;
+
+   cpp_int_view() BOOST_NOEXCEPT : m_limbs(&zero_limb()), m_size(1), m_sign(false) {}
+   //
+   // Adopts the n limbs at p, which must be suitably aligned for limb_type and in native byte order:
+   //
+   cpp_int_view(const limb_type* p, std::size_t n, bool negative = false) BOOST_NOEXCEPT
+      : m_limbs(p), m_size(n), m_sign(negative)
+   {
+      normalize();
+   }
+   template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
+   cpp_int_view(const cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>& val) BOOST_NOEXCEPT
+      : m_limbs(val.limbs()), m_size(val.size()), m_sign(val.sign())
+   {
+      BOOST_STATIC_ASSERT_MSG((!backends::is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value), "Trivial cpp_int's have no limbs to view.");
+   }
+   template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+   cpp_int_view(const number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& val) BOOST_NOEXCEPT
+      : m_limbs(val.backend().limbs()), m_size(val.backend().size()), m_sign(val.backend().sign())
+   {
+      BOOST_STATIC_ASSERT_MSG((!backends::is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value), "Trivial cpp_int's have no limbs to view.");
+   }
+#ifdef BOOST_MP_HAS_STD_SPAN
+   explicit cpp_int_view(std::span<const limb_type> limbs, bool negative = false) BOOST_NOEXCEPT
+      : m_limbs(limbs.data()), m_size(limbs.size()), m_sign(negative)
+   {
+      normalize();
+   }
+   std::span<const limb_type> span()const BOOST_NOEXCEPT { return std::span<const limb_type>(m_limbs, m_size); }
+#endif
+
+   const limb_type* limbs()const BOOST_NOEXCEPT { return m_limbs; }
+   std::size_t size()const BOOST_NOEXCEPT { return m_size; }
+   bool sign()const BOOST_NOEXCEPT { return m_sign; }
+   const_iterator begin()const BOOST_NOEXCEPT { return m_limbs; }
+   const_iterator end()const BOOST_NOEXCEPT { return m_limbs + m_size; }
+   bool is_zero()const BOOST_NOEXCEPT { return (m_size == 1) && !*m_limbs; }
+
+   int compare(const cpp_int_view& o)const BOOST_NOEXCEPT
+   {
+      if(m_sign != o.m_sign)
+         return m_sign ? -1 : 1;
+      int result = 0;
+      if(m_size != o.m_size)
+         result = m_size > o.m_size ? 1 : -1;
+      else
+      {
+         for(std::size_t i = m_size; i > 0; --i)
+         {
+            if(m_limbs[i - 1] != o.m_limbs[i - 1])
+            {
+               result = m_limbs[i - 1] > o.m_limbs[i - 1] ? 1 : -1;
+               break;
+            }
+         }
+      }
+      return m_sign ? -result : result;
+   }
+
+   friend bool operator == (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) == 0; }
+   friend bool operator != (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) != 0; }
+   friend bool operator <  (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) < 0; }
+   friend bool operator >  (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) > 0; }
+   friend bool operator <= (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) <= 0; }
+   friend bool operator >= (const cpp_int_view& a, const cpp_int_view& b) BOOST_NOEXCEPT { return a.compare(b) >= 0; }
+
+   //
+   // Gives the same result as hash_value for a cpp_int with the same value:
+   //
+   friend std::size_t hash_value(const cpp_int_view& val) BOOST_NOEXCEPT
+   {
+      std::size_t result = 0;
+      for(std::size_t i = 0; i < val.m_size; ++i)
+         boost::hash_combine(result, val.m_limbs[i]);
+      boost::hash_combine(result, val.m_sign);
+      return result;
+   }
+
+private:
+   static const limb_type& zero_limb() BOOST_NOEXCEPT
+   {
+      static const limb_type zero = 0;
+      return zero;
+   }
+   //
+   // Strip leading zero limbs the same way cpp_int does, so that equal values have equal views:
+   //
+   void normalize() BOOST_NOEXCEPT
+   {
+      while(m_size && !m_limbs[m_size - 1])
+         --m_size;
+      if(!m_size)
+      {
+         m_limbs = &zero_limb();
+         m_size = 1;
+         m_sign = false;
+      }
+   }
+
+   const limb_type* m_limbs;
+   std::size_t      m_size;
+   bool             m_sign;
+};
+
+namespace detail{
+
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
+inline void assign_view(cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>& result, const cpp_int_view& v, const mpl::false_&)
+{
+   if(v.limbs() != result.limbs())
+   {
+      result.resize(static_cast<unsigned>(v.size()), static_cast<unsigned>(v.size()));  // checked types may throw here if they're not large enough to hold the data!
+      std::memcpy(result.limbs(), v.limbs(), result.size() * sizeof(limb_type));
+      result.normalize();
+   }
+   result.sign(v.sign());
+}
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
+inline void assign_view(cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>& result, const cpp_int_view& v, const mpl::true_&)
+{
+   typedef typename cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>::local_limb_type local_limb_type;
+   static const std::size_t limbs_needed = sizeof(local_limb_type) > sizeof(limb_type) ? sizeof(local_limb_type) / sizeof(limb_type) : 1;
+   local_limb_type value = 0;
+   for(std::size_t i = 0; (i < v.size()) && (i < limbs_needed); ++i)
+      value |= static_cast<local_limb_type>(v.limbs()[i]) << (i * sizeof(limb_type) * CHAR_BIT);
+   if((v.size() > limbs_needed) || (static_cast<limb_type>(value) != v.limbs()[0]))
+      result.resize(2, 2); // May throw!
+   result.sign(false);
+   *result.limbs() = value;
+   result.normalize();
+   result.sign(v.sign());
+}
+
+}
+
+//
+// Sets val to the value of the view with a single copy of the limbs, values which don't fit in a
+// fixed precision type are truncated, or throw if the type is checked:
+//
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+inline number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>&
+   import_bits(number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& val, const cpp_int_view& v)
+{
+   detail::assign_view(val.backend(), v, typename cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>::trivial_tag());
+   return val;
+}
+
+//
+// As export_bits for a cpp_int, writes the magnitude only:
+//
+template <class OutputIterator>
+OutputIterator export_bits(const cpp_int_view& val, OutputIterator out, unsigned chunk_size, bool msv_first = true)
+{
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4244)
+#endif
+   if(val.is_zero())
+   {
+      *out = 0;
+      ++out;
+      return out;
+   }
+   unsigned bitcount = static_cast<unsigned>(val.size() - 1) * sizeof(limb_type) * CHAR_BIT + boost::multiprecision::detail::find_msb(val.limbs()[val.size() - 1]) + 1;
+
+   int bit_location = msv_first ? bitcount - chunk_size : 0;
+   int bit_step = msv_first ? -static_cast<int>(chunk_size) : chunk_size;
+   while(bit_location % bit_step) ++bit_location;
+
+   do
+   {
+      *out = detail::extract_bits(val, bit_location, chunk_size, mpl::false_());
+      ++out;
+      bit_location += bit_step;
+   } while((bit_location >= 0) && (bit_location < (int)bitcount));
+
+   return out;
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+}
+
+}} // namespaces
+
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+
+namespace std {
+
+   template <>
+   struct hash<boost::multiprecision::cpp_int_view>
+   {
+      std::size_t operator()(const boost::multiprecision::cpp_int_view& val)const { return hash_value(val); }
+   };
+
+}
+
+#endif
+
+#endif
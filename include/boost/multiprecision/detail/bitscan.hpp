@@ -259,7 +259,45 @@ BOOST_FORCEINLINE unsigned find_msb(Unsigned mask)
 }
 #endif
 
+//
+// The number of bits set in mask:
+//
+template <class Unsigned>
+inline unsigned count_bits(Unsigned mask, const mpl::int_<0>&)
+{
+   unsigned result = 0;
+   while(mask)
+   {
+      mask &= mask - 1;
+      ++result;
+   }
+   return result;
+}
+#if defined(BOOST_GCC) || defined(__clang__) || (defined(BOOST_INTEL) && defined(__GNUC__))
+template <class Unsigned>
+BOOST_FORCEINLINE unsigned count_bits(Unsigned mask, const mpl::int_<1>&)
+{
+   return static_cast<unsigned>(__builtin_popcountll(static_cast<boost::ulong_long_type>(mask)));
+}
+template <class Unsigned>
+BOOST_FORCEINLINE unsigned count_bits(Unsigned mask)
+{
+   typedef typename make_unsigned<Unsigned>::type ui_type;
+   typedef typename mpl::if_c<
+      sizeof(Unsigned) <= sizeof(boost::ulong_long_type),
+      mpl::int_<1>,
+      mpl::int_<0>
+   >::type tag_type;
+   return count_bits(static_cast<ui_type>(mask), tag_type());
+}
+#else
+template <class Unsigned>
+BOOST_FORCEINLINE unsigned count_bits(Unsigned mask)
+{
+   return count_bits(mask, mpl::int_<0>());
+}
+#endif
+
 }}}
 
 #endif
-
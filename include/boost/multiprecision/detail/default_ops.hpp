@@ -367,10 +367,26 @@ inline void eval_subtract(T& t, const U& u, const V& v)
    eval_subtract_default(t, u, v);
 }
 
+//
+// Squaring, backends with a faster way of squaring than multiplying overload this,
+// it's used whenever both operands of a multiply are the same object:
+//
+template <class T, class U>
+inline void eval_square(T& t, const U& u)
+{
+   if((void*)&t != (void*)&u)
+      t = number<T>::canonical_value(u);
+   eval_multiply(t, t);
+}
+
 template <class T>
 inline void eval_multiply_default(T& t, const T& u, const T& v)
 {
-   if(&t == &v)
+   if(&u == &v)
+   {
+      eval_square(t, u);
+   }
+   else if(&t == &v)
    {
       eval_multiply(t, u);
    }
@@ -407,7 +423,11 @@ inline typename enable_if_c<is_convertible<U, number<T, et_on> >::value>::type e
 template <class T, class U, class V>
 inline void eval_multiply_default(T& t, const U& u, const V& v)
 {
-   if(is_same<T, V>::value && ((void*)&t == (void*)&v))
+   if(is_same<U, V>::value && ((void*)&u == (void*)&v))
+   {
+      eval_square(t, u);
+   }
+   else if(is_same<T, V>::value && ((void*)&t == (void*)&v))
    {
       eval_multiply(t, u);
    }
@@ -1474,6 +1494,24 @@ inline int eval_msb(const T& val)
    return --result;
 }
 
+template <class T>
+inline unsigned eval_popcount(const T& val)
+{
+   int c = eval_get_sign(val);
+   if(c < 0)
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Counting the bits in negative values is not supported - results are undefined."));
+   }
+   unsigned result = 0;
+   T t(val);
+   while(!eval_is_zero(t))
+   {
+      eval_bit_unset(t, eval_lsb(t));
+      ++result;
+   }
+   return result;
+}
+
 template <class T>
 inline bool eval_bit_test(const T& val, unsigned index)
 {
@@ -1521,17 +1559,16 @@ template <class B>
 void eval_integer_sqrt(B& s, B& r, const B& x)
 {
    //
-   // This is slow bit-by-bit integer square root, see for example
-   // http://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Binary_numeral_system_.28base_2.29
-   // There are better methods such as http://hal.inria.fr/docs/00/07/28/54/PDF/RR-3805.pdf
-   // and http://hal.inria.fr/docs/00/07/21/13/PDF/RR-4475.pdf which should be implemented
-   // at some point.
+   // Newton iteration from above, starting from a power of 2 larger than the root: the
+   // sequence then decreases monotonically until it reaches floor(sqrt(x)).  Backends with
+   // fast division may do better with the recursive method of
+   // http://hal.inria.fr/docs/00/07/28/54/PDF/RR-3805.pdf as cpp_int does.
    //
    typedef typename boost::multiprecision::detail::canonical<unsigned char, B>::type ui_type;
 
-   s = ui_type(0u);
    if(eval_get_sign(x) == 0)
    {
+      s = ui_type(0u);
       r = ui_type(0u);
       return;
    }
@@ -1542,38 +1579,22 @@ void eval_integer_sqrt(B& s, B& r, const B& x)
       eval_subtract(r, x, s);
       return;
    }
-   
-   B t;
-   r = x;
-   g /= 2;
-   int org_g = g;
-   eval_bit_set(s, g);
-   eval_bit_set(t, 2 * g);
-   eval_subtract(r, x, t);
-   --g;
-   if(eval_get_sign(r) == 0)
-      return;
-   int msbr = eval_msb(r);
-   do
+
+   B root, t;
+   root = ui_type(0u);
+   eval_bit_set(root, g / 2 + 1);
+   for(;;)
    {
-      if(msbr >= org_g + g + 1)
-      {
-         t = s;
-         eval_left_shift(t, g + 1);
-         eval_bit_set(t, 2 * g);
-         if(t.compare(r) <= 0)
-         {
-            BOOST_ASSERT(g >= 0);
-            eval_bit_set(s, g);
-            eval_subtract(r, t);
-            if(eval_get_sign(r) == 0)
-               return;
-            msbr = eval_msb(r);
-         }
-      }
-      --g;
+      eval_divide(t, x, root);
+      eval_add(t, root);
+      eval_right_shift(t, 1);
+      if(t.compare(root) >= 0)
+         break;
+      root.swap(t);
    }
-   while(g >= 0);
+   eval_multiply(t, root, root);
+   eval_subtract(r, x, t);
+   s.swap(root);
 }
 
 template <class B>
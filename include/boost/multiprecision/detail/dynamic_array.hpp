@@ -9,6 +9,7 @@
   #define BOOST_MP_DETAIL_DYNAMIC_ARRAY_HPP
 
   #include <vector>
+  #include <algorithm>
   #include <boost/multiprecision/detail/rebind.hpp>
 
   namespace boost { namespace multiprecision { namespace backends { namespace detail
@@ -23,6 +24,21 @@
 
              value_type* data()       { return &(*(this->begin())); }
        const value_type* data() const { return &(*(this->begin())); }
+
+       // Both arrays always hold elem_number elements, so when the allocators
+       // may not be exchanged the elements are swapped in place instead:
+       void swap(dynamic_array& other)
+       {
+#ifndef BOOST_NO_CXX11_ALLOCATOR
+          typedef std::allocator_traits<typename rebind<value_type, my_allocator>::type> traits_type;
+          if(!traits_type::propagate_on_container_swap::value && (this->get_allocator() != other.get_allocator()))
+          {
+             std::swap_ranges(this->begin(), this->end(), other.begin());
+             return;
+          }
+#endif
+          std::vector<value_type, typename rebind<value_type, my_allocator>::type>::swap(other);
+       }
     };
   } } } } // namespace boost::multiprecision::backends::detail
 
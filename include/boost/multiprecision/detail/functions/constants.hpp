@@ -254,6 +254,7 @@ const T& get_constant_ln2()
    if ((digits != boost::multiprecision::detail::digits2<number<T> >::value()))
    {
 #endif
+      boost::multiprecision::detail::maybe_promote_precision(&result);
       calc_log2(result, boost::multiprecision::detail::digits2<number<T, et_on> >::value());
       digits = boost::multiprecision::detail::digits2<number<T> >::value();
    }
@@ -277,6 +278,7 @@ const T& get_constant_e()
    if ((digits != boost::multiprecision::detail::digits2<number<T> >::value()))
    {
 #endif
+      boost::multiprecision::detail::maybe_promote_precision(&result);
       calc_e(result, boost::multiprecision::detail::digits2<number<T, et_on> >::value());
       digits = boost::multiprecision::detail::digits2<number<T> >::value();
    }
@@ -300,6 +302,7 @@ const T& get_constant_pi()
    if ((digits != boost::multiprecision::detail::digits2<number<T> >::value()))
    {
 #endif
+      boost::multiprecision::detail::maybe_promote_precision(&result);
       calc_pi(result, boost::multiprecision::detail::digits2<number<T, et_on> >::value());
       digits = boost::multiprecision::detail::digits2<number<T> >::value();
    }
@@ -323,6 +326,7 @@ const T& get_constant_one_over_epsilon()
    if ((digits != boost::multiprecision::detail::digits2<number<T> >::value()))
    {
 #endif
+      boost::multiprecision::detail::maybe_promote_precision(&result);
       typedef typename mpl::front<typename T::unsigned_types>::type ui_type;
       result = static_cast<ui_type>(1u);
       eval_divide(result, std::numeric_limits<number<T> >::epsilon().backend());
@@ -54,7 +54,7 @@ inline void pow_imp(T& result, const T& t, const U& p, const mpl::false_&)
    while(U(p2 /= 2) != U(0))
    {
       // Square x for each binary power.
-      eval_multiply(x, x);
+      eval_square(x, x);
 
       const bool has_binary_power = (U(p2 % U(2)) != U(0));
 
@@ -436,6 +436,7 @@ const T& get_constant_log10()
    if ((digits != boost::multiprecision::detail::digits2<number<T> >::value()))
    {
 #endif
+      boost::multiprecision::detail::maybe_promote_precision(&result);
       typedef typename boost::multiprecision::detail::canonical<unsigned, T>::type ui_type;
       T ten;
       ten = ui_type(10u);
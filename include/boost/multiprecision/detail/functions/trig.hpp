@@ -534,7 +534,7 @@ void eval_asin(T& result, const T& x)
    // we've just added will finish the job...
 
    boost::intmax_t current_precision = eval_ilogb(result);
-   boost::intmax_t target_precision = current_precision - 1 - (std::numeric_limits<number<T> >::digits * 2) / 3;
+   boost::intmax_t target_precision = current_precision - 1 - (static_cast<boost::intmax_t>(std::numeric_limits<number<T> >::is_specialized ? std::numeric_limits<number<T> >::digits : boost::multiprecision::detail::digits2<number<T> >::value()) * 2) / 3;
 
    // Newton-Raphson iteration
    while(current_precision > target_precision)
@@ -686,7 +686,7 @@ void eval_atan(T& result, const T& x)
    // we've just added will finish the job...
 
    boost::intmax_t current_precision = eval_ilogb(result);
-   boost::intmax_t target_precision = current_precision - 1 - (std::numeric_limits<number<T> >::digits * 2) / 3;
+   boost::intmax_t target_precision = current_precision - 1 - (static_cast<boost::intmax_t>(std::numeric_limits<number<T> >::is_specialized ? std::numeric_limits<number<T> >::digits : boost::multiprecision::detail::digits2<number<T> >::value()) * 2) / 3;
 
    T s, c, t;
    while(current_precision > target_precision)
@@ -124,6 +124,85 @@ inline void eval_lcm(B& result, const B& a, const B& b)
    if(eval_get_sign(result) < 0)
       result.negate();
 }
+//
+// Extended Euclidean algorithm: g = gcd(a, b) >= 0 and g = s * a + t * b.  Only the cofactor of a is
+// tracked, t is recovered at the end by an exact division:
+//
+template <class B>
+void eval_gcdext(B& g, B& s, B& t, const B& a, const B& b)
+{
+   typedef typename mpl::front<typename B::unsigned_types>::type ui_type;
+   using default_ops::eval_get_sign;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_qr;
+
+   B u(a), v(b), s0, s1, q, r;
+   s0 = static_cast<ui_type>(1u);
+   s1 = static_cast<ui_type>(0u);
+   if(eval_get_sign(u) < 0)
+      u.negate();
+   if(eval_get_sign(v) < 0)
+      v.negate();
+   while(!eval_is_zero(v))
+   {
+      eval_qr(u, v, q, r);
+      u.swap(v);
+      v.swap(r);
+      eval_multiply(r, q, s1);
+      eval_subtract(s0, r);
+      s0.swap(s1);
+   }
+   if(eval_get_sign(a) < 0)
+      s0.negate();
+   if(eval_is_zero(b))
+      t = static_cast<ui_type>(0u);
+   else
+   {
+      eval_multiply(r, s0, a);
+      eval_subtract(q, u, r);
+      eval_divide(t, q, b);
+   }
+   g.swap(u);
+   s.swap(s0);
+}
+//
+// Inverse of a modulo m > 0 in [0, m), or 0 if there is none.  Only the magnitudes of the cofactors
+// are tracked (their signs alternate) so that this works for unsigned types too:
+//
+template <class B>
+void eval_inverse_mod(B& result, const B& a, const B& m)
+{
+   typedef typename mpl::front<typename B::unsigned_types>::type ui_type;
+   using default_ops::eval_get_sign;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_qr;
+   using default_ops::eval_eq;
+
+   B u1, u3, v1, v3(m), q, t;
+   u1 = static_cast<ui_type>(1u);
+   v1 = static_cast<ui_type>(0u);
+   eval_modulus(u3, a, m);
+   if(eval_get_sign(u3) < 0)
+      eval_add(u3, m);
+   bool negative = false;
+   while(!eval_is_zero(v3))
+   {
+      eval_qr(u3, v3, q, t);
+      u3.swap(v3);
+      v3.swap(t);
+      eval_multiply(t, q, v1);
+      eval_add(t, u1);
+      u1.swap(v1);
+      v1.swap(t);
+      negative = !negative;
+   }
+   if(!eval_eq(u3, static_cast<ui_type>(1u)) || eval_eq(m, static_cast<ui_type>(1u)))
+      result = static_cast<ui_type>(0u);
+   else if(negative)
+      eval_subtract(result, m, u1);
+   else
+      result.swap(u1);
+}
 
 }
 
@@ -212,6 +291,24 @@ inline typename enable_if_c<number_category<typename multiprecision::detail::exp
    return eval_msb(n.backend());
 }
 
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, unsigned>::type 
+   popcount(const number<Backend, ExpressionTemplates>& x)
+{
+   using default_ops::eval_popcount;
+   return eval_popcount(x.backend());
+}
+
+template <class tag, class A1, class A2, class A3, class A4>
+inline typename enable_if_c<number_category<typename multiprecision::detail::expression<tag, A1, A2, A3, A4>::result_type>::value == number_kind_integer, unsigned>::type 
+   popcount(const multiprecision::detail::expression<tag, A1, A2, A3, A4>& x)
+{
+   typedef typename multiprecision::detail::expression<tag, A1, A2, A3, A4>::result_type number_type;
+   number_type n(x);
+   using default_ops::eval_popcount;
+   return eval_popcount(n.backend());
+}
+
 template <class Backend, expression_template_option ExpressionTemplates>
 inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, bool>::type 
    bit_test(const number<Backend, ExpressionTemplates>& x, unsigned index)
@@ -257,6 +354,47 @@ inline typename enable_if_c<number_category<Backend>::value == number_kind_integ
    return x;
 }
 
+//
+// Returns g = gcd(a, b) and sets s and t such that s * a + t * b = g:
+//
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, number<Backend, ExpressionTemplates> >::type 
+   gcdext(const number<Backend, ExpressionTemplates>& a, const number<Backend, ExpressionTemplates>& b,
+   number<Backend, ExpressionTemplates>& s, number<Backend, ExpressionTemplates>& t)
+{
+   BOOST_STATIC_ASSERT_MSG((std::numeric_limits<number<Backend, ExpressionTemplates> >::is_signed), "gcdext requires a signed integer type.");
+   using default_ops::eval_gcdext;
+   number<Backend, ExpressionTemplates> g, x, y;
+   eval_gcdext(g.backend(), x.backend(), y.backend(), a.backend(), b.backend());
+   s.swap(x);
+   t.swap(y);
+   return g;
+}
+//
+// Returns the inverse of a modulo m in [0, m), or 0 if there is none:
+//
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, number<Backend, ExpressionTemplates> >::type 
+   inverse_mod(const number<Backend, ExpressionTemplates>& a, const number<Backend, ExpressionTemplates>& m)
+{
+   using default_ops::eval_inverse_mod;
+   using default_ops::eval_get_sign;
+   if(eval_get_sign(m.backend()) <= 0)
+   {
+      BOOST_THROW_EXCEPTION(std::domain_error("inverse_mod requires a positive modulus."));
+   }
+   number<Backend, ExpressionTemplates> result;
+   eval_inverse_mod(result.backend(), a.backend(), m.backend());
+   return result;
+}
+
+template <class Backend, expression_template_option ExpressionTemplates, class tag, class A1, class A2, class A3, class A4>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, number<Backend, ExpressionTemplates> >::type 
+   inverse_mod(const multiprecision::detail::expression<tag, A1, A2, A3, A4>& a, const number<Backend, ExpressionTemplates>& m)
+{
+   return inverse_mod(number<Backend, ExpressionTemplates>(a), m);
+}
+
 namespace default_ops{
 
 //
@@ -310,7 +448,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, const Backen
          eval_multiply(t, x, y);
          eval_modulus(x, t, c);
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, c);
       eval_right_shift(b, ui_type(1));
    }
@@ -349,7 +487,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, Integer c)
          eval_multiply(t, x, y);
          eval_modulus(x, t, static_cast<i1_type>(c));
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, static_cast<i1_type>(c));
       eval_right_shift(b, ui_type(1));
    }
@@ -379,7 +517,7 @@ typename enable_if<is_unsigned<Integer> >::type eval_powm(Backend& result, const
          eval_multiply(t, x, y);
          eval_modulus(x, t, c);
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, c);
       b >>= 1;
    }
@@ -421,7 +559,7 @@ typename enable_if<is_unsigned<Integer1> >::type eval_powm(Backend& result, cons
          eval_multiply(t, x, y);
          eval_modulus(x, t, static_cast<i1_type>(c));
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, static_cast<i1_type>(c));
       b >>= 1;
    }
@@ -64,6 +64,12 @@ namespace boost{ namespace multiprecision{  namespace detail{
       return (std::max)((std::max)(current_precision_of(expr.left_ref()), current_precision_of(expr.right_ref())), current_precision_of(expr.middle_ref()));
    }
 
+   template <class tag, class Arg1, class Arg2, class Arg3, class Arg4>
+   inline BOOST_CONSTEXPR unsigned current_precision_of(const expression<tag, Arg1, Arg2, Arg3, Arg4>& expr)
+   {
+      return (std::max)((std::max)(current_precision_of(expr.left_ref()), current_precision_of(expr.left_middle_ref())), (std::max)(current_precision_of(expr.right_middle_ref()), current_precision_of(expr.right_ref())));
+   }
+
    template <class R, bool = boost::multiprecision::detail::is_variable_precision<R>::value>
    struct scoped_default_precision
    {
@@ -1694,6 +1694,16 @@ inline typename enable_if_c<is_signed<I>::value && ((sizeof(I) <= sizeof(long)))
 {
    mpz_lcm_ui(result.data(), a.data(), boost::multiprecision::detail::unsigned_abs(b));
 }
+inline void eval_gcdext(gmp_int& g, gmp_int& s, gmp_int& t, const gmp_int& a, const gmp_int& b)
+{
+   mpz_gcdext(g.data(), s.data(), t.data(), a.data(), b.data());
+}
+inline void eval_inverse_mod(gmp_int& result, const gmp_int& a, const gmp_int& m)
+{
+   // The result is undefined when there's no inverse:
+   if(!mpz_invert(result.data(), a.data(), m.data()))
+      mpz_set_ui(result.data(), 0);
+}
 
 inline void eval_integer_sqrt(gmp_int& s, gmp_int& r, const gmp_int& x)
 {
@@ -1728,6 +1738,15 @@ inline unsigned eval_msb(const gmp_int& val)
    return static_cast<unsigned>(mpz_sizeinbase(val.data(), 2) - 1);
 }
 
+inline unsigned eval_popcount(const gmp_int& val)
+{
+   if(eval_get_sign(val) < 0)
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Counting the bits in negative values is not supported - results are undefined."));
+   }
+   return static_cast<unsigned>(mpz_popcount(val.data()));
+}
+
 inline bool eval_bit_test(const gmp_int& val, unsigned index)
 {
    return mpz_tstbit(val.data(), index) ? true : false;
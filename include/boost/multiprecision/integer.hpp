@@ -75,6 +75,20 @@ struct double_integer
       >::type
    >::type type;
 };
+//
+// A fixed precision integer wide enough for the product of two values of Backend,
+// or void if there's no such type:
+//
+template <class Backend>
+struct double_width_number
+{
+   typedef void type;
+};
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked>
+struct double_width_number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, void> >
+{
+   typedef number<cpp_int_backend<MaxBits * 2, MaxBits * 2, SignType, unchecked, void> > type;
+};
 
 }
 
@@ -246,6 +260,202 @@ typename enable_if_c<is_integral<Integer>::value, Integer>::type sqrt(const Inte
    return sqrt(x, r);
 }
 
+//
+// Modular arithmetic with a fixed modulus m > 0, all results are in the range [0, m).
+// Arguments may be any value, but those already in [0, m) are the cheapest to use.
+// The generic version simply uses operator %, the cpp_int version below precomputes
+// the constants for Montgomery or Barrett reduction once, and never divides:
+//
+template <class Backend, class Enable = void>
+class modular_context
+{
+public:
+   typedef number<Backend> value_type;
+
+   explicit modular_context(const value_type& m) : m_modulus(m)
+   {
+      if(m_modulus <= 0)
+         BOOST_THROW_EXCEPTION(std::domain_error("modular_context requires a positive modulus."));
+   }
+   const value_type& modulus()const { return m_modulus; }
+
+   value_type reduce(const value_type& a)
+   {
+      value_type r(a % m_modulus);
+      if(r < 0)
+         r += m_modulus;
+      return r;
+   }
+   value_type addmod(const value_type& a, const value_type& b)
+   {
+      return addmod_reduced(reduce(a), reduce(b));
+   }
+   value_type submod(const value_type& a, const value_type& b)
+   {
+      value_type x(reduce(a)), y(reduce(b));
+      return x >= y ? value_type(x - y) : value_type(m_modulus - (y - x));
+   }
+   value_type mulmod(const value_type& a, const value_type& b)
+   {
+      return mulmod(a, b, mpl::bool_<std::numeric_limits<value_type>::is_bounded>());
+   }
+   value_type powm(const value_type& a, const value_type& e)
+   {
+      return reduce(value_type(boost::multiprecision::powm(reduce(a), e, m_modulus)));
+   }
+   //
+   // Returns 0 if a has no inverse modulo m:
+   //
+   value_type inverse(const value_type& a)
+   {
+      return inverse_mod(reduce(a), m_modulus);
+   }
+
+private:
+   typedef typename detail::double_width_number<Backend>::type double_type;
+   //
+   // x + y mod m for x and y already in [0, m), written so as not to overflow a fixed precision type:
+   //
+   value_type addmod_reduced(const value_type& x, const value_type& y)const
+   {
+      return x >= m_modulus - y ? value_type(x - (m_modulus - y)) : value_type(x + y);
+   }
+   value_type mulmod(const value_type& a, const value_type& b, const mpl::false_&)
+   {
+      return reduce(value_type(a * b));
+   }
+   //
+   // The product may not fit in a fixed precision type, so form it in one twice as wide:
+   //
+   value_type mulmod(const value_type& a, const value_type& b, const mpl::true_&)
+   {
+      return mulmod_reduced(reduce(a), reduce(b), is_void<double_type>());
+   }
+   value_type mulmod_reduced(const value_type& x, const value_type& y, const mpl::false_&)
+   {
+      double_type result;
+      multiply(result, x, y);
+      result %= double_type(m_modulus);
+      return value_type(result);
+   }
+   //
+   // Or failing that by shift and add:
+   //
+   value_type mulmod_reduced(value_type x, value_type y, const mpl::true_&)
+   {
+      value_type r(0);
+      if(x < y)
+         x.swap(y);
+      if(y == 0)
+         return r;
+      for(int i = msb(y); i >= 0; --i)
+      {
+         r = addmod_reduced(r, r);
+         if(bit_test(y, i))
+            r = addmod_reduced(r, x);
+      }
+      return r;
+   }
+
+   value_type m_modulus;
+};
+
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
+class modular_context<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, typename enable_if_c<!backends::is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value>::type>
+{
+public:
+   typedef number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> > value_type;
+
+   explicit modular_context(const value_type& m) : m_modulus(check_modulus(m)), m_reducer(m.backend().limbs(), m.backend().size()), m_x(m_reducer.size()), m_y(m_reducer.size())
+   {
+   }
+   const value_type& modulus()const { return m_modulus; }
+
+   value_type reduce(const value_type& a)
+   {
+      load(&m_x[0], a);
+      return store(&m_x[0]);
+   }
+   value_type addmod(const value_type& a, const value_type& b)
+   {
+      load(&m_x[0], a);
+      load(&m_y[0], b);
+      m_reducer.add(&m_x[0], &m_x[0], &m_y[0]);
+      return store(&m_x[0]);
+   }
+   value_type submod(const value_type& a, const value_type& b)
+   {
+      load(&m_x[0], a);
+      load(&m_y[0], b);
+      m_reducer.subtract(&m_x[0], &m_x[0], &m_y[0]);
+      return store(&m_x[0]);
+   }
+   value_type mulmod(const value_type& a, const value_type& b)
+   {
+      load(&m_x[0], a);
+      load(&m_y[0], b);
+      m_reducer.multiply_normal(&m_x[0], &m_x[0], &m_y[0]);
+      return store(&m_x[0]);
+   }
+   value_type powm(const value_type& a, const value_type& e)
+   {
+      if(e < 0)
+         BOOST_THROW_EXCEPTION(std::runtime_error("powm requires a positive exponent."));
+      load(&m_y[0], a);
+      m_reducer.to_residue(&m_y[0], &m_y[0], m_reducer.size());
+      m_reducer.powm(&m_x[0], &m_y[0], e.backend().limbs(), e.backend().size());
+      m_reducer.from_residue(&m_x[0], &m_x[0]);
+      return store(&m_x[0]);
+   }
+   //
+   // Returns 0 if a has no inverse modulo m:
+   //
+   value_type inverse(const value_type& a)
+   {
+      return inverse_mod(reduce(a), m_modulus);
+   }
+
+private:
+   static const value_type& check_modulus(const value_type& m)
+   {
+      if(m <= 0)
+         BOOST_THROW_EXCEPTION(std::domain_error("modular_context requires a positive modulus."));
+      return m;
+   }
+   //
+   // r[0, n) = a mod m, only values outside [0, m) need a division:
+   //
+   void load(limb_type* r, const value_type& a)
+   {
+      unsigned n = m_reducer.size();
+      if((a.sign() < 0) || (a.backend().size() > n) || (a >= m_modulus))
+      {
+         value_type t(a % m_modulus);
+         if(t < 0)
+            t += m_modulus;
+         load(r, t);
+         return;
+      }
+      std::memcpy(r, a.backend().limbs(), a.backend().size() * sizeof(limb_type));
+      std::fill(r + a.backend().size(), r + n, static_cast<limb_type>(0u));
+   }
+   value_type store(const limb_type* r)const
+   {
+      unsigned n = m_reducer.size();
+      while((n > 1) && !r[n - 1])
+         --n;
+      value_type result;
+      result.backend().resize(n, n);
+      std::memcpy(result.backend().limbs(), r, n * sizeof(limb_type));
+      result.backend().normalize();
+      return result;
+   }
+
+   value_type                m_modulus;
+   backends::modular_reducer m_reducer;
+   std::vector<limb_type>    m_x, m_y;
+};
+
 }} // namespaces
 
 #endif
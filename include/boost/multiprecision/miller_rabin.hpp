@@ -8,6 +8,16 @@
 
 #include <boost/random.hpp>
 #include <boost/multiprecision/integer.hpp>
+#include <vector>
+#include <cmath>
+
+#if !defined(BOOST_NO_CXX11_HDR_MUTEX) && !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE) && !defined(BOOST_NO_CXX11_SMART_PTR) && !defined(BOOST_NO_CXX11_HDR_EXCEPTION)
+#  define BOOST_MP_HAS_CONCURRENT_MILLER_RABIN
+#  include <mutex>
+#  include <condition_variable>
+#  include <memory>
+#  include <exception>
+#endif
 
 namespace boost{
 namespace multiprecision{
@@ -132,34 +142,84 @@ typename disable_if_c<is_convertible<I, unsigned>::value, unsigned>::type
    return val.template convert_to<unsigned>();
 }
 
-} // namespace detail
+//
+// The modular arithmetic used by the primality tests, so that the constants for reducing
+// modulo n are computed once per candidate rather than once per powm:
+//
+template <class I>
+class miller_rabin_context
+{
+public:
+   explicit miller_rabin_context(const I& n) : m_n(n) {}
+   I addmod(const I& a, const I& b) { return a >= m_n - b ? I(a - (m_n - b)) : I(a + b); }
+   I submod(const I& a, const I& b) { return a >= b ? I(a - b) : I(m_n - (b - a)); }
+   I mulmod(const I& a, const I& b)
+   {
+      typename double_integer<I>::type result;
+      multiply(result, a, b);
+      return static_cast<I>(integer_modulus(result, m_n));
+   }
+   I powm(const I& a, const I& e) { return boost::multiprecision::powm(a, e, m_n); }
+private:
+   I m_n;
+};
 
-template <class I, class Engine>
-typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::type 
-   miller_rabin_test(const I& n, unsigned trials, Engine& gen)
+template <class Backend, expression_template_option ExpressionTemplates>
+class miller_rabin_context<number<Backend, ExpressionTemplates> >
+{
+public:
+   typedef number<Backend, ExpressionTemplates> number_type;
+
+   explicit miller_rabin_context(const number_type& n) : m_context(n) {}
+   number_type addmod(const number_type& a, const number_type& b) { return number_type(m_context.addmod(a, b)); }
+   number_type submod(const number_type& a, const number_type& b) { return number_type(m_context.submod(a, b)); }
+   number_type mulmod(const number_type& a, const number_type& b) { return number_type(m_context.mulmod(a, b)); }
+   number_type powm(const number_type& a, const number_type& e) { return number_type(m_context.powm(a, e)); }
+private:
+   modular_context<Backend> m_context;
+};
+//
+// A single Miller-Rabin trial with base x, where n - 1 = q * 2^k with q odd, returns
+// false if x is a witness to n being composite:
+//
+template <class I>
+bool miller_rabin_witness(miller_rabin_context<I>& context, const I& x, const I& q, unsigned k, const I& nm1)
 {
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable:4127)
 #endif
+   I y = context.powm(x, q);
+   unsigned j = 0;
+   while(true)
+   {
+      if(y == nm1)
+         return true;
+      if(y == 1)
+         return j == 0;
+      if(++j == k)
+         return false;
+      y = context.mulmod(y, y);
+   }
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+}
+//
+// Fermat and Miller-Rabin trials for an odd n > 227 which is already known to have no small factors:
+//
+template <class I, class Engine>
+bool miller_rabin_trials(const I& n, unsigned trials, Engine& gen)
+{
    typedef I number_type;
 
-   if (n == 2)
-      return true;  // Trivial special case.
-   if(bit_test(n, 0) == 0)
-      return false;  // n is even
-   if(n <= 227)
-      return detail::is_small_prime(detail::cast_to_unsigned(n));
-
-   if(!detail::check_small_factors(n))
-      return false;
-
+   miller_rabin_context<number_type> context(n);
    number_type nm1 = n - 1;
    //
    // Begin with a single Fermat test - it excludes a lot of candidates:
    //
-   number_type q(228), x, y; // We know n is greater than this, as we've excluded small factors
-   x = powm(q, nm1, n);
+   number_type q(228), x; // We know n is greater than this, as we've excluded small factors
+   x = context.powm(q, nm1);
    if(x != 1u)
       return false;
 
@@ -175,27 +235,230 @@ typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::ty
    for(unsigned i = 0; i < trials; ++i)
    {
       x = dist(gen);
-      y = powm(x, q, n);
-      unsigned j = 0;
-      while(true)
+      if(!miller_rabin_witness(context, x, q, k, nm1))
+         return false; // test failed
+   }
+   return true;  // Yeheh! probably prime.
+}
+//
+// The Jacobi symbol (a/n) for odd n:
+//
+inline int jacobi_symbol(unsigned a, unsigned n)
+{
+   int result = 1;
+   a %= n;
+   while(a)
+   {
+      while((a & 1u) == 0)
       {
-         if(y == nm1)
-            break;
-         if(y == 1)
+         a >>= 1;
+         if((n % 8 == 3) || (n % 8 == 5))
+            result = -result;
+      }
+      std::swap(a, n);
+      if((a % 4 == 3) && (n % 4 == 3))
+         result = -result;
+      a %= n;
+   }
+   return n == 1 ? result : 0;
+}
+//
+// The Jacobi symbol (D/n) for odd D and odd n > 0, by quadratic reciprocity:
+//
+template <class I>
+int jacobi_symbol(int D, const I& n)
+{
+   unsigned a = D < 0 ? static_cast<unsigned>(-D) : static_cast<unsigned>(D);
+   bool n_is_3_mod_4 = bit_test(n, 1);
+   int result = 1;
+   if((D < 0) && n_is_3_mod_4)
+      result = -result;
+   if((a % 4 == 3) && n_is_3_mod_4)
+      result = -result;
+   return result * jacobi_symbol(static_cast<unsigned>(integer_modulus(n, a)), a);
+}
+//
+// x / 2 modulo odd n, for x in [0, n):
+//
+template <class I>
+I half_mod(const I& x, const I& n)
+{
+   I h(x >> 1);
+   if(bit_test(x, 0))
+   {
+      h += n >> 1;
+      ++h;
+   }
+   return h;
+}
+//
+// Strong Lucas probable prime test with the parameters of Selfridge's method A: D is the
+// first of 5, -7, 9, -11, ... with (D/n) = -1, P = 1 and Q = (1 - D) / 4.  n must be odd,
+// greater than 227 and have no small factors:
+//
+template <class I>
+bool strong_lucas_test(miller_rabin_context<I>& context, const I& n)
+{
+   //
+   // There is no suitable D when n is a square:
+   //
+   I root = sqrt(n);
+   if(root * root == n)
+      return false;
+   int D = 5;
+   int j;
+   while((j = jacobi_symbol(D, n)) != -1)
+   {
+      if(j == 0)
+         return false; // n has a common factor with D, and n > |D|.
+      D = D > 0 ? -(D + 2) : -D + 2;
+   }
+   int Q = (1 - D) / 4;
+   I Dm(D < 0 ? I(n - static_cast<unsigned>(-D)) : I(static_cast<unsigned>(D)));
+   I Qm(Q < 0 ? I(n - static_cast<unsigned>(-Q)) : I(static_cast<unsigned>(Q)));
+   //
+   // n + 1 = d * 2^s with d odd, compute U_d, V_d and Q^d by the usual doubling formulae:
+   //
+   I d(n);
+   ++d;
+   unsigned s = lsb(d);
+   d >>= s;
+   I U(1), V(1), Qk(Qm), t;
+   for(int i = static_cast<int>(msb(d)) - 1; i >= 0; --i)
+   {
+      // U_2k = U_k V_k, V_2k = V_k^2 - 2Q^k:
+      U = context.mulmod(U, V);
+      V = context.submod(context.mulmod(V, V), context.addmod(Qk, Qk));
+      Qk = context.mulmod(Qk, Qk);
+      if(bit_test(d, i))
+      {
+         // U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2:
+         t = context.addmod(U, V);
+         V = half_mod(context.addmod(context.mulmod(Dm, U), V), n);
+         U = half_mod(t, n);
+         Qk = context.mulmod(Qk, Qm);
+      }
+   }
+   if((U == 0) || (V == 0))
+      return true;
+   for(unsigned r = 1; r < s; ++r)
+   {
+      V = context.submod(context.mulmod(V, V), context.addmod(Qk, Qk));
+      if(V == 0)
+         return true;
+      Qk = context.mulmod(Qk, Qk);
+   }
+   return false;
+}
+
+//
+// Fills primes with the first count odd primes by a sieve of Eratosthenes, the n'th prime
+// is less than n(ln(n) + ln(ln(n))) for n >= 6 which gives the size of the sieve:
+//
+inline void odd_primes(std::vector<boost::uint32_t>& primes, unsigned count)
+{
+   primes.clear();
+   double n = (std::max)(count + 1.0, 6.0);
+   boost::uint32_t limit = static_cast<boost::uint32_t>(n * (std::log(n) + std::log(std::log(n)))) + 1;
+   // composite[i] is the state of 2i + 1:
+   std::vector<unsigned char> composite(limit / 2 + 1);
+   for(boost::uint32_t i = 1; (i < composite.size()) && (primes.size() < count); ++i)
+   {
+      if(composite[i])
+         continue;
+      boost::uint32_t p = 2 * i + 1;
+      primes.push_back(p);
+      for(boost::uint64_t j = static_cast<boost::uint64_t>(p) * p / 2; j < composite.size(); j += p)
+         composite[static_cast<std::size_t>(j)] = 1;
+   }
+}
+
+#ifdef BOOST_MP_HAS_CONCURRENT_MILLER_RABIN
+//
+// State shared between the caller of the concurrent Miller-Rabin test and its tasks, it's
+// kept alive by the tasks themselves so the caller may return as soon as a trial fails:
+//
+template <class I>
+struct concurrent_trials_state
+{
+   concurrent_trials_state(const I& val, unsigned trials) : n(val), nm1(val - 1), q(nm1), bases(trials), pending(trials), failed(false)
+   {
+      k = lsb(q);
+      q >>= k;
+   }
+   I n, nm1, q;
+   unsigned k;
+   std::vector<I> bases;
+   std::mutex mutex;
+   std::condition_variable done;
+   unsigned pending;
+   bool failed;
+   std::exception_ptr error;
+};
+
+template <class I>
+struct miller_rabin_task
+{
+   miller_rabin_task(const std::shared_ptr<concurrent_trials_state<I> >& s, unsigned i) : state(s), index(i) {}
+
+   void operator()()const
+   {
+      bool cancelled;
+      {
+         std::lock_guard<std::mutex> lock(state->mutex);
+         cancelled = state->failed;
+      }
+      bool passed = true;
+      std::exception_ptr error;
+      if(!cancelled)
+      {
+#ifndef BOOST_NO_EXCEPTIONS
+         try
+         {
+#endif
+            // Each task needs its own context, they hold working storage:
+            miller_rabin_context<I> context(state->n);
+            passed = miller_rabin_witness(context, state->bases[index], state->q, state->k, state->nm1);
+#ifndef BOOST_NO_EXCEPTIONS
+         }
+         catch(...)
          {
-            if(j == 0)
-               break;
-            return false; // test failed
+            error = std::current_exception();
+            passed = false;
          }
-         if(++j == k)
-            return false; // failed
-         y = powm(y, 2, n);
+#endif
       }
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if(error && !state->error)
+         state->error = error;
+      if(!passed)
+         state->failed = true;
+      if((--state->pending == 0) || !passed)
+         state->done.notify_all();
    }
-   return true;  // Yeheh! probably prime.
-#ifdef BOOST_MSVC
-#pragma warning(pop)
+
+   std::shared_ptr<concurrent_trials_state<I> > state;
+   unsigned index;
+};
 #endif
+
+} // namespace detail
+
+template <class I, class Engine>
+typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::type 
+   miller_rabin_test(const I& n, unsigned trials, Engine& gen)
+{
+   if (n == 2)
+      return true;  // Trivial special case.
+   if(bit_test(n, 0) == 0)
+      return false;  // n is even
+   if(n <= 227)
+      return detail::is_small_prime(detail::cast_to_unsigned(n));
+
+   if(!detail::check_small_factors(n))
+      return false;
+
+   return detail::miller_rabin_trials(n, trials, gen);
 }
 
 template <class I>
@@ -206,6 +469,52 @@ typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::ty
    return miller_rabin_test(x, trials, gen);
 }
 
+#ifdef BOOST_MP_HAS_CONCURRENT_MILLER_RABIN
+//
+// As above, but the trials are submitted as separate tasks to exec, which is called as exec(f)
+// with a nullary function object f and may run it on any thread.  The bases are drawn from gen
+// before any task is submitted, so the result is the same as for the serial version.  Returns
+// false as soon as any trial fails, tasks which haven't started by then do nothing:
+//
+template <class I, class Engine, class Executor>
+typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::type 
+   miller_rabin_test(const I& n, unsigned trials, Engine& gen, Executor exec)
+{
+   if (n == 2)
+      return true;  // Trivial special case.
+   if(bit_test(n, 0) == 0)
+      return false;  // n is even
+   if(n <= 227)
+      return detail::is_small_prime(detail::cast_to_unsigned(n));
+
+   if(!detail::check_small_factors(n))
+      return false;
+   //
+   // The Fermat test is done here, it excludes most composites before any task is created:
+   //
+   if(!detail::miller_rabin_trials(n, 0, gen))
+      return false;
+   if(trials == 0)
+      return true;
+
+   std::shared_ptr<detail::concurrent_trials_state<I> > state(new detail::concurrent_trials_state<I>(n, trials));
+   boost::random::uniform_int_distribution<I> dist(2, n - 2);
+   for(unsigned i = 0; i < trials; ++i)
+      state->bases[i] = dist(gen);
+   for(unsigned i = 0; i < trials; ++i)
+      exec(detail::miller_rabin_task<I>(state, i));
+
+   std::unique_lock<std::mutex> lock(state->mutex);
+   while(!state->failed && state->pending)
+      state->done.wait(lock);
+#ifndef BOOST_NO_EXCEPTIONS
+   if(state->error)
+      std::rethrow_exception(state->error);
+#endif
+   return !state->failed;
+}
+#endif
+
 template <class tag, class Arg1, class Arg2, class Arg3, class Arg4, class Engine>
 bool miller_rabin_test(const detail::expression<tag, Arg1, Arg2, Arg3, Arg4> & n, unsigned trials, Engine& gen)
 {
@@ -220,6 +529,163 @@ bool miller_rabin_test(const detail::expression<tag, Arg1, Arg2, Arg3, Arg4> & n
    return miller_rabin_test(number_type(n), trials);
 }
 
+//
+// Baillie-PSW test: a strong probable prime test to base 2 followed by a strong Lucas test.
+// There are no known composites which pass both, and none below 2^64:
+//
+template <class I>
+typename enable_if_c<number_category<I>::value == number_kind_integer, bool>::type
+   baillie_psw_test(const I& n)
+{
+   if (n == 2)
+      return true;  // Trivial special case.
+   if(bit_test(n, 0) == 0)
+      return false;  // n is even
+   if(n <= 227)
+      return detail::is_small_prime(detail::cast_to_unsigned(n));
+
+   if(!detail::check_small_factors(n))
+      return false;
+
+   detail::miller_rabin_context<I> context(n);
+   I nm1(n - 1), q(nm1);
+   unsigned k = lsb(q);
+   q >>= k;
+   if(!detail::miller_rabin_witness(context, I(2), q, k, nm1))
+      return false;
+   return detail::strong_lucas_test(context, n);
+}
+
+template <class tag, class Arg1, class Arg2, class Arg3, class Arg4>
+bool baillie_psw_test(const detail::expression<tag, Arg1, Arg2, Arg3, Arg4> & n)
+{
+   typedef typename detail::expression<tag, Arg1, Arg2, Arg3, Arg4>::result_type number_type;
+   return baillie_psw_test(number_type(n));
+}
+
+//
+// Produces, in increasing order, the odd values >= start which have no factor among the first
+// sieve_primes odd primes (other than the prime itself).  Candidates are sieved a window of
+// window odd values at a time, and the residues of the window base modulo each prime are
+// updated incrementally from one window to the next, so that only the first window needs
+// any multiprecision arithmetic:
+//
+template <class I>
+class prime_candidate_stream
+{
+public:
+   explicit prime_candidate_stream(const I& start, unsigned window = 4096, unsigned sieve_primes = 2000)
+      : m_window(window ? window : 1), m_pos(0), m_sieve(m_window)
+   {
+      m_base = start <= 3 ? I(3) : I(start | 1);
+      detail::odd_primes(m_primes, sieve_primes);
+      m_residues.resize(m_primes.size());
+      //
+      // Take the residues modulo products of as many primes as fit in 32 bits, so that there
+      // are fewer divisions of the full value:
+      //
+      for(unsigned i = 0; i < m_residues.size();)
+      {
+         unsigned j = i;
+         boost::uint64_t product = 1;
+         while((j < m_primes.size()) && (product * m_primes[j] <= 0xFFFFFFFFu))
+            product *= m_primes[j++];
+         boost::uint32_t r = integer_modulus(m_base, static_cast<boost::uint32_t>(product));
+         for(; i < j; ++i)
+            m_residues[i] = r % m_primes[i];
+      }
+      fill_sieve();
+   }
+   //
+   // Returns the next candidate and advances past it:
+   //
+   I next()
+   {
+      while(true)
+      {
+         while((m_pos < m_window) && m_sieve[m_pos])
+            ++m_pos;
+         if(m_pos < m_window)
+            break;
+         next_window();
+      }
+      I result(m_base);
+      result += 2u * m_pos++;
+      return result;
+   }
+
+private:
+   void next_window()
+   {
+      m_base += 2u * m_window;
+      for(unsigned i = 0; i < m_residues.size(); ++i)
+      {
+         boost::uint32_t p = m_primes[i];
+         m_residues[i] = static_cast<boost::uint32_t>((m_residues[i] + (static_cast<boost::uint64_t>(2u) * m_window) % p) % p);
+      }
+      m_pos = 0;
+      fill_sieve();
+   }
+   void fill_sieve()
+   {
+      std::fill(m_sieve.begin(), m_sieve.end(), static_cast<unsigned char>(0u));
+      //
+      // While the window may still contain the sieving primes themselves we need to know where the window starts:
+      //
+      boost::uint32_t max_p = m_primes.empty() ? 0 : m_primes.back();
+      bool small_base = m_base <= max_p;
+      boost::uint32_t base = small_base ? detail::cast_to_unsigned(m_base) : 0;
+      for(unsigned i = 0; i < m_residues.size(); ++i)
+      {
+         //
+         // base + 2j is divisible by p when j = -base / 2 mod p:
+         //
+         boost::uint32_t p = m_primes[i];
+         boost::uint64_t j = (static_cast<boost::uint64_t>((p - m_residues[i]) % p) * ((p + 1) / 2)) % p;
+         if(small_base && (base + 2 * j == p))
+            j += p;
+         for(; j < m_window; j += p)
+            m_sieve[static_cast<std::size_t>(j)] = 1;
+      }
+   }
+
+   I m_base;
+   unsigned m_window, m_pos;
+   std::vector<unsigned char> m_sieve;
+   std::vector<boost::uint32_t> m_primes, m_residues;
+};
+
+//
+// Returns the smallest probable prime greater than n:
+//
+template <class I, class Engine>
+typename enable_if_c<number_category<I>::value == number_kind_integer, I>::type
+   next_probable_prime(const I& n, unsigned trials, Engine& gen)
+{
+   if(n < 2)
+      return I(2);
+   prime_candidate_stream<I> candidates(I(n + 1));
+   while(true)
+   {
+      I c = candidates.next();
+      if(c <= 227)
+      {
+         if(detail::is_small_prime(detail::cast_to_unsigned(c)))
+            return c;
+      }
+      else if(detail::miller_rabin_trials(c, trials, gen))
+         return c;
+   }
+}
+
+template <class I>
+typename enable_if_c<number_category<I>::value == number_kind_integer, I>::type
+   next_probable_prime(const I& n, unsigned trials)
+{
+   static mt19937 gen;
+   return next_probable_prime(n, trials, gen);
+}
+
 }} // namespaces
 
 #endif
@@ -589,6 +589,21 @@ inline void eval_lcm(tommath_int& result, const tommath_int& a, const tommath_in
 {
    detail::check_tommath_result(mp_lcm(const_cast< ::mp_int*>(&a.data()), const_cast< ::mp_int*>(&b.data()), const_cast< ::mp_int*>(&result.data())));
 }
+inline void eval_gcdext(tommath_int& g, tommath_int& s, tommath_int& t, const tommath_int& a, const tommath_int& b)
+{
+   detail::check_tommath_result(mp_exteuclid(const_cast< ::mp_int*>(&a.data()), const_cast< ::mp_int*>(&b.data()), &s.data(), &t.data(), &g.data()));
+}
+inline void eval_inverse_mod(tommath_int& result, const tommath_int& a, const tommath_int& m)
+{
+   tommath_int x;
+   detail::check_tommath_result(mp_mod(const_cast< ::mp_int*>(&a.data()), const_cast< ::mp_int*>(&m.data()), &x.data()));
+   // MP_VAL means there's no inverse:
+   int r = mp_invmod(&x.data(), const_cast< ::mp_int*>(&m.data()), &result.data());
+   if(r == MP_VAL)
+      mp_zero(&result.data());
+   else
+      detail::check_tommath_result(r);
+}
 inline void eval_powm(tommath_int& result, const tommath_int& base, const tommath_int& p, const tommath_int& m)
 {
    if(eval_get_sign(p) < 0)
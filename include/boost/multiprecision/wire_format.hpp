@@ -0,0 +1,585 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+//
+// A compact binary format for bulk storage of cpp_int and cpp_bin_float values.
+//
+#ifndef BOOST_MP_WIRE_FORMAT_HPP
+#define BOOST_MP_WIRE_FORMAT_HPP
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/type_traits/alignment_of.hpp>
+#include <ostream>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+
+//
+// The format, all fields little endian:
+//
+// A 16 byte stream header: the characters "BMPW", a 16-bit version number (currently 1), a 16-bit kind
+// (1 for integers, 2 for binary floating point), the 32-bit precision in bits of the type written (0 for
+// arbitrary precision integers and variable precision floating point), and 32 reserved bits which are zero.
+//
+// Then one record per value.  Integers are a 64-bit word holding (N << 1) | sign followed by the magnitude
+// as N 64-bit words, least significant first.  Floating point values are a 64-bit word holding
+// (N << 3) | (class << 1) | sign, a signed 64-bit exponent E, and N words of mantissa M as above, where
+// the value is M * 2^E for class 0, and class 1 is zero, 2 infinity and 3 NaN.  When the precision in
+// the header is 0, each floating point record has a 64-bit word holding the precision in bits of that
+// value between the exponent and the mantissa.
+//
+// Every field is a multiple of 8 bytes, so when the data starts 8 byte aligned - as a memory mapped file
+// does - the magnitude of each integer may be used in place by a cpp_int_view.
+//
+namespace boost{ namespace multiprecision{
+
+namespace detail{
+
+enum
+{
+   wire_version = 1,
+   wire_kind_integer = 1,
+   wire_kind_float = 2,
+   wire_header_size = 16
+};
+
+//
+// Buffers output and writes it to a stream in large blocks:
+//
+class wire_sink
+{
+public:
+   wire_sink(std::ostream& os, std::size_t buffer_bytes)
+      : m_os(os), m_capacity(buffer_bytes < 64 ? 64 : buffer_bytes)
+   {
+      m_buffer.reserve(m_capacity);
+   }
+   void put(boost::uint64_t v, unsigned bytes = 8)
+   {
+      if(m_buffer.size() + bytes > m_capacity)
+         flush();
+      for(unsigned i = 0; i < bytes; ++i)
+         m_buffer.push_back(static_cast<unsigned char>(v >> (i * CHAR_BIT)));
+   }
+   //
+   // Writes n limbs padded with zeros to a whole number of 64-bit words, on little endian machines large
+   // blocks of limbs go straight from the value to the stream:
+   //
+   void put_limbs(const limb_type* p, std::size_t n)
+   {
+      std::size_t bytes = n * sizeof(limb_type);
+      std::size_t padding = (8 - bytes % 8) % 8;
+#if BOOST_ENDIAN_LITTLE_BYTE
+      if(bytes > m_capacity / 2)
+      {
+         flush();
+         m_os.write(reinterpret_cast<const char*>(p), static_cast<std::streamsize>(bytes));
+      }
+      else
+      {
+         if(m_buffer.size() + bytes > m_capacity)
+            flush();
+         const unsigned char* pc = reinterpret_cast<const unsigned char*>(p);
+         m_buffer.insert(m_buffer.end(), pc, pc + bytes);
+      }
+#else
+      for(std::size_t i = 0; i < n; ++i)
+         put(p[i], sizeof(limb_type));
+#endif
+      if(padding)
+         put(0, static_cast<unsigned>(padding));
+   }
+   void flush()
+   {
+      if(!m_buffer.empty())
+         m_os.write(reinterpret_cast<const char*>(&m_buffer[0]), static_cast<std::streamsize>(m_buffer.size()));
+      m_buffer.clear();
+   }
+
+private:
+   wire_sink(const wire_sink&);
+   wire_sink& operator=(const wire_sink&);
+
+   std::ostream&              m_os;
+   std::vector<unsigned char> m_buffer;
+   std::size_t                m_capacity;
+};
+
+//
+// Reads fields from a block of memory:
+//
+class wire_source
+{
+public:
+   wire_source(const void* data, std::size_t bytes)
+      : m_pos(static_cast<const unsigned char*>(data)), m_end(static_cast<const unsigned char*>(data) + bytes) {}
+
+   bool at_end()const { return m_pos == m_end; }
+   boost::uint64_t get(unsigned bytes = 8)
+   {
+      check(bytes);
+      boost::uint64_t result = 0;
+      for(unsigned i = 0; i < bytes; ++i)
+         result |= static_cast<boost::uint64_t>(m_pos[i]) << (i * CHAR_BIT);
+      m_pos += bytes;
+      return result;
+   }
+   //
+   // Returns a view of the next n words as a magnitude, which refers to the data itself when the byte
+   // order and alignment allow, and to a copy which is valid until the next call otherwise:
+   //
+   cpp_int_view get_limbs(boost::uint64_t n, bool negative)
+   {
+      if(n > static_cast<boost::uint64_t>(m_end - m_pos) / 8)
+         truncated();
+      std::size_t limb_count = static_cast<std::size_t>(n) * 8 / sizeof(limb_type);
+      const limb_type* p;
+#if BOOST_ENDIAN_LITTLE_BYTE
+      if(reinterpret_cast<std::size_t>(m_pos) % boost::alignment_of<limb_type>::value == 0)
+         p = reinterpret_cast<const limb_type*>(m_pos);
+      else
+      {
+         m_scratch.resize(limb_count + 1);
+         std::memcpy(&m_scratch[0], m_pos, limb_count * sizeof(limb_type));
+         p = &m_scratch[0];
+      }
+#else
+      m_scratch.resize(limb_count + 1);
+      for(std::size_t i = 0; i < limb_count; ++i)
+      {
+         limb_type l = 0;
+         for(unsigned j = 0; j < sizeof(limb_type); ++j)
+            l |= static_cast<limb_type>(m_pos[i * sizeof(limb_type) + j]) << (j * CHAR_BIT);
+         m_scratch[i] = l;
+      }
+      p = &m_scratch[0];
+#endif
+      m_pos += limb_count * sizeof(limb_type);
+      return cpp_int_view(p, limb_count, negative);
+   }
+
+private:
+   void check(std::size_t bytes)const
+   {
+      if(static_cast<std::size_t>(m_end - m_pos) < bytes)
+         truncated();
+   }
+   static void truncated()
+   {
+      BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected end of data in a multiprecision wire format record."));
+   }
+
+   const unsigned char*   m_pos;
+   const unsigned char*   m_end;
+   std::vector<limb_type> m_scratch;
+};
+
+//
+// The magnitude of an integer as a pointer to limbs plus a count, zero has no limbs.  Trivial types are
+// split into limbs in the caller's scratch space:
+//
+template <class Int>
+inline std::size_t wire_magnitude(const Int& val, const limb_type*& p, limb_type*, const mpl::false_&)
+{
+   p = val.limbs();
+   return (val.size() == 1) && !*p ? 0 : val.size();
+}
+template <class T>
+inline T wire_next_limb(T v, const mpl::true_&)
+{
+   return v >> (sizeof(limb_type) * CHAR_BIT);
+}
+template <class T>
+inline T wire_next_limb(T, const mpl::false_&)
+{
+   return 0;
+}
+template <class Int>
+inline std::size_t wire_magnitude(const Int& val, const limb_type*& p, limb_type* scratch, const mpl::true_&)
+{
+   typedef typename Int::local_limb_type local_limb_type;
+   local_limb_type v = *val.limbs();
+   std::size_t n = 0;
+   while(v)
+   {
+      scratch[n++] = static_cast<limb_type>(v);
+      v = wire_next_limb(v, mpl::bool_<(sizeof(local_limb_type) > sizeof(limb_type))>());
+   }
+   p = scratch;
+   return n;
+}
+
+template <class Backend>
+struct wire_traits;
+
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
+struct wire_traits<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >
+{
+   typedef cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> backend_type;
+   BOOST_STATIC_CONSTANT(unsigned, kind = wire_kind_integer);
+   BOOST_STATIC_CONSTANT(unsigned, precision = MaxBits);
+
+   static void write(wire_sink& sink, const backend_type& val)
+   {
+      limb_type scratch[4];
+      const limb_type* p;
+      std::size_t n = wire_magnitude(val, p, scratch, typename backend_type::trivial_tag());
+      std::size_t words = (n * sizeof(limb_type) + 7) / 8;
+      sink.put((static_cast<boost::uint64_t>(words) << 1) | (val.sign() ? 1u : 0u));
+      sink.put_limbs(p, n);
+   }
+   static void read(wire_source& source, backend_type& val, unsigned /*precision*/)
+   {
+      boost::uint64_t h = source.get();
+      detail::assign_view(val, source.get_limbs(h >> 1, h & 1u), typename backend_type::trivial_tag());
+   }
+};
+
+template <unsigned Digits, backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+struct wire_traits<cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> >
+{
+   typedef cpp_bin_float<Digits, DigitBase, Allocator, Exponent, MinE, MaxE> backend_type;
+   typedef typename backend_type::rep_type                                 rep_type;
+   BOOST_STATIC_CONSTANT(unsigned, kind = wire_kind_float);
+   BOOST_STATIC_CONSTANT(unsigned, precision = backend_type::bit_count);
+
+   static void write(wire_sink& sink, const backend_type& val)
+   {
+      boost::uint64_t cls = 0;
+      switch(val.exponent())
+      {
+      case backend_type::exponent_zero:
+         cls = 1;
+         break;
+      case backend_type::exponent_infinity:
+         cls = 2;
+         break;
+      case backend_type::exponent_nan:
+         cls = 3;
+         break;
+      }
+      boost::uint64_t sign = val.sign() ? 1u : 0u;
+      if(cls)
+      {
+         sink.put((cls << 1) | sign);
+         sink.put(0);
+         return;
+      }
+      limb_type scratch[4];
+      const limb_type* p;
+      std::size_t n = wire_magnitude(val.bits(), p, scratch, typename rep_type::trivial_tag());
+      boost::int64_t e = static_cast<boost::int64_t>(val.exponent()) - static_cast<boost::int64_t>(backend_type::bit_count - 1);
+      //
+      // Low order zero limbs are dropped from the mantissa, so values with short mantissas stay short:
+      //
+      while(n && !*p)
+      {
+         ++p;
+         --n;
+         e += sizeof(limb_type) * CHAR_BIT;
+      }
+      std::size_t words = (n * sizeof(limb_type) + 7) / 8;
+      sink.put((static_cast<boost::uint64_t>(words) << 3) | sign);
+      sink.put(static_cast<boost::uint64_t>(e));
+      sink.put_limbs(p, n);
+   }
+   //
+   // precision is that of the data, whose records carry a precision word when it is 0:
+   //
+   static void read(wire_source& source, backend_type& val, unsigned precision)
+   {
+      boost::uint64_t h = source.get();
+      boost::int64_t e = static_cast<boost::int64_t>(source.get());
+      if(!precision)
+         source.get();
+      bool sign = h & 1u;
+      switch((h >> 1) & 3u)
+      {
+      case 1:
+         val = limb_type(0);
+         val.sign() = sign;
+         return;
+      case 2:
+         val = std::numeric_limits<number<backend_type> >::infinity().backend();
+         val.sign() = sign;
+         return;
+      case 3:
+         val = std::numeric_limits<number<backend_type> >::quiet_NaN().backend();
+         return;
+      }
+      cpp_int_view m = source.get_limbs(h >> 3, false);
+      if(m.is_zero())
+         BOOST_THROW_EXCEPTION(std::runtime_error("Zero mantissa in a multiprecision wire format record."));
+      boost::int64_t bits = static_cast<boost::int64_t>(m.size() - 1) * sizeof(limb_type) * CHAR_BIT + boost::multiprecision::detail::find_msb(m.limbs()[m.size() - 1]) + 1;
+      boost::int64_t exponent = e + bits - 1;
+      if((bits <= static_cast<boost::int64_t>(backend_type::bit_count)) && (exponent >= backend_type::min_exponent) && (exponent <= backend_type::max_exponent))
+      {
+         //
+         // The mantissa fits, and the value is in range, so this is exact:
+         //
+         detail::assign_view(val.bits(), m, typename rep_type::trivial_tag());
+         if(bits < static_cast<boost::int64_t>(backend_type::bit_count))
+            eval_left_shift(val.bits(), static_cast<double_limb_type>(backend_type::bit_count - bits));
+         val.exponent() = static_cast<Exponent>(exponent);
+         val.sign() = sign;
+      }
+      else
+      {
+         //
+         // Written at a higher precision or outside our exponent range.  Reduce the mantissa to two bits more
+         // than we hold, folding anything discarded into the last bit, so that rounding it to our precision is
+         // correct and can't overflow, then scale:
+         //
+         cpp_int mantissa;
+         import_bits(mantissa, m);
+         boost::int64_t excess = bits - static_cast<boost::int64_t>(backend_type::bit_count) - 2;
+         if(excess > 0)
+         {
+            bool sticky = lsb(mantissa) < excess;
+            mantissa >>= static_cast<unsigned>(excess);
+            if(sticky)
+               mantissa |= 1u;
+            e += excess;
+         }
+         backend_type t;
+         t.exponent() = static_cast<Exponent>(backend_type::bit_count - 1);
+         t.sign() = false;
+         copy_and_round(t, mantissa.backend());
+         boost::int64_t limit = backend_type::max_exponent_limit;
+         e = (std::max)(-limit, (std::min)(limit, e));
+         eval_ldexp(val, t, e);
+         val.sign() = sign;
+      }
+   }
+};
+
+//
+// Variable precision cpp_bin_float: the header precision is 0 and each record carries the precision of
+// its value, which is restored on reading, so values round trip exactly whatever their precisions.  Data
+// written by a fixed precision type is read at that precision:
+//
+template <backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinE, Exponent MaxE>
+struct wire_traits<cpp_bin_float<0u, DigitBase, Allocator, Exponent, MinE, MaxE> >
+{
+   typedef cpp_bin_float<0u, DigitBase, Allocator, Exponent, MinE, MaxE> backend_type;
+   typedef typename backend_type::rep_type                              rep_type;
+   BOOST_STATIC_CONSTANT(unsigned, kind = wire_kind_float);
+   BOOST_STATIC_CONSTANT(unsigned, precision = 0);
+
+   static void write(wire_sink& sink, const backend_type& val)
+   {
+      boost::uint64_t cls = 0;
+      switch(val.exponent())
+      {
+      case backend_type::exponent_zero:
+         cls = 1;
+         break;
+      case backend_type::exponent_infinity:
+         cls = 2;
+         break;
+      case backend_type::exponent_nan:
+         cls = 3;
+         break;
+      }
+      boost::uint64_t sign = val.sign() ? 1u : 0u;
+      if(cls)
+      {
+         sink.put((cls << 1) | sign);
+         sink.put(0);
+         sink.put(val.precision_bits());
+         return;
+      }
+      limb_type scratch[4];
+      const limb_type* p;
+      std::size_t n = wire_magnitude(val.bits(), p, scratch, typename rep_type::trivial_tag());
+      boost::int64_t e = static_cast<boost::int64_t>(val.exponent()) - static_cast<boost::int64_t>(val.precision_bits() - 1);
+      while(n && !*p)
+      {
+         ++p;
+         --n;
+         e += sizeof(limb_type) * CHAR_BIT;
+      }
+      std::size_t words = (n * sizeof(limb_type) + 7) / 8;
+      sink.put((static_cast<boost::uint64_t>(words) << 3) | sign);
+      sink.put(static_cast<boost::uint64_t>(e));
+      sink.put(val.precision_bits());
+      sink.put_limbs(p, n);
+   }
+   static void read(wire_source& source, backend_type& val, unsigned precision)
+   {
+      boost::uint64_t h = source.get();
+      boost::int64_t e = static_cast<boost::int64_t>(source.get());
+      boost::uint64_t bits = precision ? precision : source.get();
+      if(!bits || (bits > (std::numeric_limits<unsigned>::max)()))
+         BOOST_THROW_EXCEPTION(std::runtime_error("Invalid precision in a multiprecision wire format record."));
+      bool sign = h & 1u;
+      //
+      // Set the precision while the value is zero, so that nothing is rounded:
+      //
+      set_special_value(val, backend_type::exponent_zero, sign);
+      val.precision_bits(static_cast<unsigned>(bits));
+      switch((h >> 1) & 3u)
+      {
+      case 1:
+         return;
+      case 2:
+         val.exponent() = backend_type::exponent_infinity;
+         return;
+      case 3:
+         val.exponent() = backend_type::exponent_nan;
+         val.sign() = false;
+         return;
+      }
+      cpp_int_view m = source.get_limbs(h >> 3, false);
+      if(m.is_zero())
+         BOOST_THROW_EXCEPTION(std::runtime_error("Zero mantissa in a multiprecision wire format record."));
+      rep_type mantissa;
+      detail::assign_view(mantissa, m, typename rep_type::trivial_tag());
+      //
+      // Exact unless the data was written with a wider exponent range, in which case the value overflows
+      // or underflows just as arithmetic would:
+      //
+      copy_and_round_scaled(val, mantissa, e);
+   }
+};
+
+} // namespace detail
+
+//
+// Writes values of type Number - a cpp_int or cpp_bin_float type - to a stream, buffering the output:
+//
+template <class Number>
+class wire_writer
+{
+public:
+   typedef typename Number::backend_type                  backend_type;
+   typedef detail::wire_traits<backend_type>              traits_type;
+
+   explicit wire_writer(std::ostream& os, std::size_t buffer_bytes = 65536)
+      : m_sink(os, buffer_bytes)
+   {
+      m_sink.put('B', 1);
+      m_sink.put('M', 1);
+      m_sink.put('P', 1);
+      m_sink.put('W', 1);
+      m_sink.put(detail::wire_version, 2);
+      m_sink.put(traits_type::kind, 2);
+      m_sink.put(traits_type::precision, 4);
+      m_sink.put(0, 4);
+   }
+   ~wire_writer()
+   {
+#ifndef BOOST_NO_EXCEPTIONS
+      try{
+#endif
+         m_sink.flush();
+#ifndef BOOST_NO_EXCEPTIONS
+      }
+      catch(...) {}
+#endif
+   }
+   wire_writer& write(const Number& val)
+   {
+      traits_type::write(m_sink, val.backend());
+      return *this;
+   }
+   template <class Iterator>
+   wire_writer& write(Iterator first, Iterator last)
+   {
+      for(; first != last; ++first)
+         traits_type::write(m_sink, first->backend());
+      return *this;
+   }
+   //
+   // Sends anything buffered to the stream, also done by the destructor:
+   //
+   void flush()
+   {
+      m_sink.flush();
+   }
+
+private:
+   wire_writer(const wire_writer&);
+   wire_writer& operator=(const wire_writer&);
+
+   detail::wire_sink m_sink;
+};
+
+//
+// Reads values of type Number from a block of memory - for example a memory mapped file - holding data
+// written by wire_writer for a type of the same kind.  The data may have been written at a different precision,
+// values are then converted as if by assignment:
+//
+template <class Number>
+class wire_reader
+{
+public:
+   typedef typename Number::backend_type                  backend_type;
+   typedef detail::wire_traits<backend_type>              traits_type;
+
+   wire_reader(const void* data, std::size_t bytes)
+      : m_source(data, bytes)
+   {
+      const unsigned char* p = static_cast<const unsigned char*>(data);
+      if((bytes < detail::wire_header_size) || (p[0] != 'B') || (p[1] != 'M') || (p[2] != 'P') || (p[3] != 'W'))
+         BOOST_THROW_EXCEPTION(std::runtime_error("Data is not in multiprecision wire format."));
+      m_source.get(4);
+      unsigned version = static_cast<unsigned>(m_source.get(2));
+      if(version > detail::wire_version)
+         BOOST_THROW_EXCEPTION(std::runtime_error("Unsupported multiprecision wire format version."));
+      if(m_source.get(2) != traits_type::kind)
+         BOOST_THROW_EXCEPTION(std::runtime_error("Multiprecision wire format data holds a different kind of number."));
+      m_precision = static_cast<unsigned>(m_source.get(4));
+      m_source.get(4);
+   }
+   //
+   // The precision in bits of the type which was written, 0 for arbitrary precision integers and
+   // variable precision floating point:
+   //
+   unsigned precision()const { return m_precision; }
+   bool at_end()const { return m_source.at_end(); }
+   //
+   // Reads the next value, returns false if there are none left:
+   //
+   bool read(Number& val)
+   {
+      if(m_source.at_end())
+         return false;
+      traits_type::read(m_source, val.backend(), m_precision);
+      return true;
+   }
+   //
+   // Reads up to count values into the array at first, returns the number read:
+   //
+   std::size_t read(Number* first, std::size_t count)
+   {
+      std::size_t i = 0;
+      for(; (i < count) && !m_source.at_end(); ++i)
+         traits_type::read(m_source, first[i].backend(), m_precision);
+      return i;
+   }
+   //
+   // For integers, a view of the next value which refers directly to the data when it is suitably aligned
+   // and in native byte order, and otherwise to a copy which is valid until the next read:
+   //
+   bool read(cpp_int_view& val)
+   {
+      BOOST_STATIC_ASSERT_MSG(traits_type::kind == detail::wire_kind_integer, "Only integers may be read as a cpp_int_view.");
+      if(m_source.at_end())
+         return false;
+      boost::uint64_t h = m_source.get();
+      val = m_source.get_limbs(h >> 1, h & 1u);
+      return true;
+   }
+
+private:
+   detail::wire_source m_source;
+   unsigned            m_precision;
+};
+
+}} // namespaces
+
+#endif
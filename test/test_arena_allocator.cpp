@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/arena_allocator.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include "test.hpp"
+
+#ifdef BOOST_MP_HAS_ARENA_ALLOCATOR
+
+using namespace boost::multiprecision;
+
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, arena_allocator<limb_type> > > arena_int;
+typedef number<cpp_bin_float<200, digit_base_10, arena_allocator<limb_type> > >                   arena_bin_float;
+typedef number<cpp_dec_float<200, boost::int32_t, arena_allocator<boost::uint32_t> > >            arena_dec_float;
+
+template <class T>
+T big_value(unsigned i)
+{
+   T result = T(i + 3) << (100 * i + 300);
+   return result - T(7) * i;
+}
+
+void test_int()
+{
+   monotonic_arena arena, inner_arena;
+   arena_int outer(1), outer2;
+   cpp_int expected;
+   BOOST_CHECK(outer.backend().allocator().arena() == 0);
+   {
+      arena_scope scope(arena);
+      arena_int sum;
+      BOOST_CHECK(sum.backend().allocator().arena() == &arena);
+      for(unsigned i = 0; i < 20; ++i)
+      {
+         arena_int a = big_value<arena_int>(i), b = big_value<arena_int>(i + 7);
+         sum += a * b;
+         expected += big_value<cpp_int>(i) * big_value<cpp_int>(i + 7);
+      }
+      BOOST_CHECK(arena.bytes_reserved() > 0);
+      //
+      // Copy and move assignment into a value created outside the scope copy into its own storage:
+      //
+      outer = sum;
+      arena_int t(sum);
+      outer2 = std::move(t);
+      BOOST_CHECK(outer.backend().allocator().arena() == 0);
+      BOOST_CHECK(outer2.backend().allocator().arena() == 0);
+      BOOST_CHECK_EQUAL(t.str(), sum.str());
+      //
+      // Swapping values from different arenas exchanges the values but not the storage:
+      //
+      {
+         arena_scope scope2(inner_arena);
+         arena_int x(3);
+         BOOST_CHECK(x.backend().allocator().arena() == &inner_arena);
+         swap(x, sum);
+         BOOST_CHECK_EQUAL(x.str(), outer.str());
+         BOOST_CHECK_EQUAL(sum, 3);
+         BOOST_CHECK(x.backend().allocator().arena() == &inner_arena);
+         BOOST_CHECK(sum.backend().allocator().arena() == &arena);
+         x.backend().swap(sum.backend());
+         BOOST_CHECK_EQUAL(x, 3);
+         BOOST_CHECK_EQUAL(sum.str(), outer.str());
+         sum = x * sum;
+      }
+      BOOST_CHECK_EQUAL(sum.str(), arena_int(outer * 3).str());
+      //
+      // Copy construction of an outside value places the copy in the current arena:
+      //
+      arena_int c(outer);
+      BOOST_CHECK(c.backend().allocator().arena() == &arena);
+      //
+      // A null scope suspends the arena:
+      //
+      {
+         arena_scope heap(0);
+         arena_int h(c);
+         BOOST_CHECK(h.backend().allocator().arena() == 0);
+         BOOST_CHECK_EQUAL(h, c);
+      }
+   }
+   //
+   // The arena has been released, the outer values are unaffected:
+   //
+   BOOST_CHECK_EQUAL(outer.str(), expected.str());
+   BOOST_CHECK_EQUAL(outer2.str(), expected.str());
+   //
+   // Subsequent scopes reuse the memory kept by the arena:
+   //
+   std::size_t reserved = arena.bytes_reserved();
+   for(unsigned j = 0; j < 3; ++j)
+   {
+      arena_scope scope(arena);
+      arena_int sum;
+      for(unsigned i = 0; i < 20; ++i)
+         sum += big_value<arena_int>(i) * big_value<arena_int>(i + 7);
+      BOOST_CHECK_EQUAL(sum.str(), expected.str());
+      outer = sum - 1;
+   }
+   BOOST_CHECK_EQUAL(outer.str(), cpp_int(expected - 1).str());
+   BOOST_CHECK(arena.bytes_reserved() <= reserved);
+}
+
+void test_caller_buffer()
+{
+   static char buffer[1 << 16];
+   monotonic_arena arena(buffer, sizeof(buffer));
+   arena_int result;
+   {
+      arena_scope scope(arena);
+      arena_int a(1);
+      a <<= 5000;
+      a = a * a + 1;
+      result = a % 1000000007u;
+      BOOST_CHECK_EQUAL(arena.bytes_reserved(), 0u);
+   }
+   cpp_int b(1);
+   b <<= 5000;
+   b = b * b + 1;
+   BOOST_CHECK_EQUAL(result.str(), cpp_int(b % 1000000007u).str());
+}
+
+template <class T>
+void test_float()
+{
+   monotonic_arena arena;
+   T outer, outer2;
+   {
+      arena_scope scope(arena);
+      T x(2), sum;
+      for(unsigned i = 1; i < 50; ++i)
+      {
+         T t = x / i;
+         sum += t * t;
+      }
+      outer = sum;
+      outer2 = std::move(sum);
+      T a(1), b(2);
+      swap(a, outer);
+      swap(a, outer);
+      std::swap(b, outer2);
+      std::swap(b, outer2);
+      BOOST_CHECK_EQUAL(a, 1);
+      BOOST_CHECK_EQUAL(b, 2);
+   }
+   T expected;
+   T x(2);
+   for(unsigned i = 1; i < 50; ++i)
+   {
+      T t = x / i;
+      expected += t * t;
+   }
+   BOOST_CHECK_EQUAL(outer, expected);
+   BOOST_CHECK_EQUAL(outer2, expected);
+}
+
+int main()
+{
+   test_int();
+   test_caller_buffer();
+   test_float<arena_bin_float>();
+   test_float<arena_dec_float>();
+   return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+   return 0;
+}
+
+#endif
@@ -0,0 +1,21 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+
+#include "libs/multiprecision/test/test_arithmetic.hpp"
+
+template <boost::multiprecision::backends::digit_base_type DigitBase, class Allocator, class Exponent, Exponent MinExponent, Exponent MaxExponent, boost::multiprecision::expression_template_option ET>
+struct related_type<boost::multiprecision::number< boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinExponent, MaxExponent>, ET> >
+{
+   typedef boost::multiprecision::number< boost::multiprecision::cpp_bin_float<0, DigitBase, Allocator, Exponent, MinExponent, MaxExponent>, ET> type;
+};
+
+int main()
+{
+   test<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0> > >();
+   test<boost::multiprecision::number<boost::multiprecision::cpp_bin_float<0>, boost::multiprecision::et_off> >();
+   return boost::report_errors();
+}
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "test_arithmetic.hpp"
+#if defined(BOOST_MP_HAS_LIMB_POOL) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#endif
+
+template <unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_integer_type SignType, class Allocator, boost::multiprecision::expression_template_option ExpressionTemplates>
+struct is_twos_complement_integer<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<MinBits, MaxBits, SignType, boost::multiprecision::checked, Allocator>, ExpressionTemplates> > : public boost::mpl::false_ {};
+
+#if defined(BOOST_MP_HAS_LIMB_POOL) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+//
+// A value created by a thread_local destructor which runs after the thread's pool has gone,
+// and freed on another thread whose pool is still alive:
+//
+boost::multiprecision::cpp_int_pooled* late_value = 0;
+
+struct late_allocation
+{
+   ~late_allocation()
+   {
+      // 9 limbs, which is not a whole size class:
+      late_value = new boost::multiprecision::cpp_int_pooled(1);
+      *late_value <<= 9 * sizeof(boost::multiprecision::limb_type) * CHAR_BIT - 1;
+   }
+};
+
+void late_allocation_thread()
+{
+   static thread_local late_allocation l;
+   (void)&l;
+   // The pool is created after l, so is destroyed before it:
+   boost::multiprecision::cpp_int_pooled a(1);
+   a <<= 1000;
+}
+
+void test_free_after_pool_destroyed()
+{
+   std::thread t(late_allocation_thread);
+   t.join();
+   BOOST_CHECK(late_value != 0);
+   boost::multiprecision::cpp_int_pooled expected(1);
+   expected <<= 9 * sizeof(boost::multiprecision::limb_type) * CHAR_BIT - 1;
+   BOOST_CHECK_EQUAL(*late_value, expected);
+   delete late_value;
+   //
+   // The block just freed may be handed out for any request in its size class, and the whole
+   // of it must be usable:
+   //
+   for(unsigned i = 0; i < 8; ++i)
+   {
+      boost::multiprecision::cpp_int_pooled b(1);
+      b <<= (16u << i) * sizeof(boost::multiprecision::limb_type) * CHAR_BIT - 1;
+      b -= 1;
+      BOOST_CHECK_EQUAL(msb(b), (16u << i) * sizeof(boost::multiprecision::limb_type) * CHAR_BIT - 2);
+   }
+}
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_HAS_LIMB_POOL
+   test<boost::multiprecision::cpp_int_pooled>();
+   //
+   // Repeatedly allocated temporaries should come from the pool, and all of them have been freed by now:
+   //
+   boost::multiprecision::reset_limb_pool_statistics();
+   {
+      boost::multiprecision::cpp_int_pooled a(1), b;
+      a <<= 1000;
+      for(unsigned i = 0; i < 200; ++i)
+      {
+         boost::multiprecision::cpp_int_pooled t(a);
+         t *= a;
+         b = t + i;
+      }
+   }
+   boost::multiprecision::limb_pool_statistics stats = boost::multiprecision::get_limb_pool_statistics();
+   BOOST_CHECK(stats.hits > 100);
+   BOOST_CHECK(stats.misses < stats.hits);
+   BOOST_CHECK(stats.cached_blocks > 0);
+   boost::multiprecision::release_limb_pool();
+   stats = boost::multiprecision::get_limb_pool_statistics();
+   BOOST_CHECK_EQUAL(stats.cached_blocks, 0u);
+   BOOST_CHECK_EQUAL(stats.cached_bytes, 0u);
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+   test_free_after_pool_destroyed();
+#endif
+#endif
+   return boost::report_errors();
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "test_arithmetic.hpp"
+
+template <unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_integer_type SignType, class Allocator, boost::multiprecision::expression_template_option ExpressionTemplates>
+struct is_twos_complement_integer<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<MinBits, MaxBits, SignType, boost::multiprecision::checked, Allocator>, ExpressionTemplates> > : public boost::mpl::false_ {};
+
+unsigned allocation_count = 0;
+
+template <class T>
+struct counting_allocator : public std::allocator<T>
+{
+   template <class U>
+   struct rebind
+   {
+      typedef counting_allocator<U> other;
+   };
+   counting_allocator() {}
+   template <class U>
+   counting_allocator(const counting_allocator<U>&) {}
+   T* allocate(std::size_t n)
+   {
+      ++allocation_count;
+      return std::allocator<T>::allocate(n);
+   }
+};
+
+//
+// Arbitrary precision types which store values of up to MinBits bits internally:
+//
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<1024> > int_1024_inline;
+typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 0, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, counting_allocator<boost::multiprecision::limb_type> > > int_512_counted;
+
+int main()
+{
+   test<int_1024_inline>();
+   test<int_512_counted>();
+   //
+   // Values which fit in the internal buffer never allocate:
+   //
+   allocation_count = 0;
+   {
+      int_512_counted a(1), b(3), c;
+      a <<= 250;
+      b = pow(b, 100);
+      for(unsigned i = 0; i < 100; ++i)
+      {
+         c = a * b;
+         c = c / (b - i) + c % 1000;
+         c -= a;
+      }
+   }
+   BOOST_CHECK_EQUAL(allocation_count, 0u);
+   //
+   // Values may still grow beyond it, swapping internal and external values:
+   //
+   int_512_counted small(-12345), big(1), t(big);
+   big <<= 2000;
+   big -= 1;
+   t = big;
+   small.backend().swap(big.backend());
+   BOOST_CHECK(allocation_count > 0);
+   BOOST_CHECK_EQUAL(big, -12345);
+   BOOST_CHECK_EQUAL(small, t);
+   big.backend().swap(small.backend());
+   BOOST_CHECK_EQUAL(small, -12345);
+   BOOST_CHECK_EQUAL(big, t);
+   int_512_counted x(1), y(-2);
+   x <<= 500;
+   x.backend().swap(y.backend());
+   BOOST_CHECK_EQUAL(x, -2);
+   BOOST_CHECK_EQUAL(y, int_512_counted(1) << 500);
+   big.backend().swap(t.backend());
+   BOOST_CHECK_EQUAL(big, t);
+   return boost::report_errors();
+}
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the batch operations to the scalar ones.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/batch.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <vector>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+cpp_int generate_random(unsigned bits)
+{
+   boost::random::uniform_int_distribution<limb_type> d;
+   cpp_int result;
+   for(unsigned i = 0; i < bits; i += sizeof(limb_type) * CHAR_BIT)
+   {
+      result <<= sizeof(limb_type) * CHAR_BIT;
+      result |= d(gen);
+   }
+   return result >> (d(gen) % bits);
+}
+
+cpp_int mod(const cpp_int& x, const cpp_int& m)
+{
+   cpp_int r = x % m;
+   return r < 0 ? cpp_int(r + m) : r;
+}
+
+template <class Int>
+void test_mulmod(const std::vector<Int>& a, const std::vector<Int>& b, const Int& m)
+{
+   std::vector<Int> r(a.size());
+   batch::mulmod_n(&r[0], &a[0], &b[0], m, a.size());
+   for(unsigned i = 0; i < a.size(); ++i)
+   {
+      BOOST_CHECK_EQUAL(cpp_int(r[i]), mod(cpp_int(a[i]) * cpp_int(b[i]), cpp_int(m)));
+   }
+   // In place:
+   r = a;
+   batch::mulmod_n(&r[0], &r[0], &b[0], m, a.size());
+   for(unsigned i = 0; i < a.size(); ++i)
+   {
+      BOOST_CHECK_EQUAL(cpp_int(r[i]), mod(cpp_int(a[i]) * cpp_int(b[i]), cpp_int(m)));
+   }
+}
+
+template <class Int>
+void test()
+{
+   //
+   // Types which don't wrap around are given values small enough not to overflow:
+   //
+   bool modulo = std::numeric_limits<Int>::is_modulo;
+   unsigned bits = std::numeric_limits<Int>::is_bounded ? std::numeric_limits<Int>::digits : 500;
+   unsigned value_bits = modulo ? bits : bits / 2 - 1;
+   std::vector<Int> a, b;
+   a.push_back(Int(0));
+   b.push_back(Int(0));
+   a.push_back(Int(1));
+   b.push_back(Int(5));
+   if(modulo)
+   {
+      a.push_back((std::numeric_limits<Int>::max)());
+      b.push_back((std::numeric_limits<Int>::max)());
+   }
+   for(unsigned i = 0; i < 500; ++i)
+   {
+      a.push_back(Int(generate_random(value_bits)));
+      b.push_back(Int(generate_random(1 + i % value_bits)));
+      if(std::numeric_limits<Int>::is_signed && (i % 3 == 0))
+         a.back() = Int(cpp_int(-cpp_int(a.back())));
+   }
+   std::vector<Int> r(a.size()), r2(a.size());
+   batch::add_n(&r[0], &a[0], &b[0], a.size());
+   for(unsigned i = 0; i < a.size(); ++i)
+      BOOST_CHECK_EQUAL(r[i], Int(a[i] + b[i]));
+   // Results which are the same array as an argument:
+   r2 = b;
+   batch::add_n(&r2[0], &a[0], &r2[0], a.size());
+   BOOST_CHECK(r == r2);
+   batch::sub_n(&r[0], &r[0], &b[0], a.size());
+   if(!std::numeric_limits<Int>::is_signed || !modulo)
+      BOOST_CHECK(r == a);
+   if(modulo)
+   {
+      // Wraps around:
+      batch::sub_n(&r[0], &b[0], &a[0], a.size());
+      for(unsigned i = 0; i < a.size(); ++i)
+         BOOST_CHECK_EQUAL(r[i], Int(b[i] - a[i]));
+   }
+   batch::mul_n(&r[0], &a[0], &b[0], a.size());
+   for(unsigned i = 0; i < a.size(); ++i)
+      BOOST_CHECK_EQUAL(r[i], Int(a[i] * b[i]));
+   r2 = a;
+   batch::mul_n(&r2[0], &r2[0], &r2[0], a.size());
+   for(unsigned i = 0; i < a.size(); ++i)
+      BOOST_CHECK_EQUAL(r2[i], Int(a[i] * a[i]));
+
+   for(unsigned i = 0; i < 5; ++i)
+   {
+      cpp_int m = generate_random(bits);
+      test_mulmod(a, b, Int(m | 1));
+      test_mulmod(a, b, Int(m + 2 - (m & 1)));
+      test_mulmod(a, b, Int(generate_random(bits / 2) | 1));
+   }
+   if(std::numeric_limits<Int>::is_bounded)
+      test_mulmod(a, b, (std::numeric_limits<Int>::max)());
+   test_mulmod(a, b, Int(1));
+   test_mulmod(a, b, Int(2));
+   test_mulmod(a, b, Int(3));
+   BOOST_CHECK_THROW(batch::mulmod_n(&r[0], &a[0], &b[0], Int(0), a.size()), std::domain_error);
+}
+
+int main()
+{
+   test<uint256_t>();
+   test<uint512_t>();
+   test<uint1024_t>();
+   test<number<cpp_int_backend<255, 255, unsigned_magnitude, unchecked, void> > >();
+   test<number<cpp_int_backend<96, 96, unsigned_magnitude, unchecked, void> > >();
+   test<uint128_t>();
+   test<int256_t>();
+   test<checked_uint256_t>();
+   test<cpp_int>();
+   //
+   // Checked types still check:
+   //
+   checked_uint256_t ca[2] = { checked_uint256_t(1), (std::numeric_limits<checked_uint256_t>::max)() };
+   checked_uint256_t cr[2];
+   BOOST_CHECK_THROW(batch::add_n(cr, ca, ca, 2), std::overflow_error);
+   return boost::report_errors();
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Check the variable precision cpp_bin_float<0>: at the precision of a fixed type it must give the same
+// results bit for bit, and with operands of different precisions each result must be rounded once.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include "test.hpp"
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+#include <thread>
+#endif
+
+using namespace boost::multiprecision;
+
+typedef number<cpp_bin_float<0> > Var;
+
+boost::random::mt19937 gen;
+
+template <class Float>
+Float random_value(int range)
+{
+   boost::random::uniform_real_distribution<double> d(-1, 1);
+   boost::random::uniform_int_distribution<int> e(-range, range);
+   // Fill every bit of the mantissa:
+   Float result = ldexp(Float(d(gen)), e(gen));
+   result += ldexp(Float(d(gen)), e(gen) - 50);
+   result += ldexp(Float(d(gen)), e(gen) - 100);
+   result += ldexp(Float(d(gen)), e(gen) - 150);
+   return result;
+}
+
+//
+// The default precision of 50 digits is the same number of bits as cpp_bin_float_50:
+//
+void test_fixed()
+{
+   BOOST_CHECK_EQUAL(Var::default_precision(), 50);
+   BOOST_CHECK_EQUAL(Var().backend().precision_bits(), cpp_bin_float_50::backend_type::bit_count);
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      cpp_bin_float_50 a = random_value<cpp_bin_float_50>(i % 2 ? 10 : 200);
+      cpp_bin_float_50 b = random_value<cpp_bin_float_50>(i % 2 ? 10 : 200);
+      cpp_bin_float_50 c = random_value<cpp_bin_float_50>(i % 2 ? 10 : 200);
+      Var va(a), vb(b), vc(c);
+      BOOST_CHECK_EQUAL(va.precision(), 50);
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(va), a);
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va + vb)), cpp_bin_float_50(a + b));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va - vb)), cpp_bin_float_50(a - b));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va * vb)), cpp_bin_float_50(a * b));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va / vb)), cpp_bin_float_50(a / b));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(sqrt(abs(va)))), cpp_bin_float_50(sqrt(abs(a))));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(fma(va, vb, vc))), cpp_bin_float_50(fma(a, b, c)));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va * 7u)), cpp_bin_float_50(a * 7u));
+      BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(va / -3)), cpp_bin_float_50(a / -3));
+      BOOST_CHECK_EQUAL(va < vb, a < b);
+      BOOST_CHECK_EQUAL(va.str(0, std::ios_base::scientific), a.str(0, std::ios_base::scientific));
+      BOOST_CHECK_EQUAL(Var(va.str(0, std::ios_base::scientific)), va);
+      if(i % 10 == 0)
+      {
+         cpp_bin_float_50 x = ldexp(a, -ilogb(a));
+         BOOST_CHECK_EQUAL(cpp_bin_float_50(Var(exp(Var(x)))), cpp_bin_float_50(exp(x)));
+         // log terminates its series on a slightly different bound when numeric_limits is not specialized:
+         cpp_bin_float_50 l = log(abs(x));
+         BOOST_CHECK(abs(cpp_bin_float_50(Var(log(Var(abs(x))))) - l) <= 2 * std::numeric_limits<cpp_bin_float_50>::epsilon() * abs(l));
+      }
+   }
+   BOOST_CHECK_EQUAL(Var(1.5), 1.5);
+   BOOST_CHECK_EQUAL(Var(-3), -3);
+   BOOST_CHECK_EQUAL(Var(0.1).str(0, std::ios_base::scientific), cpp_bin_float_50(0.1).str(0, std::ios_base::scientific));
+}
+
+//
+// Mixed precisions, against a reference wide enough to hold the exact sums and products:
+//
+void test_mixed()
+{
+   typedef number<cpp_bin_float<1000> > Wide;
+   typedef number<cpp_bin_float<100> >  Hundred;
+   for(unsigned i = 0; i < 500; ++i)
+   {
+      Var a(random_value<Wide>(20), 20), b(random_value<Wide>(20), 100), c(random_value<Wide>(20), 60);
+      if(i % 2)
+         c = -Var(Hundred(Wide(a) * Wide(b)), 60);
+      BOOST_CHECK_EQUAL(a.precision(), 20);
+      BOOST_CHECK_EQUAL(b.precision(), 100);
+      Var r = a + b;
+      BOOST_CHECK_EQUAL(r.precision(), 100);
+      BOOST_CHECK_EQUAL(Hundred(r), Hundred(Wide(a) + Wide(b)));
+      r = a - b;
+      BOOST_CHECK_EQUAL(Hundred(r), Hundred(Wide(a) - Wide(b)));
+      r = a * b;
+      BOOST_CHECK_EQUAL(Hundred(r), Hundred(Wide(a) * Wide(b)));
+      r = a * b + c;
+      BOOST_CHECK_EQUAL(Hundred(r), Hundred(Wide(Wide(a) * Wide(b)) + Wide(c)));
+      // The precision of the result can be set independently of the operands:
+      Var s(0, 20);
+      eval_multiply_add(s.backend(), a.backend(), b.backend(), c.backend());
+      BOOST_CHECK_EQUAL(s.precision(), 20);
+      BOOST_CHECK_EQUAL(number<cpp_bin_float<20> >(s), number<cpp_bin_float<20> >(Wide(Wide(a) * Wide(b)) + Wide(c)));
+      // Comparisons are exact:
+      Var t(b);
+      t.precision(20);
+      BOOST_CHECK_EQUAL(number<cpp_bin_float<20> >(t), number<cpp_bin_float<20> >(b));
+      BOOST_CHECK_EQUAL(t == number<cpp_bin_float<20> >(b), true);
+      BOOST_CHECK_EQUAL(t == b, Hundred(t) == Hundred(b));
+      t.precision(100);
+      BOOST_CHECK_EQUAL(t.precision(), 100);
+      BOOST_CHECK_EQUAL(number<cpp_bin_float<20> >(t), number<cpp_bin_float<20> >(b));
+   }
+   //
+   // Adaptive precision: a determinant which cancels completely at low precision is
+   // resolved by recomputing at a higher one:
+   //
+   Var x("1e-30"), y(1);
+   for(unsigned digits = 10; digits <= 40; digits += 10)
+   {
+      Var xd(x, digits), yd(y, digits);
+      Var z = (yd + xd) - yd;
+      BOOST_CHECK_EQUAL(z.precision(), digits);
+      if(digits < 30)
+      {
+         BOOST_CHECK_EQUAL(z, 0);
+      }
+      else
+      {
+         BOOST_CHECK(z > 0);
+      }
+   }
+}
+
+//
+// The default precision, and the constants cached at it:
+//
+void test_default_precision()
+{
+   Var::default_precision(100);
+   Var pi = boost::math::constants::pi<Var>();
+   BOOST_CHECK_EQUAL(pi.precision(), 100);
+   BOOST_CHECK_EQUAL(number<cpp_bin_float<100> >(pi), boost::math::constants::pi<number<cpp_bin_float<100> > >());
+   BOOST_CHECK_EQUAL(number<cpp_bin_float<100> >(Var(log(Var(2)))), log(number<cpp_bin_float<100> >(2)));
+   Var::default_precision(20);
+   BOOST_CHECK_EQUAL(Var(1).precision(), 20);
+   BOOST_CHECK_EQUAL(number<cpp_bin_float<20> >(Var(log(Var(2)))), log(number<cpp_bin_float<20> >(2)));
+   // Values keep their own precision when the default changes:
+   BOOST_CHECK_EQUAL(pi.precision(), 100);
+   Var::default_precision(50);
+   BOOST_CHECK_EQUAL(Var(pi * 1).precision(), 100);
+   BOOST_CHECK_EQUAL(std::numeric_limits<Var>::epsilon(), ldexp(Var(1), 1 - static_cast<int>(cpp_bin_float_50::backend_type::bit_count)));
+   BOOST_CHECK((boost::math::isinf)(std::numeric_limits<Var>::infinity()));
+   BOOST_CHECK((boost::math::isnan)(std::numeric_limits<Var>::quiet_NaN()));
+   BOOST_CHECK((boost::math::isinf)(Var((std::numeric_limits<Var>::max)() * 2)));
+   BOOST_CHECK_EQUAL(Var((std::numeric_limits<Var>::min)() / 2), 0);
+   BOOST_CHECK((boost::math::isnan)(Var(sqrt(Var(-1)))));
+   BOOST_CHECK((boost::math::isinf)(Var(Var(1) / 0)));
+   BOOST_CHECK_EQUAL(Var(Var(0) / 3), 0);
+}
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+//
+// Each thread has its own default precision:
+//
+void thread_body(unsigned digits, bool* ok)
+{
+   *ok = Var::default_precision() == 50;
+   Var::default_precision(digits);
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      Var x = Var(1) / 3;
+      *ok = *ok && (x.precision() == digits) && (Var::default_precision() == digits);
+   }
+}
+#endif
+
+void test_threads()
+{
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+   bool ok1 = false, ok2 = false;
+   std::thread t1(thread_body, 20u, &ok1), t2(thread_body, 200u, &ok2);
+   t1.join();
+   t2.join();
+   BOOST_CHECK(ok1);
+   BOOST_CHECK(ok2);
+   BOOST_CHECK_EQUAL(Var::default_precision(), 50);
+#endif
+}
+
+int main()
+{
+   test_fixed();
+   test_mixed();
+   test_default_precision();
+   test_threads();
+   return boost::report_errors();
+}
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare cpp_dec_float quotients against cpp_int, at precisions using both long division
+// and Newton iteration.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_digits(unsigned n)
+{
+   boost::random::uniform_int_distribution<int> d(0, 9);
+   std::string result(n, '0');
+   result[0] = static_cast<char>('1' + d(gen) % 9);
+   for(unsigned i = 1; i < n; ++i)
+      result[i] = static_cast<char>('0' + d(gen));
+   return result;
+}
+//
+// The digits of a large integral value, which cpp_int can read back:
+//
+template <class Float>
+cpp_int to_integer(const Float& x)
+{
+   std::string s = x.str(0, std::ios_base::fixed);
+   return cpp_int(s.substr(0, s.find('.')));
+}
+//
+// Checks that q is within a few ulp of a / b, where the values are integers, by
+// scaling a up by 10^digits10 first:
+//
+template <class Float>
+void check_quotient(const Float& q, const cpp_int& a, const cpp_int& b)
+{
+   const unsigned digits = std::numeric_limits<Float>::digits10;
+   cpp_int scale = pow(cpp_int(10), 2 * digits);
+   cpp_int exact = a * scale / b;
+   cpp_int err = exact - to_integer(Float(q * Float(scale)));
+   BOOST_CHECK(abs(err) * pow(cpp_int(10), digits) < exact);
+}
+
+template <class Float>
+void test(bool exact)
+{
+   const unsigned digits = std::numeric_limits<Float>::digits10;
+   for(unsigned i = 0; i < 5; ++i)
+   {
+      //
+      // Exact quotients, and divisors with few limbs:
+      //
+      std::string sa = generate_digits(digits / 2 - i);
+      std::string sb = generate_digits(1 + (i * digits) / 8);
+      cpp_int ia(sa), ib(sb);
+      Float a(sa), b(sb);
+      if(exact)
+      {
+         BOOST_CHECK_EQUAL(to_integer(Float(Float(a * b) / b)), ia);
+         BOOST_CHECK_EQUAL(to_integer(Float(Float(a * b) / a)), ib);
+      }
+      check_quotient(Float(a / b), ia, ib);
+      check_quotient(Float(b / a), ib, ia);
+      //
+      // Full width values, quotients are truncated:
+      //
+      sa = generate_digits(digits);
+      sb = generate_digits(digits - i);
+      ia = cpp_int(sa);
+      ib = cpp_int(sb);
+      a = Float(sa);
+      b = Float(sb);
+      Float q = a / b;
+      check_quotient(q, ia, ib);
+      if(exact)
+      {
+         BOOST_CHECK(Float(q * b) <= a);
+      }
+      check_quotient(Float(b / a), ib, ia);
+      // Signs and exponents:
+      check_quotient(Float(-a / -b), ia, ib);
+      BOOST_CHECK_EQUAL(Float(-a / b), -q);
+      BOOST_CHECK_EQUAL(Float(a / -b), -q);
+      BOOST_CHECK_EQUAL(Float(Float(a * pow(Float(10), 24)) / Float(b * pow(Float(10), 16))), Float(q * 100000000uL));
+      Float c(a);
+      c /= c;
+      BOOST_CHECK_EQUAL(c, 1);
+   }
+   Float third = Float(1) / 3;
+   BOOST_CHECK(abs(third * 3 - 1) <= std::numeric_limits<Float>::epsilon());
+   if(exact)
+   {
+      BOOST_CHECK(third * 3 < 1);
+      BOOST_CHECK_EQUAL(Float(7) / Float(0.125), 56);
+   }
+   //
+   // Special values:
+   //
+   BOOST_CHECK((boost::math::isinf)(Float(Float(1) / 0)));
+   BOOST_CHECK((boost::math::isinf)(Float(Float(-1) / 0)) && (Float(Float(-1) / 0) < 0));
+   BOOST_CHECK((boost::math::isnan)(Float(Float(0) / 0)));
+   BOOST_CHECK_EQUAL(Float(Float(0) / 3), 0);
+   BOOST_CHECK_EQUAL(Float(Float(3) / std::numeric_limits<Float>::infinity()), 0);
+   BOOST_CHECK((boost::math::isinf)(Float(std::numeric_limits<Float>::infinity() / 3)));
+   BOOST_CHECK((boost::math::isnan)(Float(std::numeric_limits<Float>::infinity() / std::numeric_limits<Float>::infinity())));
+   BOOST_CHECK((boost::math::isnan)(Float(std::numeric_limits<Float>::quiet_NaN() / 3)));
+   BOOST_CHECK((boost::math::isinf)(Float((std::numeric_limits<Float>::max)() / Float(0.5))));
+   BOOST_CHECK((boost::math::isinf)(Float(-(std::numeric_limits<Float>::max)() / Float(0.5))));
+   BOOST_CHECK_EQUAL(Float((std::numeric_limits<Float>::min)() / 3), 0);
+   BOOST_CHECK_EQUAL(Float((std::numeric_limits<Float>::max)() / (std::numeric_limits<Float>::max)()), 1);
+}
+
+int main()
+{
+   test<number<cpp_dec_float<50> > >(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF > 10);
+   test<number<cpp_dec_float<100> > >(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF > 16);
+   test<number<cpp_dec_float<200> > >(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF > 29);
+   test<number<cpp_dec_float<1000> > >(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF > 128);
+   test<number<cpp_dec_float<5000, boost::int32_t, std::allocator<void> > > >(BOOST_MP_CPP_DEC_FLOAT_NEWTON_DIVISION_CUTOFF > 628);
+   return boost::report_errors();
+}
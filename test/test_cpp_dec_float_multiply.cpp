@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare cpp_dec_float products against cpp_int, at precisions using each of the
+// multiplication algorithms, including some beyond the reach of the schoolbook loop.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_digits(unsigned n)
+{
+   boost::random::uniform_int_distribution<int> d(0, 9);
+   std::string result(n, '0');
+   result[0] = static_cast<char>('1' + d(gen) % 9);
+   for(unsigned i = 1; i < n; ++i)
+      result[i] = static_cast<char>('0' + d(gen));
+   return result;
+}
+//
+// The digits of a large integral value, which cpp_int can read back:
+//
+template <class Float>
+cpp_int to_integer(const Float& x)
+{
+   std::string s = x.str(0, std::ios_base::fixed);
+   return cpp_int(s.substr(0, s.find('.')));
+}
+
+template <class Float>
+void test()
+{
+   const unsigned digits = std::numeric_limits<Float>::digits10;
+   for(unsigned i = 0; i < 3; ++i)
+   {
+      //
+      // Products which fit in the precision are exact:
+      //
+      std::string sa = generate_digits(digits / 2 - i);
+      std::string sb = generate_digits(digits / 2 - 1);
+      Float a(sa), b(sb);
+      cpp_int ia(sa), ib(sb);
+      BOOST_CHECK_EQUAL(to_integer(Float(a * b)), ia * ib);
+      BOOST_CHECK_EQUAL(to_integer(Float(a * a)), ia * ia);
+      Float c(a);
+      c *= c;
+      BOOST_CHECK_EQUAL(to_integer(c), ia * ia);
+      //
+      // Full width products are truncated, so the error is less than one part in 10^digits10:
+      //
+      sa = generate_digits(digits);
+      sb = generate_digits(digits);
+      a = Float(sa);
+      b = Float(sb);
+      ia = cpp_int(sa);
+      ib = cpp_int(sb);
+      cpp_int exact = ia * ib;
+      cpp_int err = exact - to_integer(Float(a * b));
+      BOOST_CHECK(err >= 0);
+      BOOST_CHECK(err * pow(cpp_int(10), digits) < exact);
+      exact = ia * ia;
+      err = exact - to_integer(Float(a * a));
+      BOOST_CHECK(err >= 0);
+      BOOST_CHECK(err * pow(cpp_int(10), digits) < exact);
+   }
+   //
+   // Non-integral values and carries out of the top limb:
+   //
+   Float x = Float(1) / 3;
+   Float y = x * 3;
+   BOOST_CHECK(abs(1 - y) <= std::numeric_limits<Float>::epsilon());
+   x = sqrt(Float(2));
+   y = x * x;
+   BOOST_CHECK(abs(y - 2) < 4 * std::numeric_limits<Float>::epsilon());
+   x = Float(std::string(digits, '9'));
+   y = x * x;
+   BOOST_CHECK_EQUAL(y.backend().order(), static_cast<long>(2 * digits - 1));
+}
+
+int main()
+{
+   test<number<cpp_dec_float<50> > >();
+   test<number<cpp_dec_float<1000> > >();
+   test<number<cpp_dec_float<12000> > >();
+   test<number<cpp_dec_float<15000> > >();
+   test<number<cpp_dec_float<60000, boost::int32_t, std::allocator<void> > > >();
+   return boost::report_errors();
+}
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Check the powers of 2 and limits which cpp_dec_float builds on first use against exact values.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/lexical_cast.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+template <class Float>
+cpp_int to_integer(const Float& x)
+{
+   std::string s = x.str(0, std::ios_base::fixed);
+   return cpp_int(s.substr(0, s.find('.')));
+}
+
+template <class Float>
+void test(bool exact)
+{
+   typedef typename Float::backend_type backend_type;
+   const Float eps = std::numeric_limits<Float>::epsilon();
+   for(int p = -140; p <= 140; ++p)
+   {
+      const Float x(backend_type::pow2(p));
+      if(p >= 0)
+      {
+         if(exact || (p < 30))
+         {
+            BOOST_CHECK_EQUAL(to_integer(x), cpp_int(1) << p);
+         }
+      }
+      else
+      {
+         // 2^p * 10^-p = 5^-p:
+         const cpp_int five = pow(cpp_int(5), -p);
+         const Float y = x * pow(Float(10), -p);
+         if(exact && (p > -128))
+         {
+            BOOST_CHECK_EQUAL(to_integer(y), five);
+         }
+         BOOST_CHECK(abs(y / Float(five) - 1) <= eps);
+      }
+      BOOST_CHECK(abs(Float(x * Float(backend_type::pow2(-p))) - 1) <= 2 * eps);
+   }
+   BOOST_CHECK_EQUAL((std::numeric_limits<Float>::max)(), Float("1e" + boost::lexical_cast<std::string>(std::numeric_limits<Float>::max_exponent10)));
+   BOOST_CHECK_EQUAL((std::numeric_limits<Float>::min)(), Float("1e" + boost::lexical_cast<std::string>(std::numeric_limits<Float>::min_exponent10)));
+}
+
+int main()
+{
+   test<number<cpp_dec_float<9> > >(false);
+   test<number<cpp_dec_float<50> > >(false);
+   test<number<cpp_dec_float<100> > >(true);
+   test<number<cpp_dec_float<1000, boost::long_long_type, std::allocator<void> > > >(true);
+   return boost::report_errors();
+}
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the results of bitwise operations, shifts and popcount on large values - which go
+// through the limb vector kernels - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x1");
+   for(unsigned i = 1; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+template <class Int>
+void test_values(const mpz_int& a, const mpz_int& b)
+{
+   if(std::numeric_limits<Int>::is_bounded && ((msb(a) >= static_cast<unsigned>(std::numeric_limits<Int>::digits)) || (msb(b) >= static_cast<unsigned>(std::numeric_limits<Int>::digits))))
+      return;
+   Int a1(a.str()), b1(b.str());
+   BOOST_CHECK_EQUAL(Int(a1 & b1).str(), mpz_int(a & b).str());
+   BOOST_CHECK_EQUAL(Int(a1 | b1).str(), mpz_int(a | b).str());
+   BOOST_CHECK_EQUAL(Int(a1 ^ b1).str(), mpz_int(a ^ b).str());
+   BOOST_CHECK_EQUAL(Int(b1 & a1).str(), mpz_int(a & b).str());
+   BOOST_CHECK_EQUAL(Int(b1 | a1).str(), mpz_int(a | b).str());
+   BOOST_CHECK_EQUAL(Int(b1 ^ a1).str(), mpz_int(a ^ b).str());
+   Int t(a1);
+   t &= b1;
+   BOOST_CHECK_EQUAL(t.str(), mpz_int(a & b).str());
+   t = a1;
+   t |= b1;
+   BOOST_CHECK_EQUAL(t.str(), mpz_int(a | b).str());
+   t = a1;
+   t ^= b1;
+   BOOST_CHECK_EQUAL(t.str(), mpz_int(a ^ b).str());
+   t = a1;
+   t ^= t;
+   BOOST_CHECK_EQUAL(t, 0);
+   BOOST_CHECK_EQUAL(popcount(a1), popcount(a));
+   BOOST_CHECK_EQUAL(popcount(b1), popcount(b));
+   BOOST_CHECK_EQUAL(popcount(a1 ^ b1), popcount(mpz_int(a ^ b)));
+   //
+   // Every shift within a couple of limbs, plus some large ones:
+   //
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   for(unsigned s = 1; s < 2 * bits + 3; s += (s < bits + 2 ? 1 : bits - 1))
+   {
+      BOOST_CHECK_EQUAL(Int(a1 >> s).str(), mpz_int(a >> s).str());
+      if(!std::numeric_limits<Int>::is_bounded)
+      {
+         BOOST_CHECK_EQUAL(Int(a1 << s).str(), mpz_int(a << s).str());
+      }
+      else
+      {
+         mpz_int mask = (mpz_int(1) << std::numeric_limits<Int>::digits) - 1;
+         BOOST_CHECK_EQUAL(Int(a1 << s).str(), mpz_int((a << s) & mask).str());
+      }
+      t = a1;
+      t <<= s;
+      t >>= s;
+      if(!std::numeric_limits<Int>::is_bounded)
+         BOOST_CHECK_EQUAL(t, a1);
+   }
+   unsigned s = msb(a) / 2 + 5;
+   BOOST_CHECK_EQUAL(Int(a1 >> s).str(), mpz_int(a >> s).str());
+   BOOST_CHECK_EQUAL(Int(a1 >> (msb(a) + 1)), 0);
+   if(!std::numeric_limits<Int>::is_bounded)
+      BOOST_CHECK_EQUAL(Int(a1 << s).str(), mpz_int(a << s).str());
+}
+
+template <class Int>
+void test_bitwise(unsigned abits, unsigned bbits)
+{
+   mpz_int a(generate_random_hex(abits)), b(generate_random_hex(bbits));
+   test_values<Int>(a, b);
+   test_values<Int>(b, a);
+   mpz_int ones = (mpz_int(1) << abits) - 1;
+   test_values<Int>(ones, b);
+   test_values<Int>(mpz_int(ones ^ a), a);
+}
+
+#ifdef BOOST_MP_HAS_SIMD_BITWISE
+//
+// Check each of the SIMD kernels against the portable loops regardless of which would be dispatched
+// to, including every tail length and destinations overlapping the source:
+//
+void test_kernels()
+{
+   static const unsigned max_n = 75;
+   limb_type a[max_n + 8], b[max_n + 8], r1[max_n + 8], r2[max_n + 8];
+   boost::random::uniform_int_distribution<limb_type> d;
+   for(unsigned i = 0; i < max_n + 8; ++i)
+   {
+      a[i] = d(gen);
+      b[i] = d(gen);
+   }
+   bool avx2 = backends::simd::has_avx2();
+   for(unsigned n = 1; n <= max_n; ++n)
+   {
+      unsigned expected = 0;
+      for(unsigned i = 0; i < n; ++i)
+         expected += boost::multiprecision::detail::count_bits(a[i]);
+      BOOST_CHECK_EQUAL(backends::simd::popcount_n_sse2(a, n), expected);
+      BOOST_CHECK_EQUAL(backends::popcount_n(a, n), expected);
+      if(backends::simd::has_popcnt())
+         BOOST_CHECK_EQUAL(backends::simd::popcount_n_popcnt(a, n), expected);
+      if(avx2)
+         BOOST_CHECK_EQUAL(backends::simd::popcount_n_avx2(a, n), expected);
+
+      for(unsigned i = 0; i < n; ++i)
+         r1[i] = a[i] ^ b[i];
+      backends::simd::bitwise_n_sse2<backends::simd::xor_op>(r2, a, b, n);
+      BOOST_CHECK(std::equal(r1, r1 + n, r2));
+      if(avx2)
+      {
+         backends::simd::bitwise_n_avx2<backends::simd::xor_op>(r2, a, b, n);
+         BOOST_CHECK(std::equal(r1, r1 + n, r2));
+      }
+      for(unsigned i = 0; i < n; ++i)
+         r1[i] = ~a[i];
+      backends::simd::com_n_sse2(r2, a, n);
+      BOOST_CHECK(std::equal(r1, r1 + n, r2));
+      if(avx2)
+      {
+         backends::simd::com_n_avx2(r2, a, n);
+         BOOST_CHECK(std::equal(r1, r1 + n, r2));
+      }
+
+      for(unsigned shift = 1; shift < sizeof(limb_type) * CHAR_BIT; shift += 7)
+      {
+         for(unsigned offset = 0; offset < 3; ++offset)
+         {
+            limb_type (*lshift[2])(limb_type*, const limb_type*, unsigned, unsigned) = { backends::simd::lshift_n_sse2, backends::simd::lshift_n_avx2 };
+            limb_type (*rshift[2])(limb_type*, const limb_type*, unsigned, unsigned) = { backends::simd::rshift_n_sse2, backends::simd::rshift_n_avx2 };
+            for(unsigned k = 0; k < (avx2 ? 2u : 1u); ++k)
+            {
+               // Left shift from r2[0, n) into r2[offset, offset + n):
+               std::copy(a, a + n, r2);
+               limb_type carry = lshift[k](r2 + offset, r2, n, shift);
+               BOOST_CHECK_EQUAL(carry, a[n - 1] >> (sizeof(limb_type) * CHAR_BIT - shift));
+               for(unsigned i = 0; i < n; ++i)
+                  BOOST_CHECK_EQUAL(r2[i + offset], (a[i] << shift) | (i ? a[i - 1] >> (sizeof(limb_type) * CHAR_BIT - shift) : 0));
+               // Right shift from r2[offset, offset + n) into r2[0, n):
+               std::copy(a, a + n, r2 + offset);
+               carry = rshift[k](r2, r2 + offset, n, shift);
+               BOOST_CHECK_EQUAL(carry, a[0] << (sizeof(limb_type) * CHAR_BIT - shift));
+               for(unsigned i = 0; i < n; ++i)
+                  BOOST_CHECK_EQUAL(r2[i], (a[i] >> shift) | (i + 1 < n ? a[i + 1] << (sizeof(limb_type) * CHAR_BIT - shift) : 0));
+            }
+         }
+      }
+   }
+}
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_HAS_SIMD_BITWISE
+   test_kernels();
+#endif
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   //
+   // Sizes either side of BOOST_MP_SIMD_BITWISE_CUTOFF, with operands of equal and unequal length:
+   //
+   for(unsigned l = 1; l < BOOST_MP_SIMD_BITWISE_CUTOFF + 10; ++l)
+   {
+      test_bitwise<cpp_int>(l * bits, l * bits);
+      test_bitwise<cpp_int>(l * bits - 3, l * bits - 11);
+      test_bitwise<cpp_int>(l * bits + 5, 3 * bits);
+   }
+   boost::random::uniform_int_distribution<unsigned> d(2 * bits, 300 * bits);
+   for(unsigned i = 0; i < 50; ++i)
+      test_bitwise<cpp_int>(d(gen), d(gen));
+   test_bitwise<cpp_int>(1000 * bits + 17, 999 * bits);
+   //
+   // Fixed precision types, where shifts are truncated:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_bitwise<uint1024_t>(1024, 1000);
+      test_bitwise<uint1024_t>(1000, 64 * 4 - 1);
+      test_bitwise<int1024_t>(1024, 200);
+      test_bitwise<uint512_t>(512, 129);
+      test_bitwise<number<cpp_int_backend<2000, 2000, unsigned_magnitude> > >(2000, 1999);
+   }
+   //
+   // popcount of negative values is an error, of zero is zero:
+   //
+   BOOST_CHECK_THROW(popcount(cpp_int(-1)), std::range_error);
+   BOOST_CHECK_THROW(popcount(int128_t(-1)), std::range_error);
+   BOOST_CHECK_THROW(popcount(mpz_int(-1)), std::range_error);
+   BOOST_CHECK_EQUAL(popcount(cpp_int(0)), 0u);
+   BOOST_CHECK_EQUAL(popcount(mpz_int(0)), 0u);
+   BOOST_CHECK_EQUAL(popcount(uint128_t(~uint128_t(0))), 128u);
+   BOOST_CHECK_EQUAL(popcount(number<cpp_int_backend<64, 64, signed_magnitude, unchecked, void> >(-1) * -1), 1u);
+   BOOST_CHECK_EQUAL(popcount(cpp_int(cpp_int(1) << 1000) - 1), 1000u);
+   return boost::report_errors();
+}
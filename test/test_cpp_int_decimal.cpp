@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare decimal string conversion of large values - which is done by recursively
+// splitting the value or string by powers of 10 - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+//
+// No leading zero, as that would make the string octal:
+//
+std::string generate_random_decimal(unsigned digits)
+{
+   boost::random::uniform_int_distribution<unsigned> d(0, 9), d1(1, 9);
+   std::string result(1, static_cast<char>('0' + d1(gen)));
+   for(unsigned i = 1; i < digits; ++i)
+      result += static_cast<char>('0' + d(gen));
+   return result;
+}
+
+void test_round_trip(const std::string& s)
+{
+   cpp_int a(s);
+   mpz_int b(s);
+   BOOST_CHECK_EQUAL(a.str(), b.str());
+   BOOST_CHECK_EQUAL(a.str(), s);
+   cpp_int c(-a);
+   BOOST_CHECK_EQUAL(c.str(), mpz_int(-b).str());
+   BOOST_CHECK_EQUAL(cpp_int(c.str()), c);
+   BOOST_CHECK_EQUAL(a.str(0, std::ios_base::showpos), mpz_int(b).str(0, std::ios_base::showpos));
+}
+
+template <class Int>
+void test_fixed(const std::string& s)
+{
+   //
+   // Fixed precision types truncate long strings just as they truncate the
+   // equivalent arithmetic:
+   //
+   cpp_int a(s);
+   Int b(s);
+   BOOST_CHECK_EQUAL(b, Int(a & cpp_int(std::numeric_limits<Int>::max())));
+   BOOST_CHECK_EQUAL(b.str(), Int(a & cpp_int(std::numeric_limits<Int>::max())).str());
+}
+
+int main()
+{
+   static const unsigned block = sizeof(limb_type) == 8 ? 18 : 9;
+   for(unsigned digits = 1; digits < 200; ++digits)
+      test_round_trip(generate_random_decimal(digits));
+   //
+   // Either side of the cutoff, and lengths that are and aren't a whole number of blocks:
+   //
+   for(unsigned digits = BOOST_MP_DECIMAL_DC_CUTOFF * block - 40; digits < BOOST_MP_DECIMAL_DC_CUTOFF * block + 40; digits += 3)
+      test_round_trip(generate_random_decimal(digits));
+   boost::random::uniform_int_distribution<unsigned> d(1000, 40000);
+   for(unsigned i = 0; i < 20; ++i)
+      test_round_trip(generate_random_decimal(d(gen)));
+   test_round_trip(generate_random_decimal(100000));
+   //
+   // Long runs of zeros and nines, and powers of 10 which are exactly the splitting values:
+   //
+   test_round_trip(std::string(20000, '9'));
+   test_round_trip("1" + std::string(20000, '0'));
+   test_round_trip("1" + std::string(block << 10, '0'));
+   test_round_trip(std::string(block << 10, '9'));
+   test_round_trip(generate_random_decimal(5000) + std::string(10000, '0') + generate_random_decimal(5000));
+   {
+      cpp_int p = pow(cpp_int(10), 10000);
+      BOOST_CHECK_EQUAL(p.str(), "1" + std::string(10000, '0'));
+      --p;
+      BOOST_CHECK_EQUAL(p.str(), std::string(10000, '9'));
+   }
+   //
+   // Errors are found wherever they are in the string:
+   //
+   {
+      std::string s = generate_random_decimal(10000);
+      s[7000] = 'a';
+      BOOST_CHECK_THROW(cpp_int(s.c_str()), std::runtime_error);
+      s[7000] = '1';
+      s[9999] = ' ';
+      BOOST_CHECK_THROW(cpp_int(s.c_str()), std::runtime_error);
+   }
+   //
+   // Fixed precision types:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_fixed<uint1024_t>(generate_random_decimal(5000));
+      test_fixed<uint512_t>(generate_random_decimal(300));
+   }
+   BOOST_CHECK_THROW(checked_uint1024_t(generate_random_decimal(5000)), std::overflow_error);
+   BOOST_CHECK_EQUAL(checked_uint1024_t((std::numeric_limits<checked_uint1024_t>::max)().str()), (std::numeric_limits<checked_uint1024_t>::max)());
+   {
+      int1024_t a(-int1024_t(generate_random_decimal(300)));
+      BOOST_CHECK_EQUAL(int1024_t(a.str()), a);
+      BOOST_CHECK_EQUAL(a.str(), cpp_int(a).str());
+   }
+   return boost::report_errors();
+}
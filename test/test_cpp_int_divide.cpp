@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the results of large divisions - which go through Knuth's algorithm D
+// and the recursive Burnikel-Ziegler code - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <cstdlib>
+#include <new>
+
+//
+// Count the allocations made, so we can check fixed precision types make none:
+//
+unsigned allocation_count = 0;
+
+void* operator new(std::size_t n)
+{
+   ++allocation_count;
+   if(void* p = std::malloc(n ? n : 1))
+      return p;
+   throw std::bad_alloc();
+}
+void operator delete(void* p) BOOST_NOEXCEPT
+{
+   std::free(p);
+}
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x1");
+   for(unsigned i = 1; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+template <class Int>
+void test_values(const mpz_int& a, const mpz_int& b)
+{
+   //
+   // Some of the derived values don't fit in fixed precision types:
+   //
+   if(std::numeric_limits<Int>::is_bounded && (msb(abs(a)) >= static_cast<unsigned>(std::numeric_limits<Int>::digits)))
+      return;
+   Int a1(a.str()), b1(b.str()), q, r;
+   BOOST_CHECK_EQUAL(Int(a1 / b1).str(), mpz_int(a / b).str());
+   BOOST_CHECK_EQUAL(Int(a1 % b1).str(), mpz_int(a % b).str());
+   divide_qr(a1, b1, q, r);
+   BOOST_CHECK_EQUAL(q.str(), mpz_int(a / b).str());
+   BOOST_CHECK_EQUAL(r.str(), mpz_int(a % b).str());
+   Int t(a1);
+   t /= b1;
+   BOOST_CHECK_EQUAL(t, q);
+   t = a1;
+   t %= b1;
+   BOOST_CHECK_EQUAL(t, r);
+}
+
+template <class Int>
+void test_division(unsigned abits, unsigned bbits)
+{
+   mpz_int a(generate_random_hex(abits)), b(generate_random_hex(bbits));
+   test_values<Int>(a, b);
+   //
+   // Remainders at the extremes, and divisors with only the top bit set:
+   //
+   test_values<Int>(a * b, b);
+   test_values<Int>(mpz_int(a * b - 1), b);
+   test_values<Int>(mpz_int(a * b + b - 1), b);
+   mpz_int p = mpz_int(1) << (bbits - 1);
+   test_values<Int>(a, p);
+   test_values<Int>(mpz_int(a * p - 1), p);
+   //
+   // All ones, where every quotient estimate is at its largest:
+   //
+   mpz_int ones_a = (mpz_int(1) << abits) - 1;
+   mpz_int ones_b = (mpz_int(1) << bbits) - 1;
+   test_values<Int>(ones_a, ones_b);
+   test_values<Int>(ones_a, mpz_int(ones_b - 1));
+   test_values<Int>(ones_a, mpz_int(p + 1));
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   //
+   // Small divisors and quotients, either side of BOOST_MP_KNUTH_DIVIDE_CUTOFF:
+   //
+   for(unsigned bl = 2; bl < 8; ++bl)
+   {
+      for(unsigned ql = 0; ql < 8; ++ql)
+      {
+         test_division<cpp_int>((bl + ql) * bits, bl * bits);
+         test_division<cpp_int>((bl + ql) * bits - 5, bl * bits - 3);
+      }
+   }
+   //
+   // Balanced and unbalanced divisions either side of BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF:
+   //
+   for(unsigned bl = BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF - 2; bl < BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF + 3; ++bl)
+   {
+      test_division<cpp_int>(2 * bl * bits, bl * bits);
+      test_division<cpp_int>(2 * bl * bits - 1, bl * bits - 7);
+      test_division<cpp_int>((bl + 1) * bits, bl * bits);
+      test_division<cpp_int>(5 * bl * bits + 3, bl * bits);
+   }
+   boost::random::uniform_int_distribution<unsigned> d(2 * bits, 300 * bits);
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      unsigned x = d(gen), y = d(gen);
+      test_division<cpp_int>((std::max)(x, y), (std::min)(x, y));
+   }
+   test_division<cpp_int>(8000 * bits, 4000 * bits);
+   test_division<cpp_int>(9000 * bits, 2500 * bits + 11);
+   test_division<cpp_int>(8000 * bits, 200 * bits - 1);
+   //
+   // Signs follow truncating division:
+   //
+   {
+      mpz_int a(generate_random_hex(300 * bits)), b(generate_random_hex(100 * bits));
+      test_values<cpp_int>(mpz_int(-a), b);
+      test_values<cpp_int>(a, mpz_int(-b));
+      test_values<cpp_int>(mpz_int(-a), mpz_int(-b));
+   }
+   //
+   // Fixed precision types:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_division<uint1024_t>(1024, 300);
+      test_division<uint1024_t>(1000, 64 * 4 - 1);
+      test_division<int1024_t>(1000, 500);
+      test_division<checked_uint1024_t>(1024, 200);
+      test_division<uint512_t>(512, 129);
+   }
+   {
+      typedef number<cpp_int_backend<4096, 4096, unsigned_magnitude, unchecked, void> > uint4096_t;
+      uint4096_t a(generate_random_hex(4096)), b(generate_random_hex(2000)), c(generate_random_hex(100 * bits));
+      unsigned count = allocation_count;
+      uint4096_t q = a / b, r = a % b, q2 = a / c, r2 = a % c;
+      BOOST_CHECK_EQUAL(allocation_count, count);
+      BOOST_CHECK_EQUAL(uint4096_t(q * b + r), a);
+      BOOST_CHECK_EQUAL(uint4096_t(q2 * c + r2), a);
+   }
+   {
+      cpp_int a(generate_random_hex(300 * bits)), b(generate_random_hex(100 * bits));
+      BOOST_CHECK_THROW(cpp_int(a / cpp_int(0)), std::overflow_error);
+      BOOST_CHECK_EQUAL(cpp_int(b / a), 0);
+      BOOST_CHECK_EQUAL(cpp_int(b % a), b);
+      BOOST_CHECK_EQUAL(cpp_int(a / a), 1);
+      BOOST_CHECK_EQUAL(cpp_int(a % a), 0);
+   }
+   return boost::report_errors();
+}
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the results of large GCD's - which go through Lehmer's algorithm
+// and the half-GCD code - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/integer.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x1");
+   for(unsigned i = 1; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+template <class Int>
+void test_values(const mpz_int& a, const mpz_int& b)
+{
+   if(std::numeric_limits<Int>::is_bounded && ((msb(abs(a)) >= static_cast<unsigned>(std::numeric_limits<Int>::digits)) || (msb(abs(b)) >= static_cast<unsigned>(std::numeric_limits<Int>::digits))))
+      return;
+   Int a1(a.str()), b1(b.str());
+   BOOST_CHECK_EQUAL(Int(gcd(a1, b1)).str(), mpz_int(gcd(a, b)).str());
+   BOOST_CHECK_EQUAL(Int(gcd(b1, a1)).str(), mpz_int(gcd(a, b)).str());
+}
+
+template <class Int>
+void test_gcd(unsigned abits, unsigned bbits, unsigned gbits)
+{
+   mpz_int a(generate_random_hex(abits)), b(generate_random_hex(bbits)), g(generate_random_hex(gbits));
+   test_values<Int>(a, b);
+   //
+   // Large common factors, and factors of two which the binary GCD used to strip first:
+   //
+   test_values<Int>(mpz_int(a * g), mpz_int(b * g));
+   test_values<Int>(mpz_int(a * g), g);
+   test_values<Int>(mpz_int(a << 70), mpz_int(b << 3));
+   //
+   // Consecutive Fibonacci numbers, which produce a quotient of 1 at every step:
+   //
+   mpz_int f1(1), f2(1);
+   while(msb(f2) < abits)
+   {
+      mpz_int t = f1 + f2;
+      f1 = f2;
+      f2 = t;
+   }
+   test_values<Int>(f2, f1);
+   test_values<Int>(mpz_int(f2 * g), mpz_int(f1 * g));
+   //
+   // Values where one is a multiple of the other, or very close to one:
+   //
+   test_values<Int>(mpz_int(a * b), b);
+   test_values<Int>(mpz_int(a * b + 1), b);
+}
+
+void test_inverse(unsigned bits)
+{
+   mpz_int m(generate_random_hex(bits)), a(generate_random_hex(bits - 1));
+   if(!(m & 1))
+      ++m;
+   cpp_int m1(m.str());
+   modular_context<cpp_int::backend_type> ctx(m1);
+   mpz_int g = gcd(a, m);
+   cpp_int inv(ctx.inverse(cpp_int(a.str())));
+   if(g != 1)
+   {
+      BOOST_CHECK_EQUAL(inv, 0);
+   }
+   else
+   {
+      BOOST_CHECK(inv > 0);
+      BOOST_CHECK(inv < m1);
+      BOOST_CHECK_EQUAL(cpp_int(inv * cpp_int(a.str()) % m1), 1);
+   }
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   //
+   // Lehmer's algorithm, including sizes where the leading limbs of the two values differ:
+   //
+   for(unsigned al = 2; al < 10; ++al)
+   {
+      for(unsigned bl = 2; bl <= al; ++bl)
+      {
+         test_gcd<cpp_int>(al * bits, bl * bits, bits);
+         test_gcd<cpp_int>(al * bits - 3, bl * bits - 1, 2 * bits + 5);
+      }
+   }
+   boost::random::uniform_int_distribution<unsigned> d(2 * bits, 150 * bits);
+   for(unsigned i = 0; i < 50; ++i)
+   {
+      unsigned x = d(gen), y = d(gen);
+      test_gcd<cpp_int>((std::max)(x, y), (std::min)(x, y), y / 3 + 1);
+   }
+   //
+   // The half-GCD either side of BOOST_MP_HGCD_CUTOFF and well above it:
+   //
+   test_gcd<cpp_int>((BOOST_MP_HGCD_CUTOFF - 1) * bits, (BOOST_MP_HGCD_CUTOFF - 2) * bits, 10);
+   test_gcd<cpp_int>(BOOST_MP_HGCD_CUTOFF * bits, BOOST_MP_HGCD_CUTOFF * bits - 1, 3 * bits);
+   test_gcd<cpp_int>(2 * BOOST_MP_HGCD_CUTOFF * bits + 17, 2 * BOOST_MP_HGCD_CUTOFF * bits - 200, BOOST_MP_HGCD_CUTOFF * bits);
+   test_gcd<cpp_int>(8 * BOOST_MP_HGCD_CUTOFF * bits, 8 * BOOST_MP_HGCD_CUTOFF * bits, 3 * BOOST_MP_HGCD_CUTOFF * bits);
+   test_gcd<cpp_int>(8 * BOOST_MP_HGCD_CUTOFF * bits, 5 * BOOST_MP_HGCD_CUTOFF * bits, 100);
+   //
+   // Signs are ignored:
+   //
+   {
+      mpz_int a(generate_random_hex(300 * bits)), b(generate_random_hex(200 * bits)), g(generate_random_hex(50 * bits));
+      test_values<cpp_int>(mpz_int(-a * g), mpz_int(b * g));
+      test_values<cpp_int>(mpz_int(a * g), mpz_int(-b * g));
+      test_values<cpp_int>(mpz_int(-a * g), mpz_int(-b * g));
+   }
+   //
+   // Fixed precision types:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_gcd<uint1024_t>(500, 400, 100);
+      test_gcd<int1024_t>(500, 500, 20);
+      test_gcd<checked_uint1024_t>(500, 300, 200);
+      test_gcd<uint512_t>(250, 250, 5);
+   }
+   test_gcd<number<cpp_int_backend<65536, 65536, unsigned_magnitude, unchecked, void> > >(20000, 20000, 8000);
+   //
+   // Modular inverses come from the same code:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_inverse(3 * bits);
+      test_inverse(100 * bits);
+      test_inverse(3 * BOOST_MP_HGCD_CUTOFF * bits);
+   }
+   return boost::report_errors();
+}
@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the results of large multiplications - which go through the
+// Karatsuba, Toom-3 and NTT code paths - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <cctype>
+#include <iterator>
+#include <vector>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x");
+   for(unsigned i = 0; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+std::string hex_str(const mpz_int& val)
+{
+   std::string result = val.str(0, std::ios_base::hex);
+   for(std::string::iterator i = result.begin(); i != result.end(); ++i)
+      *i = static_cast<char>(std::toupper(*i));
+   return result;
+}
+//
+// cpp_int's own radix conversion is quadratic, so go via export_bits to keep the
+// larger tests quick:
+//
+template <class T>
+std::string hex_str(const T& val)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   std::vector<unsigned char> v;
+   export_bits(val, std::back_inserter(v), 4);
+   std::string result(val < 0 ? "-" : "");
+   for(std::vector<unsigned char>::const_iterator i = v.begin(); i != v.end(); ++i)
+      result += digits[*i];
+   return result;
+}
+
+template <class Int>
+void test_product(unsigned abits, unsigned bbits, unsigned truncate_bits = 0)
+{
+   std::string as = generate_random_hex(abits);
+   std::string bs = generate_random_hex(bbits);
+   mpz_int a(as), b(bs);
+   Int a1(as), b1(bs);
+
+   mpz_int r = a * b;
+   mpz_int s = a * a;
+   if(truncate_bits)
+   {
+      mpz_int mask = (mpz_int(1) << truncate_bits) - 1;
+      r &= mask;
+      s &= mask;
+   }
+   BOOST_CHECK_EQUAL(hex_str(r), hex_str(Int(a1 * b1)));
+   BOOST_CHECK_EQUAL(hex_str(r), hex_str(Int(b1 * a1)));
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(Int(a1 * a1)));
+   Int t(a1);
+   t *= b1;
+   BOOST_CHECK_EQUAL(hex_str(r), hex_str(t));
+   t = a1;
+   t *= t;
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(t));
+}
+
+template <class Int>
+void test_square(unsigned bits, unsigned truncate_bits = 0)
+{
+   std::string as = generate_random_hex(bits);
+   mpz_int a(as);
+   Int a1(as);
+   mpz_int s = a * a;
+   if(truncate_bits)
+      s &= (mpz_int(1) << truncate_bits) - 1;
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(Int(a1 * a1)));
+   Int t(a1);
+   t *= t;
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(t));
+   t = a1;
+   t = t * t;
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(t));
+   BOOST_CHECK_EQUAL(hex_str(s), hex_str(Int(pow(a1, 2))));
+}
+
+void test_signs(unsigned bits)
+{
+   std::string as = generate_random_hex(bits);
+   std::string bs = generate_random_hex(bits + 100);
+   mpz_int a(as), b(bs);
+   cpp_int a1(as), b1(bs);
+   BOOST_CHECK_EQUAL(mpz_int(-a * b).str(), cpp_int(-a1 * b1).str());
+   BOOST_CHECK_EQUAL(mpz_int(a * -b).str(), cpp_int(a1 * -b1).str());
+   BOOST_CHECK_EQUAL(mpz_int(-a * -b).str(), cpp_int(-a1 * -b1).str());
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   //
+   // Balanced values either side of the Karatsuba and Toom-3 cutoffs:
+   //
+   for(unsigned limbs = BOOST_MP_KARATSUBA_CUTOFF - 2; limbs < BOOST_MP_KARATSUBA_CUTOFF + 5; ++limbs)
+      test_product<cpp_int>(limbs * bits, limbs * bits);
+   for(unsigned limbs = BOOST_MP_TOOM3_CUTOFF - 2; limbs < BOOST_MP_TOOM3_CUTOFF + 5; ++limbs)
+      test_product<cpp_int>(limbs * bits - 3, limbs * bits);
+   //
+   // Squares use their own kernels at every size:
+   //
+   for(unsigned limbs = 1; limbs < BOOST_MP_KARATSUBA_CUTOFF + 5; ++limbs)
+   {
+      test_square<cpp_int>(limbs * bits);
+      test_square<cpp_int>(limbs * bits - 7);
+   }
+   for(unsigned limbs = BOOST_MP_TOOM3_CUTOFF - 2; limbs < BOOST_MP_TOOM3_CUTOFF + 5; ++limbs)
+      test_square<cpp_int>(limbs * bits - 1);
+   test_square<cpp_int>(BOOST_MP_NTT_CUTOFF * bits);
+   {
+      cpp_int a = -((cpp_int(1) << (bits * 50)) - 1);
+      mpz_int a1 = -((mpz_int(1) << (bits * 50)) - 1);
+      BOOST_CHECK_EQUAL(mpz_int(a1 * a1).str(), cpp_int(a * a).str());
+      a = -a;
+      a1 = -a1;
+      BOOST_CHECK_EQUAL(mpz_int(a1 * a1).str(), cpp_int(a * a).str());
+   }
+   //
+   // Random sizes, including badly unbalanced ones, and values with zero limbs
+   // in awkward places:
+   //
+   boost::random::uniform_int_distribution<unsigned> d(BOOST_MP_KARATSUBA_CUTOFF * bits, 6 * BOOST_MP_TOOM3_CUTOFF * bits);
+   for(unsigned i = 0; i < 30; ++i)
+   {
+      unsigned abits = d(gen);
+      test_product<cpp_int>(abits, d(gen));
+      test_product<cpp_int>(abits, abits / 5 + BOOST_MP_KARATSUBA_CUTOFF * bits);
+   }
+   {
+      cpp_int a = (cpp_int(1) << (bits * 1000)) - 1;
+      cpp_int b = (cpp_int(1) << (bits * 700)) + 1;
+      mpz_int a1 = (mpz_int(1) << (bits * 1000)) - 1;
+      mpz_int b1 = (mpz_int(1) << (bits * 700)) + 1;
+      BOOST_CHECK_EQUAL(hex_str(mpz_int(a1 * b1)), hex_str(cpp_int(a * b)));
+      BOOST_CHECK_EQUAL(hex_str(mpz_int(a1 * a1)), hex_str(cpp_int(a * a)));
+      BOOST_CHECK_EQUAL(hex_str(mpz_int(b1 * b1)), hex_str(cpp_int(b * b)));
+   }
+   test_signs(BOOST_MP_TOOM3_CUTOFF * bits * 3);
+   //
+   // Number theoretic transform, balanced, unbalanced and with values whose
+   // convolution coefficients are as large as possible:
+   //
+   test_product<cpp_int>(BOOST_MP_NTT_CUTOFF * bits, BOOST_MP_NTT_CUTOFF * bits);
+   test_product<cpp_int>(BOOST_MP_NTT_CUTOFF * bits * 3 + 17, BOOST_MP_NTT_CUTOFF * bits - 5);
+   {
+      cpp_int a = (cpp_int(1) << (bits * BOOST_MP_NTT_CUTOFF * 2)) - 1;
+      mpz_int a1 = (mpz_int(1) << (bits * BOOST_MP_NTT_CUTOFF * 2)) - 1;
+      BOOST_CHECK_EQUAL(hex_str(mpz_int(a1 * a1)), hex_str(cpp_int(a * a)));
+      BOOST_CHECK_EQUAL(hex_str(mpz_int(a1 * (a1 >> (bits * 7)))), hex_str(cpp_int(a * (a >> (bits * 7)))));
+   }
+   test_signs(BOOST_MP_NTT_CUTOFF * bits);
+   //
+   // cpp_bin_float multiplies its mantissas with the same routines:
+   //
+   {
+      typedef number<cpp_bin_float<BOOST_MP_NTT_CUTOFF * bits * 2 + 64, digit_base_2> > float_type;
+      cpp_int a(generate_random_hex(BOOST_MP_NTT_CUTOFF * bits)), b(generate_random_hex(BOOST_MP_NTT_CUTOFF * bits + 50));
+      float_type fa(a), fb(b);
+      BOOST_CHECK_EQUAL(hex_str(cpp_int(a * b)), hex_str(float_type(fa * fb).convert_to<cpp_int>()));
+   }
+   //
+   // Fixed precision types, where the result is truncated:
+   //
+   typedef number<cpp_int_backend<32768, 32768, unsigned_magnitude, unchecked, void> > uint32768_t;
+   for(unsigned i = 0; i < 10; ++i)
+      test_product<uint32768_t>(20000 + i * 1000, 16000 + i * 1000, 32768);
+   typedef number<cpp_int_backend<512, 512, unsigned_magnitude, unchecked, void> > uint512_t;
+   for(unsigned i = 256; i <= 512; i += 32)
+      test_square<uint512_t>(i, 512);
+   test_square<uint32768_t>(20000, 32768);
+   //
+   // Operands wider than a fixed precision result only contribute their low limbs:
+   //
+   typedef number<cpp_int_backend<4096, 4096, unsigned_magnitude, unchecked, void> > uint4096_t;
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      std::string as = generate_random_hex(6000 + i * 100), bs = generate_random_hex(5000 - i * 100);
+      mpz_int r = (mpz_int(as) * mpz_int(bs)) & ((mpz_int(1) << 4096) - 1);
+      uint4096_t t;
+      eval_multiply(t.backend(), cpp_int(as).backend(), cpp_int(bs).backend());
+      BOOST_CHECK_EQUAL(hex_str(r), hex_str(t));
+   }
+#ifndef BOOST_NO_CXX11_NOEXCEPT
+   //
+   // Fixed precision types above the Karatsuba cutoff keep their scratch space on the stack,
+   // so they can still not throw, while ones too large for that allocate it:
+   //
+   {
+      typedef number<cpp_int_backend<8192, 8192, unsigned_magnitude, unchecked, void> > uint8192_t;
+      typedef number<cpp_int_backend<1u << 20, 1u << 20, unsigned_magnitude, unchecked, void> > uint1M_t;
+      uint4096_t x;
+      uint8192_t y;
+      BOOST_CHECK(noexcept(eval_multiply(x.backend(), x.backend(), x.backend())));
+      BOOST_CHECK(noexcept(eval_square(x.backend(), x.backend())));
+      BOOST_CHECK(noexcept(eval_multiply(y.backend(), y.backend())));
+      BOOST_CHECK(noexcept(eval_square(y.backend(), y.backend())));
+      BOOST_CHECK(!noexcept(eval_multiply(*static_cast<uint1M_t::backend_type*>(0), y.backend(), y.backend())));
+   }
+#endif
+   //
+   // And checked types where it isn't:
+   //
+   typedef number<cpp_int_backend<32768, 32768, signed_magnitude, checked, void> > checked_int32768_t;
+   test_product<checked_int32768_t>(16000, 16000);
+   checked_int32768_t big = checked_int32768_t(1) << 20000;
+   BOOST_CHECK_THROW(big * big, std::overflow_error);
+   typedef number<cpp_int_backend<512, 512, signed_magnitude, checked, void> > checked_int512_t;
+   test_square<checked_int512_t>(256);
+   checked_int512_t small = checked_int512_t(1) << 300;
+   BOOST_CHECK_THROW(small * small, std::overflow_error);
+   BOOST_CHECK_THROW(small *= small, std::overflow_error);
+   return boost::report_errors();
+}
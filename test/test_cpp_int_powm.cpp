@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare powm - which uses Montgomery multiplication for odd moduli and
+// Barrett reduction for even ones - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x");
+   for(unsigned i = 0; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+template <class Int>
+void test_powm(const std::string& base, const std::string& exponent, const std::string& modulus)
+{
+   Int a(base), p(exponent), m(modulus);
+   mpz_int a1(base), p1(exponent), m1(modulus);
+   BOOST_CHECK_EQUAL(Int(powm(a, p, m)).str(), mpz_int(powm(a1, p1, m1)).str());
+}
+
+//
+// GMP's powm always returns a non-negative result, where as ours follows the sign
+// convention of operator %, so check negative values against the generic version:
+//
+template <class Int>
+void test_signed_powm(const std::string& base, const std::string& exponent, const std::string& modulus, bool negate_base, bool negate_modulus)
+{
+   Int a(base), p(exponent), m(modulus), r;
+   if(negate_base)
+      a = -a;
+   if(negate_modulus)
+      m = -m;
+   boost::multiprecision::default_ops::eval_powm(r.backend(), a.backend(), p.backend(), m.backend());
+   BOOST_CHECK_EQUAL(Int(powm(a, p, m)).str(), r.str());
+}
+
+template <class Int>
+void test_random(unsigned base_bits, unsigned exponent_bits, unsigned modulus_bits)
+{
+   std::string m = generate_random_hex(modulus_bits);
+   test_powm<Int>(generate_random_hex(base_bits), generate_random_hex(exponent_bits), m);
+   //
+   // And again with the modulus forced odd and even:
+   //
+   Int mm(m);
+   mm |= 1u;
+   test_powm<Int>(generate_random_hex(base_bits), generate_random_hex(exponent_bits), mm.str());
+   mm ^= 1u;
+   if(mm != 0)
+      test_powm<Int>(generate_random_hex(base_bits), generate_random_hex(exponent_bits), mm.str());
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   for(unsigned limbs = 1; limbs < 40; ++limbs)
+   {
+      test_random<cpp_int>(limbs * bits - 3, 100, limbs * bits);
+      test_random<cpp_int>(limbs * bits * 3, 5, limbs * bits - 5);
+   }
+   boost::random::uniform_int_distribution<unsigned> d(2, 2048);
+   for(unsigned i = 0; i < 50; ++i)
+      test_random<cpp_int>(d(gen), d(gen), d(gen));
+   //
+   // Sliding window edge cases, exponents with long runs of zeros and ones:
+   //
+   std::string m = generate_random_hex(1024);
+   std::string a = generate_random_hex(1000);
+   test_powm<cpp_int>(a, "0x100000000000000000000000000000000000001", m);
+   test_powm<cpp_int>(a, "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", m);
+   test_powm<cpp_int>(a, "0x8000000000000000000000000000000000000000000000000", m);
+   test_powm<cpp_int>(a, "0x80000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001", m);
+   test_powm<cpp_int>(a, "0x80000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001", "0x10000000000000000000000000000000000000000000000000000000000000000");
+   //
+   // Special values:
+   //
+   test_powm<cpp_int>(a, "0", m);
+   test_powm<cpp_int>(a, "1", m);
+   test_powm<cpp_int>(a, "2", m);
+   test_powm<cpp_int>(a, "12345", "1");
+   test_powm<cpp_int>(a, "0", "1");
+   test_powm<cpp_int>(a, "12345", "2");
+   test_powm<cpp_int>("0", "12345", m);
+   test_powm<cpp_int>("0", "0", m);
+   test_powm<cpp_int>(m, "12345", m);
+   //
+   // Signs follow eval_modulus:
+   //
+   test_signed_powm<cpp_int>(a, "12345", m, true, false);
+   test_signed_powm<cpp_int>(a, "12346", m, true, false);
+   test_signed_powm<cpp_int>(a, "12345", m, false, true);
+   test_signed_powm<cpp_int>(a, "12345", m, true, true);
+   test_signed_powm<cpp_int>(m, "12345", m, true, false);
+   {
+      cpp_int b(a), mm(m);
+      BOOST_CHECK_THROW(cpp_int(powm(b, -1, mm)), std::runtime_error);
+      BOOST_CHECK_THROW(cpp_int(powm(b, cpp_int(-1), mm)), std::runtime_error);
+      BOOST_CHECK_THROW(cpp_int(powm(b, 3, cpp_int(0))), std::overflow_error);
+      //
+      // Builtin integer exponents:
+      //
+      mpz_int b1(a), m1(m);
+      BOOST_CHECK_EQUAL(cpp_int(powm(b, 65537u, mm)).str(), mpz_int(powm(b1, 65537u, m1)).str());
+      BOOST_CHECK_EQUAL(cpp_int(powm(b, 65537, mm)).str(), mpz_int(powm(b1, 65537, m1)).str());
+      BOOST_CHECK_EQUAL(cpp_int(powm(b, 0u, mm)).str(), mpz_int(powm(b1, 0u, m1)).str());
+   }
+   //
+   // Fixed precision types, including moduli that use every bit:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_random<uint1024_t>(1024, 1024, 1024);
+      test_random<uint1024_t>(1000, 300, 700);
+      test_random<int1024_t>(1000, 1000, 1000);
+      test_random<checked_uint1024_t>(1024, 1024, 1024);
+      test_random<uint512_t>(512, 17, 512);
+   }
+   test_signed_powm<int1024_t>(a, "12345", m, true, false);
+   return boost::report_errors();
+}
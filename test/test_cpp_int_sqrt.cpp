@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Compare the results of large integer square roots - which go through the
+// recursive "Karatsuba square root" - to GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+std::string generate_random_hex(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x1");
+   for(unsigned i = 1; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return result;
+}
+
+template <class Int>
+void test_value(const mpz_int& x)
+{
+   if(std::numeric_limits<Int>::is_bounded && (msb(x) >= static_cast<unsigned>(std::numeric_limits<Int>::digits)))
+      return;
+   Int x1(x.str()), r1;
+   mpz_int r;
+   Int s1 = sqrt(x1, r1);
+   mpz_int s = sqrt(x, r);
+   BOOST_CHECK_EQUAL(s1.str(), s.str());
+   BOOST_CHECK_EQUAL(r1.str(), r.str());
+   BOOST_CHECK_EQUAL(Int(sqrt(x1)).str(), s.str());
+}
+
+template <class Int>
+void test_sqrt(unsigned bits)
+{
+   mpz_int x(generate_random_hex(bits));
+   test_value<Int>(x);
+   //
+   // Perfect squares and their neighbours, where the correction step matters:
+   //
+   mpz_int s = sqrt(x);
+   test_value<Int>(mpz_int(s * s));
+   test_value<Int>(mpz_int(s * s - 1));
+   test_value<Int>(mpz_int(s * s + 2 * s));
+   test_value<Int>(mpz_int((s + 1) * (s + 1)));
+   //
+   // All ones, and a single bit:
+   //
+   test_value<Int>(mpz_int((mpz_int(1) << bits) - 1));
+   test_value<Int>(mpz_int(mpz_int(1) << bits));
+   test_value<Int>(mpz_int(mpz_int(1) << (bits - 1)));
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+
+   for(unsigned i = 0; i < 1000; ++i)
+      test_value<cpp_int>(mpz_int(i));
+   for(unsigned b = 2; b < 8 * bits; ++b)
+      test_sqrt<cpp_int>(b);
+   boost::random::uniform_int_distribution<unsigned> d(8 * bits, 400 * bits);
+   for(unsigned i = 0; i < 50; ++i)
+      test_sqrt<cpp_int>(d(gen));
+   test_sqrt<cpp_int>(2000 * bits);
+   test_sqrt<cpp_int>(2001 * bits + 7);
+   //
+   // Fixed precision types:
+   //
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      test_sqrt<uint1024_t>(1000);
+      test_sqrt<int1024_t>(700);
+      test_sqrt<checked_uint1024_t>(1024);
+      test_sqrt<uint512_t>(250);
+      test_sqrt<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >(64);
+      test_sqrt<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >(33);
+   }
+   BOOST_CHECK_THROW(sqrt(cpp_int(-4)), std::range_error);
+   //
+   // cpp_bin_float's square root is built on the integer one:
+   //
+   typedef number<cpp_bin_float<3000> > float_type;
+   float_type two(2);
+   float_type root = sqrt(two);
+   BOOST_CHECK_LE(abs(root * root - two), ldexp(float_type(1), 2 - std::numeric_limits<float_type>::digits));
+   return boost::report_errors();
+}
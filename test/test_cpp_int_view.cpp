@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <vector>
+#include <iterator>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+cpp_int generate_random(unsigned bits)
+{
+   boost::random::uniform_int_distribution<limb_type> d;
+   cpp_int result;
+   for(unsigned i = 0; i < bits; i += sizeof(limb_type) * CHAR_BIT)
+   {
+      result <<= sizeof(limb_type) * CHAR_BIT;
+      result |= d(gen);
+   }
+   return result >> (d(gen) % bits);
+}
+
+void test_values(const cpp_int& a, const cpp_int& b)
+{
+   cpp_int_view va(a), vb(b);
+   BOOST_CHECK_EQUAL(hash_value(va), hash_value(a));
+   BOOST_CHECK_EQUAL(hash_value(vb), hash_value(b));
+   BOOST_CHECK_EQUAL(va.compare(vb), a.compare(b));
+   BOOST_CHECK_EQUAL(vb.compare(va), b.compare(a));
+   BOOST_CHECK_EQUAL(va == vb, a == b);
+   BOOST_CHECK_EQUAL(va != vb, a != b);
+   BOOST_CHECK_EQUAL(va < vb, a < b);
+   BOOST_CHECK_EQUAL(va > vb, a > b);
+   BOOST_CHECK_EQUAL(va <= vb, a <= b);
+   BOOST_CHECK_EQUAL(va >= vb, a >= b);
+   BOOST_CHECK(va == a);
+   BOOST_CHECK(b == vb);
+   BOOST_CHECK_EQUAL(va.is_zero(), a == 0);
+   //
+   // Adopt a copy of the limbs with some leading zeros, as from an externally owned buffer:
+   //
+   std::vector<limb_type> buffer(va.begin(), va.end());
+   buffer.resize(buffer.size() + 3);
+   cpp_int_view adopted(&buffer[0], buffer.size(), a < 0);
+   BOOST_CHECK_EQUAL(adopted.size(), va.size());
+   BOOST_CHECK(adopted == a);
+   BOOST_CHECK_EQUAL(hash_value(adopted), hash_value(a));
+   cpp_int c(17);
+   import_bits(c, adopted);
+   BOOST_CHECK_EQUAL(c, a);
+   c = -3;
+   import_bits(c, cpp_int_view(&buffer[0], buffer.size()));
+   BOOST_CHECK_EQUAL(c, abs(a));
+   int1024_t d;
+   import_bits(d, adopted);
+   if(msb(abs(a) + 1) < 1024)
+   {
+      BOOST_CHECK_EQUAL(d.str(), a.str());
+   }
+   import_bits(c, cpp_int_view(c));
+   BOOST_CHECK_EQUAL(c, abs(a));
+   //
+   // export_bits from the view matches export_bits of the value:
+   //
+   for(unsigned chunk = 8; chunk <= 32; chunk *= 2)
+   {
+      std::vector<boost::uint32_t> v1, v2;
+      export_bits(a, std::back_inserter(v1), chunk);
+      export_bits(va, std::back_inserter(v2), chunk);
+      BOOST_CHECK(v1 == v2);
+      v1.clear();
+      v2.clear();
+      export_bits(a, std::back_inserter(v1), chunk, false);
+      export_bits(va, std::back_inserter(v2), chunk, false);
+      BOOST_CHECK(v1 == v2);
+   }
+}
+
+int main()
+{
+   static const unsigned bits = sizeof(limb_type) * CHAR_BIT;
+   test_values(cpp_int(0), cpp_int(1));
+   test_values(cpp_int(1), cpp_int(-1));
+   test_values(cpp_int(-2), cpp_int(-1));
+   for(unsigned i = 0; i < 200; ++i)
+   {
+      cpp_int a = generate_random(3 + i * 7), b = generate_random(3 + (i % 20) * 7);
+      test_values(a, b);
+      test_values(-a, b);
+      test_values(a, a + 1);
+      test_values(-a - 1, -b - 1);
+      test_values(a, cpp_int(a));
+   }
+   //
+   // Zero:
+   //
+   cpp_int_view zero;
+   BOOST_CHECK(zero.is_zero());
+   BOOST_CHECK(zero == cpp_int(0));
+   BOOST_CHECK(cpp_int_view(static_cast<const limb_type*>(0), 0, true) == zero);
+   limb_type zeros[3] = { 0, 0, 0 };
+   BOOST_CHECK(cpp_int_view(zeros, 3, true) == zero);
+   BOOST_CHECK_EQUAL(hash_value(cpp_int_view(zeros, 3, true)), hash_value(cpp_int(0)));
+   BOOST_CHECK(!cpp_int_view(zeros, 3).sign());
+   //
+   // Fixed precision and unsigned types:
+   //
+   uint512_t u = (uint512_t(1) << 500) - 1;
+   cpp_int_view vu(u);
+   BOOST_CHECK_EQUAL(vu.size(), 500 / bits + 1);
+   BOOST_CHECK(vu == cpp_int((cpp_int(1) << 500) - 1));
+   BOOST_CHECK_EQUAL(hash_value(vu), hash_value(cpp_int((cpp_int(1) << 500) - 1)));
+   uint256_t t;
+   import_bits(t, vu);
+   BOOST_CHECK_EQUAL(t, (uint256_t(0) - 1));
+   cpp_int small_neg(-5);
+   uint256_t ut;
+   import_bits(ut, cpp_int_view(small_neg));
+   BOOST_CHECK_EQUAL(ut, uint256_t(0) - 5);
+   checked_uint256_t ct;
+   BOOST_CHECK_THROW(import_bits(ct, vu), std::overflow_error);
+   BOOST_CHECK_THROW(import_bits(ct, cpp_int_view(small_neg)), std::range_error);
+   //
+   // Trivial types are imported too:
+   //
+   limb_type one_limb = 12345;
+   int128_t i128(-7);
+   import_bits(i128, cpp_int_view(&one_limb, 1, true));
+   BOOST_CHECK_EQUAL(i128, -12345);
+   uint128_t u128;
+   import_bits(u128, cpp_int_view(cpp_int(cpp_int(1) << 100)));
+   BOOST_CHECK_EQUAL(u128, uint128_t(1) << 100);
+
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+   cpp_int big = generate_random(1000);
+   BOOST_CHECK_EQUAL(std::hash<cpp_int_view>()(cpp_int_view(big)), std::hash<cpp_int>()(big));
+#endif
+#ifdef BOOST_MP_HAS_STD_SPAN
+   std::span<const limb_type> s = cpp_int_view(big).span();
+   BOOST_CHECK_EQUAL(s.size(), big.backend().size());
+   BOOST_CHECK(cpp_int_view(s) == big);
+   BOOST_CHECK(cpp_int_view(s, true) == cpp_int(-big));
+#endif
+   return boost::report_errors();
+}
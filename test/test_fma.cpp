@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Check that fma, and the expressions a * b + c, c += a * b etc, round only once with cpp_bin_float and
+// truncate only once with cpp_dec_float.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include "test.hpp"
+#include <cmath>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+//
+// Every form of fused multiply-add against the reference value for each of a * b + c, a * b - c and
+// c - a * b:
+//
+template <class Float>
+void check_forms(const Float& a, const Float& b, const Float& c, const Float& sum, const Float& difference, const Float& residual)
+{
+   BOOST_CHECK_EQUAL(Float(fma(a, b, c)), sum);
+   BOOST_CHECK_EQUAL(Float(a * b + c), sum);
+   BOOST_CHECK_EQUAL(Float(c + a * b), sum);
+   BOOST_CHECK_EQUAL(Float(a * b - c), difference);
+   BOOST_CHECK_EQUAL(Float(c - a * b), residual);
+   Float r(c);
+   r += a * b;
+   BOOST_CHECK_EQUAL(r, sum);
+   r = c;
+   r -= a * b;
+   BOOST_CHECK_EQUAL(r, residual);
+   // Aliased arguments:
+   r = a;
+   r = r * b + c;
+   BOOST_CHECK_EQUAL(r, sum);
+   r = b;
+   r = a * r - c;
+   BOOST_CHECK_EQUAL(r, difference);
+}
+
+//
+// The same format as double, including products which cancel exactly and addends far below the product,
+// against a reference wide enough to hold the exact result of each:
+//
+void test_double()
+{
+   typedef number<cpp_bin_float_double::backend_type, et_on> Float;
+   typedef number<cpp_bin_float<400, digit_base_2>, et_on>     Wide;
+   boost::random::uniform_real_distribution<double> d(-1, 1);
+   boost::random::uniform_int_distribution<int>     e(-60, 60);
+   for(unsigned i = 0; i < 20000; ++i)
+   {
+      double a = std::ldexp(d(gen), e(gen));
+      double b = std::ldexp(d(gen), e(gen));
+      double c;
+      switch(i % 4)
+      {
+      case 0:
+         c = std::ldexp(d(gen), e(gen));
+         break;
+      case 1:
+         // Exact cancellation of the rounded product:
+         c = -a * b;
+         break;
+      case 2:
+         c = -a * b * (1 + std::ldexp(d(gen), -30));
+         break;
+      default:
+         // Far below the product:
+         c = std::ldexp(d(gen), e(gen) - 120);
+         break;
+      }
+      Wide exact = Wide(a) * Wide(b);
+      check_forms(Float(a), Float(b), Float(c), Float(Wide(exact + c)), Float(Wide(exact - c)), Float(Wide(c - exact)));
+   }
+   // Special values:
+   Float one(1), inf = std::numeric_limits<Float>::infinity();
+   BOOST_CHECK_EQUAL(Float(fma(one, one, Float(0))), 1);
+   BOOST_CHECK_EQUAL(Float(fma(Float(0), one, one)), 1);
+   BOOST_CHECK_EQUAL(Float(fma(inf, one, one)), inf);
+   BOOST_CHECK((boost::math::isnan)(Float(fma(inf, one, Float(-inf)))));
+   BOOST_CHECK((boost::math::isnan)(Float(fma(inf, Float(0), one))));
+   BOOST_CHECK_EQUAL(Float(fma(Float((std::numeric_limits<Float>::max)()), Float(2), Float(-(std::numeric_limits<Float>::max)()))), (std::numeric_limits<Float>::max)());
+}
+
+//
+// Wider types, where the reference is computed exactly at four times the precision, the product needs two
+// and the remainder covers the difference in exponents:
+//
+template <class Float, class Wide>
+void test_bin()
+{
+   const int bits = std::numeric_limits<Float>::digits;
+   boost::random::uniform_int_distribution<int> e(-bits / 2, bits / 2);
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      Float a = ldexp(Float(boost::random::uniform_real_distribution<double>(-1, 1)(gen)) / 3, e(gen));
+      Float b = ldexp(Float(boost::random::uniform_real_distribution<double>(-1, 1)(gen)) / 7, e(gen));
+      Float c = ldexp(Float(boost::random::uniform_real_distribution<double>(-1, 1)(gen)) / 11, e(gen));
+      if(i % 2)
+         c = -Float(a * b) + ldexp(c, -bits);
+      Wide exact = Wide(a) * Wide(b);
+      check_forms(a, b, c, Float(Wide(exact + Wide(c))), Float(Wide(exact - Wide(c))), Float(Wide(Wide(c) - exact)));
+   }
+}
+
+template <class Float>
+cpp_int to_integer(const Float& x)
+{
+   std::string s = x.str(0, std::ios_base::fixed);
+   return cpp_int(s.substr(0, s.find('.')));
+}
+
+std::string generate_digits(unsigned n)
+{
+   boost::random::uniform_int_distribution<int> d(0, 9);
+   std::string result(n, '0');
+   result[0] = static_cast<char>('1' + d(gen) % 9);
+   for(unsigned i = 1; i < n; ++i)
+      result[i] = static_cast<char>('0' + d(gen));
+   return result;
+}
+
+//
+// cpp_dec_float truncates, so compare integer values with cpp_int: where c cancels the truncated product
+// the remainder is exact, otherwise the error is less than one part in 10^digits10:
+//
+template <class Float>
+void test_dec()
+{
+   const unsigned digits = std::numeric_limits<Float>::digits10;
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      std::string sa = generate_digits(digits), sb = generate_digits(digits - i);
+      Float a(sa), b(sb);
+      cpp_int ia(sa), ib(sb), exact = ia * ib;
+
+      // The truncated product cancels all but the low half of the exact one:
+      Float c = Float(a * b);
+      cpp_int ic = to_integer(c);
+      BOOST_CHECK(to_integer(Float(a * b - c)) == exact - ic);
+      BOOST_CHECK(to_integer(Float(c - a * b)) == ic - exact);
+      BOOST_CHECK(to_integer(Float(fma(a, b, Float(-c)))) == exact - ic);
+      BOOST_CHECK(to_integer(Float(a * b + Float(-c))) == exact - ic);
+      Float r(c);
+      r -= a * b;
+      BOOST_CHECK(to_integer(r) == ic - exact);
+      r = -c;
+      r += a * b;
+      BOOST_CHECK(to_integer(r) == exact - ic);
+      r = a;
+      r = r * b - c;
+      BOOST_CHECK(to_integer(r) == exact - ic);
+
+      std::string sc = generate_digits(digits + 5 * i);
+      c = Float(sc);
+      ic = cpp_int(sc);
+      cpp_int err = exact + ic - to_integer(Float(fma(a, b, c)));
+      BOOST_CHECK(abs(err) * pow(cpp_int(10), digits) < exact + ic);
+      err = exact - ic - to_integer(Float(a * b - c));
+      BOOST_CHECK(abs(err) * pow(cpp_int(10), digits) < abs(exact - ic));
+   }
+   Float one(1), inf = std::numeric_limits<Float>::infinity();
+   BOOST_CHECK_EQUAL(Float(fma(one, one, Float(0))), 1);
+   BOOST_CHECK_EQUAL(Float(fma(Float(0), one, one)), 1);
+   BOOST_CHECK_EQUAL(Float(fma(inf, one, one)), inf);
+   BOOST_CHECK((boost::math::isnan)(Float(fma(inf, one, Float(-inf)))));
+   // The residual of a truncated quotient is only visible with the fused form:
+   Float third = one / 3;
+   BOOST_CHECK(Float(fma(third, Float(3), Float(-1))) != 0);
+   BOOST_CHECK(abs(Float(fma(third, Float(3), Float(-1)))) <= abs(Float(third * 3 - 1)));
+}
+
+int main()
+{
+   test_double();
+   test_bin<number<cpp_bin_float<50>, et_on>, number<cpp_bin_float<200>, et_on> >();
+   test_bin<number<cpp_bin_float<113, digit_base_2>, et_on>, number<cpp_bin_float<452, digit_base_2>, et_on> >();
+   test_bin<number<cpp_bin_float<500, digit_base_10, std::allocator<void> >, et_on>, number<cpp_bin_float<2000, digit_base_10, std::allocator<void> >, et_on> >();
+   test_dec<number<cpp_dec_float<50>, et_on> >();
+   test_dec<number<cpp_dec_float<1000>, et_on> >();
+   test_dec<number<cpp_dec_float<5000, boost::int32_t, std::allocator<void> >, et_on> >();
+   return boost::report_errors();
+}
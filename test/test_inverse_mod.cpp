@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/integer.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#ifdef TEST_GMP
+#include <boost/multiprecision/gmp.hpp>
+#endif
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+template <class T>
+T generate_random(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x");
+   for(unsigned i = 0; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return T(result);
+}
+
+template <class T>
+T positive_mod(const T& a, const T& m)
+{
+   T r(a % m);
+   if(r < 0)
+      r += m;
+   return r;
+}
+
+template <class T>
+void check_gcdext(const T& a, const T& b)
+{
+   T s, t;
+   T g = gcdext(a, b, s, t);
+   BOOST_CHECK_EQUAL(g, T(gcd(a, b)));
+   BOOST_CHECK_EQUAL(T(s * a + t * b), g);
+}
+
+template <class T>
+void check_inverse(const T& a, const T& m)
+{
+   T inv = inverse_mod(a, m);
+   if((gcd(a, m) != 1) || (m == 1))
+   {
+      BOOST_CHECK_EQUAL(inv, 0);
+   }
+   else
+   {
+      BOOST_CHECK(inv > 0);
+      BOOST_CHECK(inv < m);
+      BOOST_CHECK_EQUAL(positive_mod(T(inv * a), m), 1);
+   }
+}
+
+template <class T>
+void test_signed(unsigned bits)
+{
+   for(unsigned i = 0; i < 20; ++i)
+   {
+      T a = generate_random<T>(bits), b = generate_random<T>(bits / 2 + 1), g = generate_random<T>(bits / 3 + 1);
+      check_gcdext(a, b);
+      check_gcdext(b, a);
+      check_gcdext(T(-a), b);
+      check_gcdext(a, T(-b));
+      check_gcdext(T(a * g), T(b * g));
+      check_gcdext(a, T(0));
+      check_gcdext(T(0), b);
+      check_inverse(T(-a), b);
+      check_inverse(T(-a * g), T(b * g));
+   }
+   check_gcdext(T(0), T(0));
+   BOOST_CHECK_THROW(inverse_mod(T(3), T(-7)), std::domain_error);
+}
+
+template <class T>
+void test_inverse(unsigned bits)
+{
+   for(unsigned i = 0; i < 20; ++i)
+   {
+      T a = generate_random<T>(bits), m = generate_random<T>(bits), g = generate_random<T>(bits / 3 + 1);
+      check_inverse(a, m);
+      check_inverse(a, T(m | 1));
+      check_inverse(T(a * g), T(m * g));
+      check_inverse(a, T(1));
+      //
+      // Single limb and power of 2 moduli have their own code:
+      //
+      check_inverse(a, T(integer_modulus(m, 1000000u) + 1));
+      check_inverse(a, T(T(1) << (bits / 2)));
+      check_inverse(T(a | 1), T(T(1) << (bits / 2)));
+      check_inverse(T(a | 1), T(T(1) << (bits / 3 + 1)));
+      check_inverse(T(a | 1), T(T(1) << 3));
+   }
+   BOOST_CHECK_THROW(inverse_mod(T(3), T(0)), std::domain_error);
+}
+
+int main()
+{
+   test_signed<cpp_int>(100);
+   test_signed<cpp_int>(1000);
+   test_signed<cpp_int>(20000);
+   test_signed<int1024_t>(500);
+   test_signed<checked_int1024_t>(500);
+
+   test_inverse<cpp_int>(100);
+   test_inverse<cpp_int>(1000);
+   test_inverse<cpp_int>(20000);
+   test_inverse<int1024_t>(500);
+   test_inverse<uint1024_t>(500);
+   test_inverse<checked_uint1024_t>(500);
+   test_inverse<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >(18);
+#ifdef TEST_GMP
+   test_signed<mpz_int>(1000);
+   test_inverse<mpz_int>(1000);
+#endif
+   return boost::report_errors();
+}
@@ -15,6 +15,32 @@
 #include <iomanip>
 #include "test.hpp"
 
+#if defined(BOOST_MP_HAS_CONCURRENT_MILLER_RABIN) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#define TEST_CONCURRENT
+//
+// Runs each task on a thread of its own, all of which are joined at the end:
+//
+struct thread_pool
+{
+   std::vector<std::thread> threads;
+   ~thread_pool()
+   {
+      for(unsigned i = 0; i < threads.size(); ++i)
+         threads[i].join();
+   }
+};
+struct pool_executor
+{
+   thread_pool* pool;
+   template <class F>
+   void operator()(const F& f)const
+   {
+      pool->threads.push_back(std::thread(f));
+   }
+};
+#endif
+
 
 template <class I>
 void test()
@@ -51,7 +77,24 @@ void test()
    {
       BOOST_TEST(miller_rabin_test(test_type(boost::math::prime(i)), 25, gen));
       BOOST_TEST(mpz_probab_prime_p(mpz_int(boost::math::prime(i)).backend().data(), 25));
+      BOOST_TEST(baillie_psw_test(test_type(boost::math::prime(i))));
    }
+   //
+   // Squares of the base 2 Wieferich primes are strong pseudoprimes to base 2, and
+   // have no small factors:
+   //
+   BOOST_TEST(!baillie_psw_test(test_type(1093u * 1093u)));
+   BOOST_TEST(!baillie_psw_test(test_type(3511u * 3511u)));
+#ifdef TEST_CONCURRENT
+   thread_pool pool;
+   pool_executor exec = { &pool };
+   for(unsigned i = 1; i < boost::math::max_prime; i += 100)
+   {
+      BOOST_TEST(miller_rabin_test(test_type(boost::math::prime(i)), 25, gen2, exec));
+      if(!std::numeric_limits<test_type>::is_bounded || (std::numeric_limits<test_type>::digits > 40))
+         BOOST_TEST(!miller_rabin_test(test_type(test_type(boost::math::prime(i)) * boost::math::prime(i + 1)), 25, gen2, exec));
+   }
+#endif
    //
    // Now test some random values and compare GMP's native routine with ours.
    //
@@ -67,6 +110,11 @@ void test()
       if(is_prime_boost != is_gmp_prime)
          std::cout << std::hex << std::showbase << "n = " << n << std::endl;
       BOOST_CHECK_EQUAL(is_prime_boost, is_gmp_prime);
+      BOOST_CHECK_EQUAL(baillie_psw_test(n), is_gmp_prime);
+#ifdef TEST_CONCURRENT
+      if(i % 10 == 0)
+         BOOST_CHECK_EQUAL(miller_rabin_test(n, 25, gen2, exec), is_gmp_prime);
+#endif
    }
 }
 
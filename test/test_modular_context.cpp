@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/integer.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#ifdef TEST_GMP
+#include <boost/multiprecision/gmp.hpp>
+#endif
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+template <class T>
+T generate_random(unsigned bits)
+{
+   static const char digits[] = "0123456789ABCDEF";
+   boost::random::uniform_int_distribution<unsigned> d(0, 15);
+   std::string result("0x");
+   for(unsigned i = 0; i < (bits + 3) / 4; ++i)
+      result += digits[d(gen)];
+   return T(result);
+}
+
+template <class T>
+T positive_mod(const T& a, const T& m)
+{
+   T r(a % m);
+   if(r < 0)
+      r += m;
+   return r;
+}
+
+//
+// The expected values are computed with cpp_int so that fixed precision
+// types don't overflow:
+//
+template <class T>
+cpp_int to_cpp_int(const T& val)
+{
+   return cpp_int(val.str());
+}
+
+template <class T>
+void test_values(modular_context<typename T::backend_type>& ctx, const T& a, const T& b)
+{
+   cpp_int m(to_cpp_int(ctx.modulus()));
+   cpp_int x(positive_mod(to_cpp_int(a), m)), y(positive_mod(to_cpp_int(b), m));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.reduce(a)), x);
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.mulmod(a, b)), cpp_int(x * y % m));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.mulmod(a, a)), cpp_int(x * x % m));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.addmod(a, b)), cpp_int((x + y) % m));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.submod(a, b)), cpp_int(x >= y ? cpp_int(x - y) : cpp_int(m - (y - x))));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.powm(a, ctx.reduce(b))), cpp_int(powm(x, y, m)));
+   BOOST_CHECK_EQUAL(to_cpp_int(ctx.powm(a, 0)), cpp_int(1 % m));
+   cpp_int inv = to_cpp_int(ctx.inverse(a));
+   if(inv != 0)
+   {
+      BOOST_CHECK_EQUAL(cpp_int(inv * x % m), cpp_int(1));
+   }
+   else
+   {
+      BOOST_CHECK((gcd(x, m) != 1) || (m == 1));
+   }
+}
+
+template <class T>
+void test_modulus(const T& m, unsigned bits)
+{
+   modular_context<typename T::backend_type> ctx(m);
+   BOOST_CHECK_EQUAL(ctx.modulus(), m);
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      T a = generate_random<T>(bits);
+      T b = generate_random<T>(bits);
+      test_values(ctx, T(a % m), T(b % m));
+      test_values(ctx, a, b);
+   }
+   test_values(ctx, T(0), T(0));
+   test_values(ctx, T(m - 1), T(m - 1));
+   test_values(ctx, m, T(m - 1));
+}
+
+template <class T>
+void test_signed(const T& m)
+{
+   modular_context<typename T::backend_type> ctx(m);
+   T a = generate_random<T>(300);
+   test_values(ctx, T(-a), a);
+   test_values(ctx, a, T(-a));
+   test_values(ctx, T(-m), T(-a));
+   BOOST_CHECK_THROW(ctx.powm(a, -1), std::runtime_error);
+   BOOST_CHECK_THROW(modular_context<typename T::backend_type>(T(-m)), std::domain_error);
+}
+
+template <class T>
+void test()
+{
+   static const unsigned max_bits = std::numeric_limits<T>::is_bounded ? std::numeric_limits<T>::digits : 2048;
+   for(unsigned bits = 2; bits <= max_bits; bits += bits < 200 ? 7 : 160)
+   {
+      T m = generate_random<T>(bits);
+      if(m < 2)
+         m = 2;
+      test_modulus(m, max_bits);
+      m |= 1;
+      test_modulus(m, max_bits);
+      m ^= 1;
+      test_modulus(m, max_bits);
+   }
+   test_modulus(T(1), 100);
+   test_modulus(T(2), 100);
+   test_modulus(T(3), 100);
+   //
+   // A prime, so every non-zero value has an inverse:
+   //
+   test_modulus(T("340282366920938463463374607431768211297"), 120);
+   BOOST_CHECK_THROW(modular_context<typename T::backend_type>(T(0)), std::domain_error);
+}
+
+int main()
+{
+   test<cpp_int>();
+   test<uint1024_t>();
+   test<checked_uint512_t>();
+   test<int512_t>();
+   //
+   // Types small enough to be held in a single built in integer:
+   //
+   test<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >();
+   test<uint128_t>();
+   test<int128_t>();
+   test_signed(generate_random<cpp_int>(257));
+   test_signed(cpp_int(generate_random<cpp_int>(256) << 1));
+   test_signed(generate_random<int512_t>(255));
+#ifdef TEST_GMP
+   test<mpz_int>();
+   test_signed(generate_random<mpz_int>(257));
+#endif
+   return boost::report_errors();
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+//
+// Check the sieved candidates from prime_candidate_stream, and compare
+// next_probable_prime with GMP's mpz_nextprime.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/miller_rabin.hpp>
+#include <boost/math/special_functions/prime.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+template <class I>
+bool has_small_factor(const I& n, unsigned sieve_primes)
+{
+   for(unsigned i = 1; i <= sieve_primes; ++i)
+   {
+      boost::uint32_t p = boost::math::prime(i);
+      if((n != p) && (integer_modulus(n, p) == 0))
+         return true;
+   }
+   return false;
+}
+
+template <class I>
+void test_stream(const I& start, unsigned window, unsigned sieve_primes, unsigned count)
+{
+   prime_candidate_stream<I> candidates(start, window, sieve_primes);
+   I expected(start <= 3 ? I(3) : I(start | 1));
+   for(unsigned i = 0; i < count; ++i)
+   {
+      while(has_small_factor(expected, sieve_primes))
+         expected += 2;
+      I c = candidates.next();
+      BOOST_CHECK_EQUAL(c, expected);
+      expected += 2;
+   }
+}
+
+template <class I>
+void test_next_prime(const I& n)
+{
+   mpz_int p;
+   mpz_int n1(n);
+   mpz_nextprime(p.backend().data(), n1.backend().data());
+   BOOST_CHECK_EQUAL(mpz_int(next_probable_prime(n, 25)), p);
+}
+
+template <class I>
+void test()
+{
+   //
+   // Small values, where the sieving primes are candidates too:
+   //
+   test_stream<I>(I(0), 16, 10, 200);
+   test_stream<I>(I(2), 5, 3, 200);
+   test_stream<I>(I(28), 1000, 2000, 500);
+   for(unsigned i = 0; i < 3000; i += 7)
+      test_next_prime(I(i));
+   test_next_prime(I(113));
+   test_next_prime(I(227));
+   test_next_prime(I(229));
+   test_next_prime(I(17389));
+   //
+   // Larger values, crossing several windows:
+   //
+   I big(0x1234567u);
+   big <<= 30;
+   test_stream<I>(big, 100, 500, 2000);
+   test_stream<I>(I(big + 1), 4096, 9999, 100);
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      test_next_prime(big);
+      big = next_probable_prime(big, 25);
+   }
+}
+
+int main()
+{
+   test<boost::uint64_t>();
+   test<cpp_int>();
+   test<uint1024_t>();
+   test<number<cpp_int_backend<64, 64, unsigned_magnitude, checked, void>, et_off> >();
+   test<mpz_int>();
+
+   cpp_int n(1);
+   n <<= 1000;
+   for(unsigned i = 0; i < 5; ++i)
+   {
+      test_next_prime(n);
+      n = next_probable_prime(n, 25) + 1000;
+   }
+   return boost::report_errors();
+}
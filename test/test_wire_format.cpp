@@ -0,0 +1,266 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/wire_format.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <sstream>
+#include <vector>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+cpp_int generate_random(unsigned bits)
+{
+   boost::random::uniform_int_distribution<limb_type> d;
+   cpp_int result;
+   for(unsigned i = 0; i < bits; i += sizeof(limb_type) * CHAR_BIT)
+   {
+      result <<= sizeof(limb_type) * CHAR_BIT;
+      result |= d(gen);
+   }
+   return result >> (d(gen) % bits);
+}
+
+template <class Number>
+std::string write_all(const std::vector<Number>& values, std::size_t buffer_bytes = 65536)
+{
+   std::ostringstream os;
+   wire_writer<Number> w(os, buffer_bytes);
+   w.write(values.begin(), values.end());
+   w.flush();
+   return os.str();
+}
+
+//
+// Reads the data from a buffer offset by a few bytes, so that the fast and the unaligned paths are both used:
+//
+template <class Number>
+std::vector<Number> read_all(const std::string& data, unsigned offset)
+{
+   std::vector<boost::uint64_t> storage(data.size() / 8 + 2);
+   char* p = reinterpret_cast<char*>(&storage[0]) + offset;
+   std::copy(data.begin(), data.end(), p);
+   wire_reader<Number> r(p, data.size());
+   std::vector<Number> result;
+   Number val;
+   while(r.read(val))
+      result.push_back(val);
+   BOOST_CHECK(r.at_end());
+   return result;
+}
+
+template <class Number>
+void check_equal(const Number& a, const Number& b, const boost::mpl::true_&)
+{
+   BOOST_CHECK_EQUAL(a, b);
+}
+template <class Number>
+void check_equal(const Number& a, const Number& b, const boost::mpl::false_&)
+{
+   if((boost::math::isnan)(b))
+   {
+      BOOST_CHECK((boost::math::isnan)(a));
+   }
+   else
+   {
+      BOOST_CHECK_EQUAL(a, b);
+      BOOST_CHECK_EQUAL((boost::math::signbit)(a), (boost::math::signbit)(b));
+   }
+}
+
+template <class Number>
+void test_round_trip(const std::vector<Number>& values)
+{
+   for(unsigned offset = 0; offset < 8; offset += 3)
+   {
+      std::string data = write_all(values, offset ? 64 : 65536);
+      BOOST_CHECK_EQUAL(data.size() % 8, 0u);
+      std::vector<Number> result = read_all<Number>(data, offset);
+      BOOST_CHECK_EQUAL(result.size(), values.size());
+      for(unsigned i = 0; (i < values.size()) && (i < result.size()); ++i)
+         check_equal(result[i], values[i], boost::mpl::bool_<std::numeric_limits<Number>::is_integer>());
+   }
+}
+
+template <class Int>
+void test_integers()
+{
+   std::vector<Int> values;
+   values.push_back(Int(0));
+   values.push_back(Int(1));
+   values.push_back(Int(~static_cast<limb_type>(0)));
+   if(std::numeric_limits<Int>::is_signed)
+      values.push_back(Int(cpp_int(-2)));
+   unsigned max_bits = std::numeric_limits<Int>::is_bounded ? std::numeric_limits<Int>::digits : 3000;
+   for(unsigned i = 0; i < 300; ++i)
+   {
+      cpp_int v = generate_random(1 + i * 13 % max_bits);
+      values.push_back(Int(v));
+      if(std::numeric_limits<Int>::is_signed)
+         values.push_back(Int(cpp_int(-v)));
+   }
+   test_round_trip(values);
+   //
+   // The same data through the block read and the zero copy views:
+   //
+   std::string data = write_all(values);
+   std::vector<boost::uint64_t> storage(data.size() / 8);
+   std::memcpy(&storage[0], data.data(), data.size());
+   wire_reader<Int> r(&storage[0], data.size());
+   std::vector<Int> block(values.size() + 5);
+   BOOST_CHECK_EQUAL(r.read(&block[0], 10), 10u);
+   BOOST_CHECK_EQUAL(r.read(&block[10], block.size() - 10), values.size() - 10);
+   BOOST_CHECK(std::equal(values.begin(), values.end(), block.begin()));
+   wire_reader<cpp_int> rv(&storage[0], data.size());
+   cpp_int_view view;
+   for(unsigned i = 0; i < values.size(); ++i)
+   {
+      BOOST_CHECK(rv.read(view));
+      BOOST_CHECK(view == cpp_int(values[i]));
+#if BOOST_ENDIAN_LITTLE_BYTE
+      if(!view.is_zero())
+      {
+         BOOST_CHECK(reinterpret_cast<const char*>(view.limbs()) > reinterpret_cast<const char*>(&storage[0]));
+         BOOST_CHECK(reinterpret_cast<const char*>(view.limbs()) < reinterpret_cast<const char*>(&storage[0]) + data.size());
+      }
+#endif
+   }
+   BOOST_CHECK(!rv.read(view));
+}
+
+template <class Float>
+void test_floats()
+{
+   std::vector<Float> values;
+   values.push_back(Float(0));
+   values.push_back(-Float(0));
+   values.push_back(Float(1));
+   values.push_back(Float(-0.5));
+   values.push_back(std::numeric_limits<Float>::infinity());
+   values.push_back(-std::numeric_limits<Float>::infinity());
+   values.push_back(std::numeric_limits<Float>::quiet_NaN());
+   values.push_back((std::numeric_limits<Float>::max)());
+   values.push_back((std::numeric_limits<Float>::min)());
+   values.push_back(-(std::numeric_limits<Float>::max)());
+   values.push_back(std::numeric_limits<Float>::epsilon());
+   Float x = 1;
+   for(unsigned i = 0; i < 200; ++i)
+   {
+      x *= Float(-3) / 7;
+      values.push_back(x);
+      values.push_back(Float(generate_random(200)));
+      values.push_back(ldexp(Float(generate_random(30)), static_cast<int>(i * 17) - 1000));
+   }
+   test_round_trip(values);
+}
+
+int main()
+{
+   test_integers<cpp_int>();
+   test_integers<int1024_t>();
+   test_integers<uint512_t>();
+   test_integers<checked_int256_t>();
+   test_integers<int128_t>();
+   test_integers<uint128_t>();
+   test_integers<number<cpp_int_backend<24, 24, unsigned_magnitude, unchecked, void> > >();
+   test_floats<cpp_bin_float_50>();
+   test_floats<cpp_bin_float_100>();
+   test_floats<cpp_bin_float_quad>();
+   test_floats<number<cpp_bin_float<200, digit_base_10, std::allocator<void> > > >();
+   test_floats<number<cpp_bin_float<0> > >();
+   //
+   // Values written at one precision may be read at another:
+   //
+   std::vector<cpp_int> big;
+   big.push_back(cpp_int(1) << 300);
+   big.push_back(cpp_int(12345));
+   std::string data = write_all(big);
+   std::vector<int1024_t> as_fixed = read_all<int1024_t>(data, 0);
+   BOOST_CHECK_EQUAL(as_fixed.size(), 2u);
+   BOOST_CHECK_EQUAL(as_fixed[0], int1024_t(1) << 300);
+   BOOST_CHECK_THROW(read_all<checked_int256_t>(data, 0), std::overflow_error);
+   wire_reader<cpp_int> r(data.data(), data.size());
+   BOOST_CHECK_EQUAL(r.precision(), 0u);
+
+   std::vector<cpp_bin_float_100> f100;
+   f100.push_back(cpp_bin_float_100(1) / 3);
+   f100.push_back(ldexp(cpp_bin_float_100(1), 100000));
+   f100.push_back(ldexp(cpp_bin_float_100(-1), -100000));
+   data = write_all(f100);
+   std::vector<cpp_bin_float_50> f50 = read_all<cpp_bin_float_50>(data, 0);
+   BOOST_CHECK_EQUAL(f50.size(), 3u);
+   BOOST_CHECK_EQUAL(f50[0], cpp_bin_float_50(f100[0]));
+   BOOST_CHECK_EQUAL(f50[1], cpp_bin_float_50(f100[1]));
+   BOOST_CHECK_EQUAL(f50[2], cpp_bin_float_50(f100[2]));
+   std::vector<cpp_bin_float_single> fs = read_all<cpp_bin_float_single>(data, 0);
+   BOOST_CHECK_EQUAL(fs.size(), 3u);
+   BOOST_CHECK_EQUAL(fs[0], cpp_bin_float_single(f100[0]));
+   BOOST_CHECK((boost::math::isinf)(fs[1]));
+   BOOST_CHECK_EQUAL(fs[2], 0);
+   BOOST_CHECK((boost::math::signbit)(fs[2]));
+   //
+   // Variable precision values keep their own precisions, and may be read to and from fixed precision types:
+   //
+   typedef number<cpp_bin_float<0> > var_float;
+   std::vector<var_float> fv;
+   for(unsigned digits = 5; digits < 400; digits += 37)
+   {
+      var_float v;
+      v.precision(digits);
+      v = 1;
+      v /= 3;
+      fv.push_back(v);
+      var_float z;
+      z.precision(digits);
+      z = -z;
+      fv.push_back(z);
+   }
+   data = write_all(fv);
+   wire_reader<var_float> rf(data.data(), data.size());
+   BOOST_CHECK_EQUAL(rf.precision(), 0u);
+   std::vector<var_float> fv2 = read_all<var_float>(data, 3);
+   BOOST_CHECK_EQUAL(fv2.size(), fv.size());
+   for(unsigned i = 0; (i < fv.size()) && (i < fv2.size()); ++i)
+   {
+      BOOST_CHECK_EQUAL(fv2[i], fv[i]);
+      BOOST_CHECK_EQUAL(fv2[i].backend().precision_bits(), fv[i].backend().precision_bits());
+      BOOST_CHECK_EQUAL((boost::math::signbit)(fv2[i]), (boost::math::signbit)(fv[i]));
+   }
+   f50 = read_all<cpp_bin_float_50>(data, 0);
+   BOOST_CHECK_EQUAL(f50.size(), fv.size());
+   for(unsigned i = 0; (i < fv.size()) && (i < f50.size()); ++i)
+      BOOST_CHECK_EQUAL(f50[i], cpp_bin_float_50(fv[i]));
+   data = write_all(f100);
+   fv = read_all<var_float>(data, 0);
+   BOOST_CHECK_EQUAL(fv.size(), 3u);
+   BOOST_CHECK_EQUAL(fv[0], f100[0]);
+   BOOST_CHECK_EQUAL(fv[0].backend().precision_bits(), static_cast<unsigned>(std::numeric_limits<cpp_bin_float_100>::digits));
+   //
+   // Malformed data:
+   //
+   data = write_all(big);
+   BOOST_CHECK_THROW(wire_reader<cpp_int>(data.data(), 10), std::runtime_error);
+   BOOST_CHECK_THROW(wire_reader<cpp_bin_float_50>(data.data(), data.size()), std::runtime_error);
+   std::string bad(data);
+   bad[0] = 'X';
+   BOOST_CHECK_THROW(wire_reader<cpp_int>(bad.data(), bad.size()), std::runtime_error);
+   bad = data;
+   bad[4] = 2;
+   BOOST_CHECK_THROW(wire_reader<cpp_int>(bad.data(), bad.size()), std::runtime_error);
+   wire_reader<cpp_int> truncated(data.data(), data.size() - 8);
+   cpp_int val;
+   BOOST_CHECK(truncated.read(val));
+   BOOST_CHECK_THROW(truncated.read(val), std::runtime_error);
+   wire_reader<cpp_int> truncated2(data.data(), 20);
+   BOOST_CHECK_THROW(truncated2.read(val), std::runtime_error);
+   return boost::report_errors();
+}